@@ -451,7 +451,7 @@ end type
                     if len(arg_dec.arrayinfos['arraysizes']) > 1:
                         raise GeneratorException('Unhandled argument type', arg_dec)
                     if arg_dec.arrayinfos['arraysizes']:
-                        dim_name = fun_dec.arguments[arg_dec.arrayinfos['arraysizes']].name
+                        dim_name = fun_dec.arguments[arg_dec.arrayinfos['arraysizes'][0]].name
 
                 if arg_dec.is_outarg:
                     if arg_dec.arrayinfos['autoalloc']:
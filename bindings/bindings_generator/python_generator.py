@@ -266,7 +266,7 @@ class PythonGenerator(object):
             elif arg.arrayinfos['is_array'] and arg.npointer > 0 and arg.arrayinfos['autoalloc'] and arg.is_string:
                 tmp_str = '_c_%s = ctypes.POINTER(ctypes.c_char_p)()' \
                     % (arg.name)
-            elif arg.arrayinfos['is_array'] and arg.npointer > 0 and not arg.arrayinfos['autoalloc'] and not arg.is_string:
+            elif arg.arrayinfos['is_array'] and arg.npointer > 0 and not arg.arrayinfos['autoalloc']:
                 if(len(arg.arrayinfos['arraysizes']) > 0):
                     tmp_str = '%s_len = 1 ' % arg.name
                     for sizearg_index in arg.arrayinfos['arraysizes']:
@@ -274,13 +274,12 @@ class PythonGenerator(object):
                     tmp_str += '\n'
                 else:
                     tmp_str = ''
-                tmp_str += '_c_%s = (ctypes.c_%s * %s_len)()' \
-                    % (arg.name, arg.type, arg.name)
-
-                    
-            elif arg.arrayinfos['is_array'] and arg.npointer > 0 and not arg.arrayinfos['autoalloc'] and arg.is_string:
-                tmp_str = '_c_%s = (ctypes.c_char_p * %s_len)()' \
-                    % (arg.name, arg.name)
+                if not arg.is_string:
+                    tmp_str += '_c_%s = (ctypes.c_%s * %s_len)()' \
+                        % (arg.name, arg.type, arg.name)
+                else:
+                    tmp_str += '_c_%s = (ctypes.c_char_p * %s_len)()' \
+                        % (arg.name, arg.name)
             elif arg.is_string and not arg.arrayinfos['is_array']:
                 tmp_str = '_c_%s = ctypes.c_char_p()' % (arg.name)
             elif not arg.arrayinfos['is_array'] and arg.npointer == 1:
@@ -93,7 +93,7 @@ end subroutine
 !end function
 '''
 
-blacklist = ['tixiGetPrintMsgFunc','tixiSetPrintMsgFunc','tixiGetVersion','tixiGetArrayElementNames']
+blacklist = ['tixiGetPrintMsgFunc','tixiSetPrintMsgFunc','tixiGetVersion','tixiGetArrayElementNames', 'tixiGetTextElementInto', 'tixiGetTextAttributeInto', 'tixiXPathExpressionGetTextByIndexInto', 'tixiGetFloatVectorInto']
 
 if __name__ == '__main__':
     # parse the file  
@@ -15,7 +15,7 @@ import bindings_generator.matlab_generator as MG
 import bindings_generator.cheader_parser   as CP
 
 
-blacklist = ['tixiGetRawInterface', 'tixiAddDoubleListWithAttributes', 'tixiSetPrintMsgFunc']
+blacklist = ['tixiGetRawInterface', 'tixiAddDoubleListWithAttributes', 'tixiUIDGetXPaths', 'tixiSetPrintMsgFunc', 'tixiGetTextElementInto', 'tixiGetTextAttributeInto', 'tixiXPathExpressionGetTextByIndexInto', 'tixiGetFloatVectorInto']
 
 if __name__ == '__main__':
     # parse the file
@@ -107,7 +107,7 @@ postconstr = '''
 self.version = self.getVersion()
 '''
 
-blacklist = ['tixiCheckElement', 'tixiUIDCheckExists', 'tixiCheckAttribute', 'tixiCloseDocument', 'tixiGetRawInterface', 'tixiSetPrintMsgFunc']
+blacklist = ['tixiCheckElement', 'tixiUIDCheckExists', 'tixiCheckAttribute', 'tixiCloseDocument', 'tixiGetRawInterface', 'tixiSetPrintMsgFunc', 'tixiGetTextElementInto', 'tixiGetTextAttributeInto', 'tixiXPathExpressionGetTextByIndexInto', 'tixiGetFloatVectorInto']
 
 if __name__ == '__main__':
     # parse the file
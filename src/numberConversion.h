@@ -0,0 +1,121 @@
+/*
+* Copyright (C) 2026 German Aerospace Center (DLR/SC)
+*
+* Created: 2026-10-16
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*   http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+#ifndef NUMBER_CONVERSION_H
+#define NUMBER_CONVERSION_H
+
+#include <stddef.h>
+
+#ifndef TIXI_INTERNAL_EXPORT
+#if defined(WIN32)
+#if defined (tixi3_EXPORTS)
+#define TIXI_INTERNAL_EXPORT __declspec (dllexport)
+#else
+#define TIXI_INTERNAL_EXPORT
+#endif
+#else
+#define TIXI_INTERNAL_EXPORT
+#endif
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @file   numberConversion.h
+ * @brief  Fast conversions between floating point numbers and their text representation.
+ */
+
+/**
+  @brief Parses a floating point number at the beginning of text.
+
+  Accepts the same input as strtod in the C locale and returns the same, correctly rounded value.
+  The decimal point is always '.', independent of LC_NUMERIC. Decimal numbers with up to
+  19 significant digits are converted without strtod. All other input (hexadecimal numbers,
+  inf, nan, long mantissas) is passed on to strtod_l with the C locale.
+
+  @param text (in) Text to parse, leading whitespace is skipped
+  @param value (out) The parsed number
+  @return Pointer to the first character behind the number, or text if no number was found.
+ */
+TIXI_INTERNAL_EXPORT const char* parseDouble(const char* text, double* value);
+
+/** Size of the buffers passed to the format functions */
+#define NUMBER_BUFFER_SIZE 32
+
+/**
+  @brief Writes a number with the fewest significant digits, that parse back to the identical double.
+
+  Numbers are written in fixed notation, if their decimal exponent is in the range of
+  printf("%.17g"), in scientific notation otherwise. The output does not depend on the locale.
+
+  @param value (in) The number to write
+  @param buffer (out) Buffer of at least NUMBER_BUFFER_SIZE characters
+  @return The length of the written text
+ */
+TIXI_INTERNAL_EXPORT int formatDoubleShortest(double value, char* buffer);
+
+/**
+  @brief Writes a number like printf("%g").
+
+  Numbers with up to 6 significant digits are written without printf.
+
+  @param value (in) The number to write
+  @param buffer (out) Buffer of at least NUMBER_BUFFER_SIZE characters
+  @return The length of the written text
+ */
+TIXI_INTERNAL_EXPORT int formatDoubleGeneral(double value, char* buffer);
+
+/** Length of the base64 text of n doubles, without the terminating zero */
+#define BASE64_DOUBLES_LENGTH(n) (((size_t) (n) * 8 + 2) / 3 * 4)
+
+/**
+  @brief Writes doubles as base64 encoded IEEE 754 binary64 numbers in little endian byte order.
+
+  @param values (in) The numbers to write
+  @param nValues (in) Number of values
+  @param buffer (out) Buffer of at least BASE64_DOUBLES_LENGTH(nValues) + 1 characters
+  @return The length of the written text
+ */
+TIXI_INTERNAL_EXPORT size_t encodeDoublesBase64(const double* values, int nValues, char* buffer);
+
+/**
+  @brief Returns the number of doubles encoded in a base64 text, whitespace is ignored.
+
+  @return The number of doubles, or -1 if the text is no valid base64 or
+          does not encode a whole number of doubles.
+ */
+TIXI_INTERNAL_EXPORT int base64DoubleCount(const char* text);
+
+/**
+  @brief Decodes the first nValues doubles of a base64 text written by encodeDoublesBase64.
+
+  The text has to be checked with base64DoubleCount before.
+
+  @param text (in) The base64 text
+  @param values (out) Array of at least nValues doubles
+  @param nValues (in) Number of values to decode
+ */
+TIXI_INTERNAL_EXPORT void decodeDoublesBase64(const char* text, double* values, int nValues);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NUMBER_CONVERSION_H */
@@ -224,7 +224,7 @@ extern "C" {
  @section ImplementationIssuues Implementation issues
 
   - Memory allocated by TIXI and associated with a document is released
-   when closing the document.
+   when closing the document or by tixiReleaseReturnedMemory.
 
   - TixiDocumentHandle is an integer used as index to access an TIXI
    internal data structure.
@@ -316,7 +316,7 @@ enum ReturnCode
   NO_ATTRIBUTE_NAME,          /*!< 25: No attribute name specified               */
 
   STRING_TRUNCATED,           /*!< 26: String variable supplied is to small to
-                                   hold the result, Fortran only             */
+                                   hold the result                           */
 
   NON_MATCHING_NAME,          /*!< 27: Row or column name specified do not
                                    match the names used in the document      */
@@ -716,6 +716,66 @@ DLL_EXPORT ReturnCode tixiCloseDocument (TixiDocumentHandle handle);
  */
 DLL_EXPORT ReturnCode tixiCloseAllDocuments ();
 
+/**
+  @brief Releases the memory of all results returned for a document.
+
+  Strings and arrays returned by functions like tixiGetTextElement, tixiGetFloatVector
+  or tixiUIDGetXPath are owned by the document and are normally released when the
+  document is closed. This function releases them earlier, such that long living
+  documents do not accumulate memory. All pointers returned for the document before
+  this call become invalid.
+
+  @param[in] handle handle as returned by ::tixiCreateDocument, ::tixiOpenDocumentRecursive or ::tixiOpenDocument
+
+  @return
+    - SUCCESS if the memory has been released
+    - INVALID_HANDLE if the handle is not valid
+ */
+DLL_EXPORT ReturnCode tixiReleaseReturnedMemory (TixiDocumentHandle handle);
+
+/**
+  @brief Opens a memory scope for the results returned for a document.
+
+  All strings and arrays returned after this call are released by the matching
+  call of ::tixiPopMemoryScope. Scopes may be nested. This allows to keep the memory
+  of a long running loop constant without closing the document, e.g.
+
+  @code{.c}
+  for (iteration = 0; iteration < nIterations; ++iteration) {
+    tixiPushMemoryScope(handle);
+    tixiGetTextElement(handle, "/plane/name", &name);
+    ...
+    tixiPopMemoryScope(handle);
+  }
+  @endcode
+
+  Memory scopes belong to the document and not to a thread. ::tixiReleaseReturnedMemory
+  discards all open scopes.
+
+  @param[in] handle handle as returned by ::tixiCreateDocument, ::tixiOpenDocumentRecursive or ::tixiOpenDocument
+
+  @return
+    - SUCCESS if the scope has been opened
+    - INVALID_HANDLE if the handle is not valid
+    - FAILED if the scope could not be allocated
+ */
+DLL_EXPORT ReturnCode tixiPushMemoryScope (TixiDocumentHandle handle);
+
+/**
+  @brief Closes the memory scope opened by the last call of ::tixiPushMemoryScope.
+
+  All strings and arrays returned for the document since the matching push are
+  released and must not be used anymore. Results returned before stay valid.
+
+  @param[in] handle handle as returned by ::tixiCreateDocument, ::tixiOpenDocumentRecursive or ::tixiOpenDocument
+
+  @return
+    - SUCCESS if the scope has been closed
+    - INVALID_HANDLE if the handle is not valid
+    - FAILED if there is no open scope
+ */
+DLL_EXPORT ReturnCode tixiPopMemoryScope (TixiDocumentHandle handle);
+
 /**
   @brief Closes the xml2 library and frees its allocated variables
  */
@@ -931,6 +991,37 @@ DLL_EXPORT ReturnCode tixiDTDValidate (const TixiDocumentHandle handle, const ch
 DLL_EXPORT ReturnCode tixiGetTextElement (const TixiDocumentHandle handle,
                                           const char *elementPath, char **text);
 
+/**
+  @brief Retrieve text content of an element into a buffer provided by the user.
+
+  Works like ::tixiGetTextElement, but copies the text into buffer instead
+  of allocating memory for it. If the buffer is too small, the text is
+  truncated and neededSize tells the required size. Reading text elements
+  into a reused buffer does not allocate any memory in most cases.
+
+  @param[in]  handle handle as returned by ::tixiOpenDocument, ::tixiOpenDocumentRecursive or ::tixiOpenDocumentFromHTTP
+
+  @param[in]  elementPath an XPath compliant path to an element in the document
+                    specified by handle (see section \ref XPathExamples above).
+
+  @param[out] buffer buffer provided by the user, that receives the null terminated text. May be NULL, if bufferSize is 0.
+
+  @param[in]  bufferSize size of buffer in bytes
+
+  @param[out] neededSize size in bytes required for the complete text including the terminating null character. May be NULL.
+
+  @return
+    - SUCCESS if successfully retrieve the text content of a single element
+    - STRING_TRUNCATED if the buffer is too small to hold the text
+    - INVALID_HANDLE if the handle is not valid, i.e.  does not or no longer exist
+    - INVALID_XPATH if elementPath is not a well-formed XPath-expression
+    - ELEMENT_NOT_FOUND if elementPath does not point to a node in the XML-document
+    - ELEMENT_PATH_NOT_UNIQUE if elementPath resolves not to a single element but to a list of elements
+    - FAILED if buffer is NULL, although bufferSize is not 0
+ */
+DLL_EXPORT ReturnCode tixiGetTextElementInto (const TixiDocumentHandle handle, const char *elementPath,
+                                              char *buffer, int bufferSize, int *neededSize);
+
 
 /**
   @brief Retrieve integer content of an element.
@@ -1585,6 +1676,11 @@ DLL_EXPORT ReturnCode tixiAddIntegerElementNS (const TixiDocumentHandle handle,
   @param[in]  format format string used to convert number into a string.
                      The format string usage is identical to format strings in printf.
                      If format is NULL "%g" will be used to format the string.
+                     If format is "exact", each number is written with the fewest digits,
+                     that read back to the identical value.
+                     If format is "base64-f64le", the numbers are stored as base64 encoded
+                     little endian doubles and the element gets the attribute encoding="base64-f64le".
+                     This is lossless and much more compact for large vectors.
 
   @return
     - SUCCESS if successfully added the text element
@@ -1623,7 +1719,13 @@ DLL_EXPORT ReturnCode tixiAddFloatVector (const TixiDocumentHandle handle, const
 
   @param[in]  format format string used to convert number into a string.
                      The format string usage is identical to format strings in printf.
-                     If format is NULL "%g" will be used to format the string.
+                     If format is NULL "%g" will be used to format the string, unless the
+                     vector is base64 encoded already. Then, it stays encoded.
+                     If format is "exact", each number is written with the fewest digits,
+                     that read back to the identical value.
+                     If format is "base64-f64le", the numbers are stored as base64 encoded
+                     little endian doubles (see ::tixiAddFloatVector). Other formats remove
+                     an encoding="base64-f64le" attribute.
 
   @return
     - SUCCESS if successfully added the text element
@@ -2020,6 +2122,7 @@ DLL_EXPORT ReturnCode tixiExportElementAsString (const TixiDocumentHandle handle
     - ELEMENT_PATH_NOT_UNIQUE if parentPath resolves not to a single element but to a list of elements
     - ELEMENT_NOT_FOUND if parentPath points to a non-existing element
     - ALREADY_SAVED if element should be added to an already saved document
+    - UID_NOT_UNIQUE if the element contains a uID, that is already used, while unique uIDs are enforced by ::tixiUIDSetEnforceUnique
  */
 DLL_EXPORT ReturnCode tixiImportElementFromString (const TixiDocumentHandle handle, const char *parentPath, const char *xmlImportString);
 
@@ -2054,6 +2157,7 @@ DLL_EXPORT ReturnCode tixiImportElementFromString (const TixiDocumentHandle hand
     - ELEMENT_PATH_NOT_UNIQUE if parentPath resolves not to a single element but to a list of elements
     - ELEMENT_NOT_FOUND if parentPath points to a non-existing element
     - ALREADY_SAVED if element should be added to an already saved document
+    - UID_NOT_UNIQUE if the element contains a uID, that is already used, while unique uIDs are enforced by ::tixiUIDSetEnforceUnique
  */
 DLL_EXPORT ReturnCode tixiImportElementFromStringAtIndex (const TixiDocumentHandle handle, const char *parentPath, int index, const char *xmlImportString);
 
@@ -2106,6 +2210,42 @@ DLL_EXPORT ReturnCode tixiGetTextAttribute (const TixiDocumentHandle handle,
                                             const char *elementPath, const char *attributeName,
                                             char **text);
 
+/**
+  @brief Retrieves value of an element's attribute into a buffer provided by the user.
+
+  Works like ::tixiGetTextAttribute, but copies the value into buffer instead
+  of allocating memory for it. If the buffer is too small, the value is
+  truncated and neededSize tells the required size.
+
+  @param[in]  handle handle as returned by ::tixiOpenDocument or ::tixiCreateDocument
+
+  @param[in]  elementPath an XPath compliant path to an element in the document
+                          specified by handle (see section \ref XPathExamples above).
+
+  @param[in]  attributeName name of the attribute. The name can also consist of
+                            a namespace prefix + ":" + the attribute name.
+
+  @param[out] buffer buffer provided by the user, that receives the null terminated text. May be NULL, if bufferSize is 0.
+
+  @param[in]  bufferSize size of buffer in bytes
+
+  @param[out] neededSize size in bytes required for the complete text including the terminating null character. May be NULL.
+
+  @return
+    - SUCCESS if successfully retrieve the value of the attribute
+    - STRING_TRUNCATED if the buffer is too small to hold the value
+    - INVALID_HANDLE if the handle is not valid, i.e.  does not or no longer exist
+    - INVALID_XPATH if elementPath is not a well-formed XPath-expression
+    - ATTRIBUTE_NOT_FOUND if the element has no attribute attributeName
+    - ELEMENT_NOT_FOUND if elementPath does not point to a node in the XML-document
+    - ELEMENT_PATH_NOT_UNIQUE if elementPath resolves not to a single element but to a list of elements
+    - INVALID_NAMESPACE_PREFIX if the prefix in attributeName does not match to a namespace
+    - FAILED if buffer is NULL, although bufferSize is not 0
+ */
+DLL_EXPORT ReturnCode tixiGetTextAttributeInto (const TixiDocumentHandle handle, const char *elementPath,
+                                                const char *attributeName, char *buffer, int bufferSize,
+                                                int *neededSize);
+
 /**
   @brief Retrieves value of an element's attribute as an integer.
 
@@ -2254,6 +2394,7 @@ DLL_EXPORT ReturnCode tixiGetDoubleAttribute (const TixiDocumentHandle handle,
     - ALREADY_SAVED if element should be added to an already saved document
     - INVALID_XML_NAME if attributeName is not a valid XML-element name
     - INVALID_NAMESPACE_PREFIX if the prefix in attributeName does not match to a namespace
+    - UID_NOT_UNIQUE if a uID is set, that is already used, while unique uIDs are enforced by ::tixiUIDSetEnforceUnique
  */
 DLL_EXPORT ReturnCode tixiAddTextAttribute (const TixiDocumentHandle handle,
                                             const char *elementPath, const char *attributeName,
@@ -2630,6 +2771,8 @@ DLL_EXPORT ReturnCode tixiDeclareNamespace(const TixiDocumentHandle handle, cons
     - FAILED if an internal error occured
     - INVALID_HANDLE if the handle is not valid
     - ALREADY_SAVED if the header should be added to an already saved document
+    - UID_NOT_UNIQUE if the loaded files contain uIDs, that are already used, while unique uIDs
+      are enforced by ::tixiUIDSetEnforceUnique. The document is left unchanged in this case.
  */
 DLL_EXPORT ReturnCode tixiAddExternalLink (const TixiDocumentHandle handle, const char *parentPath,
                                            const char *pathOrUrl, const char *filename, AddLinkMode mode);
@@ -2877,9 +3020,11 @@ DLL_EXPORT TixiPrintMsgFnc tixiGetPrintMsgFunc();
 
 
 /**
-  @brief Enables the internal xPath cache
+  @brief Enables or disables the internal xPath cache
  
-  This speeds up xpath queries with repeating same xpathes.
+  This speeds up xpath queries with repeating same xpathes. The cache keeps the
+  results of the most recently evaluated xpathes and is enabled by default.
+  Modifying the document invalidates all cached results.
   
   @param[in] handle The document handle of a tixi document.
   @param[in] enabled Boolean, whether to enable the cache or not.
@@ -2891,6 +3036,29 @@ DLL_EXPORT TixiPrintMsgFnc tixiGetPrintMsgFunc();
  */
 DLL_EXPORT ReturnCode tixiSetCacheEnabled(TixiDocumentHandle handle, int enabled);
 
+/**
+  @brief Enables concurrent access to a document from several threads.
+
+  In thread safe mode, each document is guarded by a reader/writer lock.
+  Functions that only read the document (e.g. tixiGetTextElement, tixiCheckElement
+  or tixiXPathEvaluateNodeNumber) may run in parallel, while functions modifying
+  the document are executed exclusively. Each thread uses its own xpath context
+  and cache, so that parallel queries do not interfere.
+
+  The mode is disabled by default, as the locking slightly slows down single threaded
+  applications. It must only be switched, while no other thread uses the document.
+  Closing a document must not happen concurrently to other calls with the same handle.
+
+  @param[in] handle The document handle of a tixi document.
+  @param[in] enabled Boolean, whether to enable the thread safe mode or not.
+
+  @return
+    - SUCCESS if the thread safe mode could be enabled/disabled
+    - INVALID_HANDLE if the handle is not valid, i.e.  does not or no longer exist
+    - FAILED  otherwise
+ */
+DLL_EXPORT ReturnCode tixiSetThreadSafe(TixiDocumentHandle handle, int enabled);
+
 /*@}*/
 
 /**
@@ -2938,6 +3106,7 @@ DLL_EXPORT ReturnCode tixiSetCacheEnabled(TixiDocumentHandle handle, int enabled
     - INVALID_XPATH if parentPath is not a well-formed XPath-expression
     - ELEMENT_NOT_FOUND if parentPath does not point to a node in the XML-document
     - ELEMENT_PATH_NOT_UNIQUE if parentPath resolves not to a single element
+    - UID_NOT_UNIQUE if attributeName is uID and a value is already used, while unique uIDs are enforced by ::tixiUIDSetEnforceUnique
  */
 DLL_EXPORT ReturnCode tixiAddDoubleListWithAttributes (const TixiDocumentHandle handle,
                                                        const char *parentPath,
@@ -2951,6 +3120,9 @@ DLL_EXPORT ReturnCode tixiAddDoubleListWithAttributes (const TixiDocumentHandle
 
   Returns the size of semicolon separated elementf in an vector. The node containung
   the vector has to be tagged via the xml attribute <<mapType="vector">>.
+  Vectors with the attribute encoding="base64-f64le" hold base64 encoded doubles
+  (see ::tixiAddFloatVector), all vector functions read them transparently.
+  Other values of the encoding attribute are ignored and the vector is read as text.
 
   tixi_get_vector_size( integer  handle,  character*n vectorPath, integer nElements, integer error)
 
@@ -3002,6 +3174,68 @@ DLL_EXPORT ReturnCode tixiGetFloatVector (const TixiDocumentHandle handle, const
                                           double **vectorArray, const int eNumber);
 
 
+/**
+  @brief Retrieves a vector together with its size.
+
+  Combines ::tixiGetVectorSize and ::tixiGetFloatVector. The element is looked up once
+  and its text is read in place, without copying it. The memory necessary for the array
+  is automatically allocated.
+
+  tixi_get_float_vector_alloc( integer handle, character*n vectorPath, integer nElements, real array, integer error)
+
+  @param[in]  handle file handle as returned by ::tixiOpenDocument, ::tixiOpenDocumentRecursive, ::tixiOpenDocumentFromHTTP, ::tixiCreateDocument or ::tixiImportFromString
+  @param[in]  vectorPath an XPath compliant path to an element holding the vector in
+                         the document specified by handle (see section \ref XPathExamples).
+  @param[out] nElements  number of vector elements
+  @param[out] vectorArray a pointer address for an array that holds the vector elements
+
+  @return
+    - SUCCESS if successfully read the vector
+    - FAILED internal error
+    - INVALID_HANDLE if the handle is not valid
+    - INVALID_XPATH if vectorPath is not a well-formed XPath-expression
+    - ELEMENT_PATH_NOT_UNIQUE if vectorPath resolves not to a single element but to a list of elements
+    - ELEMENT_NOT_FOUND if vectorPath points to a non-existing element
+    - NO_NUMBER if an element of the vector is not a number
+
+  @cond
+  #annotate out: 2, 3A(2)#
+  @endcond
+    */
+DLL_EXPORT ReturnCode tixiGetFloatVectorAlloc (const TixiDocumentHandle handle, const char *vectorPath,
+                                               int *nElements, double **vectorArray);
+
+
+/**
+  @brief Retrieves a vector into an array provided by the user.
+
+  Works like ::tixiGetFloatVector, but writes the vector elements into vectorArray
+  instead of allocating memory for them. Reading vectors repeatedly into the same
+  array does not allocate any memory.
+  If the array is too small, it is filled with the first capacity elements and
+  nElements tells the size of the vector.
+
+  @param[in]  handle file handle as returned by ::tixiOpenDocument, ::tixiOpenDocumentRecursive, ::tixiOpenDocumentFromHTTP, ::tixiCreateDocument or ::tixiImportFromString
+  @param[in]  vectorPath an XPath compliant path to an element holding the vector in
+                         the document specified by handle (see section \ref XPathExamples).
+  @param[out] vectorArray array provided by the user, that receives the vector elements. May be NULL, if capacity is 0.
+  @param[in]  capacity number of elements vectorArray can hold
+  @param[out] nElements number of vector elements. May be NULL.
+
+  @return
+    - SUCCESS if successfully read the vector
+    - INDEX_OUT_OF_RANGE if the vector has more than capacity elements
+    - FAILED if vectorArray is NULL, although capacity is not 0
+    - INVALID_HANDLE if the handle is not valid
+    - INVALID_XPATH if vectorPath is not a well-formed XPath-expression
+    - ELEMENT_PATH_NOT_UNIQUE if vectorPath resolves not to a single element but to a list of elements
+    - ELEMENT_NOT_FOUND if vectorPath points to a non-existing element
+    - NO_NUMBER if an element of the vector is not a number
+ */
+DLL_EXPORT ReturnCode tixiGetFloatVectorInto (const TixiDocumentHandle handle, const char *vectorPath,
+                                              double *vectorArray, int capacity, int *nElements);
+
+
 /**
   @brief Retrieves the number of dimensions of an Array.
 
@@ -3554,6 +3788,29 @@ DLL_EXPORT ReturnCode tixiXPathExpressionGetXPath(TixiDocumentHandle handle, con
  */
 DLL_EXPORT ReturnCode tixiXPathExpressionGetTextByIndex(TixiDocumentHandle handle, const char *xPathExpression, int elementNumber, char **text);
 
+/**
+  @brief Evaluates a XPath expression and copies the text content of the resultnode into a buffer provided by the user.
+
+  Works like ::tixiXPathExpressionGetTextByIndex, but copies the text into buffer instead
+  of allocating memory for it. If the buffer is too small, the text is truncated and
+  neededSize tells the required size.
+
+  @param[in]  handle handle as returned by ::tixiOpenDocument, ::tixiOpenDocumentRecursive, ::tixiOpenDocumentFromHTTP, ::tixiCreateDocument or ::tixiImportFromString
+  @param[in]  xPathExpression The XPath Expression to evaluate.
+  @param[in]  elementNumber The (index)-number to get. Index must be between 1 and 'tixiXPathEvaluateNodeNumber()', inclusively.
+  @param[out] buffer buffer provided by the user, that receives the null terminated text. May be NULL, if bufferSize is 0.
+  @param[in]  bufferSize size of buffer in bytes
+  @param[out] neededSize size in bytes required for the complete text including the terminating null character. May be NULL.
+
+  @return
+    - SUCCESS if successfully retrieve the text content of a single element.
+    - STRING_TRUNCATED if the buffer is too small to hold the text
+    - INVALID_HANDLE if the handle is not valid, i.e.  does not or no longer exist.
+    - FAILED  is an internal error occured or the node does not exist.
+ */
+DLL_EXPORT ReturnCode tixiXPathExpressionGetTextByIndexInto(TixiDocumentHandle handle, const char *xPathExpression, int elementNumber,
+                                                            char *buffer, int bufferSize, int *neededSize);
+
 
 /*@}*/
 /**
@@ -3566,6 +3823,8 @@ DLL_EXPORT ReturnCode tixiXPathExpressionGetTextByIndex(TixiDocumentHandle handl
 /**
   @brief Performs a check over all UIDs and checks for duplicates.
 
+  Each duplicated UID is reported as an error message, listing the paths of all elements using it.
+
   <b>Fortran syntax:</b>
 
   tixi_uid_check_duplicates( integer  handle, integer error )
@@ -3583,6 +3842,8 @@ DLL_EXPORT ReturnCode tixiUIDCheckDuplicates(TixiDocumentHandle handle);
 /**
   @brief Performs a check over all nodes with the uID "isLink" and check if the corresponding uid exists in that data set.
 
+  Each broken link is reported as an error message. Use ::tixiUIDGetBrokenLinks to retrieve them.
+
   <b>Fortran syntax:</b>
 
   tixi_uid_check_links( integer  handle, integer error )
@@ -3597,6 +3858,102 @@ DLL_EXPORT ReturnCode tixiUIDCheckDuplicates(TixiDocumentHandle handle);
  */
 DLL_EXPORT ReturnCode tixiUIDCheckLinks(TixiDocumentHandle handle);
 
+/**
+  @brief Returns the number of nodes with an "isLink" attribute, whose uid does not exist in the data set.
+
+  Use this function to allocate the array passed to ::tixiUIDGetBrokenLinks.
+
+  <b>Fortran syntax:</b>
+
+  tixi_uid_get_broken_links_count( integer  handle, integer nBrokenLinks, integer error )
+
+  @param[in]  handle handle as returned by ::tixiOpenDocument, ::tixiOpenDocumentRecursive, ::tixiOpenDocumentFromHTTP, ::tixiCreateDocument or ::tixiImportFromString
+  @param[out] nBrokenLinks number of broken links
+
+  @return
+    - SUCCESS if the links could be checked, even if some are broken
+    - INVALID_HANDLE if the handle is not valid
+    - FAILED if reading of links or uids does not work
+ */
+DLL_EXPORT ReturnCode tixiUIDGetBrokenLinksCount(TixiDocumentHandle handle, int* nBrokenLinks);
+
+/**
+  @brief Returns the paths of all nodes with an "isLink" attribute, whose uid does not exist in the data set.
+
+  The paths are returned in document order. The strings are allocated internally
+  and must not be released by the user. The deallocation is done when the document
+  referred to by handle is closed.
+
+  <b>Fortran syntax:</b>
+
+  tixi_uid_get_broken_links( integer  handle, character*n*m linkPaths, integer error )
+
+  @param[in]  handle handle as returned by ::tixiOpenDocument, ::tixiOpenDocumentRecursive, ::tixiOpenDocumentFromHTTP, ::tixiCreateDocument or ::tixiImportFromString
+  @param[out] linkPaths array of strings, that has to hold at least as many strings
+                        as returned by ::tixiUIDGetBrokenLinksCount
+
+  @return
+    - SUCCESS if the links could be checked, even if some are broken
+    - INVALID_HANDLE if the handle is not valid
+    - FAILED if reading of links or uids does not work
+
+  @cond
+  #annotate out: 1AM# one user specified return array (of strings)
+  @endcond
+ */
+DLL_EXPORT ReturnCode tixiUIDGetBrokenLinks(TixiDocumentHandle handle, char** linkPaths);
+
+/**
+  @brief Returns the number of nodes with an "isLink" attribute referencing the given uID.
+
+  Use this function to allocate the array passed to ::tixiUIDGetReferencingXPaths.
+  The uID itself does not need to exist in the data set.
+
+  <b>Fortran syntax:</b>
+
+  tixi_uid_get_referencing_xpaths_count( integer  handle, character*n uID, integer count, integer error )
+
+  @param[in]  handle handle as returned by ::tixiOpenDocument, ::tixiOpenDocumentRecursive, ::tixiOpenDocumentFromHTTP, ::tixiCreateDocument or ::tixiImportFromString
+  @param[in]  uID uID, whose references are counted
+  @param[out] count number of nodes referencing the uID
+
+  @return
+    - SUCCESS if the references could be counted
+    - INVALID_HANDLE if the handle is not valid
+    - FAILED if no uID is given or reading of links or uids does not work
+ */
+DLL_EXPORT ReturnCode tixiUIDGetReferencingXPathsCount(TixiDocumentHandle handle, const char* uID, int* count);
+
+/**
+  @brief Returns the paths of all nodes with an "isLink" attribute referencing the given uID.
+
+  The paths are returned in document order. The strings are allocated internally
+  and must not be released by the user. The deallocation is done when the document
+  referred to by handle is closed.
+
+  The references are kept in an index, that is updated when the document is modified.
+  Hence, repeated queries don't search the whole document.
+
+  <b>Fortran syntax:</b>
+
+  tixi_uid_get_referencing_xpaths( integer  handle, character*n uID, character*n*m xPaths, integer error )
+
+  @param[in]  handle handle as returned by ::tixiOpenDocument, ::tixiOpenDocumentRecursive, ::tixiOpenDocumentFromHTTP, ::tixiCreateDocument or ::tixiImportFromString
+  @param[in]  uID uID, whose references are returned
+  @param[out] xPaths array of strings, that has to hold at least as many strings
+                     as returned by ::tixiUIDGetReferencingXPathsCount
+
+  @return
+    - SUCCESS if the references could be retrieved
+    - INVALID_HANDLE if the handle is not valid
+    - FAILED if no uID is given or reading of links or uids does not work
+
+  @cond
+  #annotate out: 2AM# one user specified return array (of strings)
+  @endcond
+ */
+DLL_EXPORT ReturnCode tixiUIDGetReferencingXPaths(TixiDocumentHandle handle, const char* uID, char** xPaths);
+
 /**
   @brief Returns the XPath to given uID.
 
@@ -3619,6 +3976,109 @@ DLL_EXPORT ReturnCode tixiUIDCheckLinks(TixiDocumentHandle handle);
  */
 DLL_EXPORT ReturnCode tixiUIDGetXPath(TixiDocumentHandle handle, const char *uID, char **xPath);
 
+/**
+  @brief Returns the XPaths to several uIDs at once.
+
+  This is equivalent to calling ::tixiUIDGetXPath for each uID, but the uIDs of
+  the document are read and checked for duplicates only once.
+
+  On successful return the memory used for the XPaths is allocated
+  internally and must not be released by the user. The deallocation
+  is handle when the document referred to by handle is closed.
+
+  @param[in]  handle    handle as returned by ::tixiOpenDocument, ::tixiOpenDocumentRecursive, ::tixiOpenDocumentFromHTTP, ::tixiCreateDocument or ::tixiImportFromString
+  @param[in]  uIDs      The uids of which the xpaths should be returned
+  @param[in]  nUIDs     Number of uids
+  @param[out] xPaths    Array of nUIDs strings, receiving the XPath of the element with the
+                        corresponding uid. Empty string if the uid does not exist.
+
+  @return
+    - SUCCESS if the XPaths were retrieved, even if there are duplicated uids
+    - INVALID_HANDLE if the handle is not valid
+    - FAILED  for internal error
+
+  @cond
+  #annotate in: 1A(2) out: 3AM(2)#
+  @endcond
+ */
+DLL_EXPORT ReturnCode tixiUIDGetXPaths(TixiDocumentHandle handle, const char **uIDs, int nUIDs, char **xPaths);
+
+/**
+  @brief Retrieves the text content of an element relative to the element with the given uID.
+
+  The element with the uID is looked up directly, only the relative path is resolved.
+  This avoids building the XPath of the element by ::tixiUIDGetXPath and evaluating it again.
+
+  On successful return the memory used for text is allocated
+  internally and must not be released by the user. The deallocation
+  is handle when the document referred to by handle is closed.
+
+  <b>Fortran syntax:</b>
+
+  tixi_get_text_element_by_uid( integer  handle, character*n uid, character*n element_path, character*n text, integer error )
+
+  @param[in]  handle      handle as returned by ::tixiOpenDocument, ::tixiOpenDocumentRecursive, ::tixiOpenDocumentFromHTTP, ::tixiCreateDocument or ::tixiImportFromString
+  @param[in]  uID         uid of the element, the path is relative to
+  @param[in]  elementPath an XPath compliant path relative to the element with the uid, e.g. "wings/wing[2]".
+                          If elementPath is empty or NULL, the element with the uid itself is used.
+  @param[out] text        text content of the element
+
+  @return
+    - SUCCESS if successfully retrieve the text content of a single element
+    - INVALID_HANDLE if the handle is not valid
+    - UID_DONT_EXISTS if there is no element with the uid
+    - UID_NOT_UNIQUE if there are several elements with the uid
+    - INVALID_XPATH if elementPath is not a well-formed XPath-expression
+    - ELEMENT_NOT_FOUND if elementPath does not point to a node in the XML-document
+    - ELEMENT_PATH_NOT_UNIQUE if elementPath resolves not to a single element but to a list of elements
+ */
+DLL_EXPORT ReturnCode tixiGetTextElementByUID(const TixiDocumentHandle handle, const char *uID,
+                                              const char *elementPath, char **text);
+
+/**
+  @brief Retrieves the integer content of an element relative to the element with the given uID.
+
+  See ::tixiGetTextElementByUID for the lookup of the element.
+
+  <b>Fortran syntax:</b>
+
+  tixi_get_integer_element_by_uid( integer  handle, character*n uid, character*n element_path, integer number, integer error )
+
+  @param[in]  handle      handle as returned by ::tixiOpenDocument, ::tixiOpenDocumentRecursive, ::tixiOpenDocumentFromHTTP, ::tixiCreateDocument or ::tixiImportFromString
+  @param[in]  uID         uid of the element, the path is relative to
+  @param[in]  elementPath an XPath compliant path relative to the element with the uid
+  @param[out] number      content of the element interpreted as an integer number
+
+  @return
+    - SUCCESS if successfully retrieve the content of a single element
+    - the errors of ::tixiGetTextElementByUID
+    - NO_NUMBER if the content of the element cannot be interpreted as a numeric value
+ */
+DLL_EXPORT ReturnCode tixiGetIntegerElementByUID(const TixiDocumentHandle handle, const char *uID,
+                                                 const char *elementPath, int *number);
+
+/**
+  @brief Retrieves the floating point content of an element relative to the element with the given uID.
+
+  See ::tixiGetTextElementByUID for the lookup of the element.
+
+  <b>Fortran syntax:</b>
+
+  tixi_get_double_element_by_uid( integer  handle, character*n uid, character*n element_path, real number, integer error )
+
+  @param[in]  handle      handle as returned by ::tixiOpenDocument, ::tixiOpenDocumentRecursive, ::tixiOpenDocumentFromHTTP, ::tixiCreateDocument or ::tixiImportFromString
+  @param[in]  uID         uid of the element, the path is relative to
+  @param[in]  elementPath an XPath compliant path relative to the element with the uid
+  @param[out] number      content of the element interpreted as a floating point number
+
+  @return
+    - SUCCESS if successfully retrieve the content of a single element
+    - the errors of ::tixiGetTextElementByUID
+    - NO_NUMBER if the content of the element cannot be interpreted as a numeric value
+ */
+DLL_EXPORT ReturnCode tixiGetDoubleElementByUID(const TixiDocumentHandle handle, const char *uID,
+                                                const char *elementPath, double *number);
+
 
 /**
   @brief Checks if a uID exists.
@@ -3642,6 +4102,9 @@ DLL_EXPORT ReturnCode tixiUIDCheckExists(TixiDocumentHandle handle, const char *
 /**
   @brief Sets a uID attribute to a node, specified via its XPath.
 
+  The document is checked for duplicated uIDs before, unless unique uIDs are
+  enforced by ::tixiUIDSetEnforceUnique. In this case, only the new uID is checked.
+
   <b>Fortran syntax:</b>
 
   tixi_uid_set_to_xpath( integer  handle, character*n xpath, character*n uid, integer error )
@@ -3663,6 +4126,60 @@ DLL_EXPORT ReturnCode tixiUIDCheckExists(TixiDocumentHandle handle, const char *
  */
 DLL_EXPORT ReturnCode tixiUIDSetToXPath(TixiDocumentHandle handle, const char *xPath, const char *uID);
 
+/**
+  @brief Enables or disables the enforcement of unique uIDs when the document is modified.
+
+  If enabled, each write of a uID attribute, e.g. by ::tixiAddTextAttribute or ::tixiUIDSetToXPath,
+  is checked against the uID index of the document in constant time. Writing a non empty uID,
+  that is already used by another element, fails with UID_NOT_UNIQUE and leaves the document unchanged.
+  The same holds for elements added by ::tixiImportElementFromString, ::tixiImportElementFromStringAtIndex
+  and ::tixiAddDoubleListWithAttributes, if they contain a uID already in use.
+  Files loaded by ::tixiAddExternalLink are rejected as a whole, if they contain a uID already in use.
+
+  Enabling the enforcement fails, if the document already contains duplicated uIDs.
+  They are reported like in ::tixiUIDCheckDuplicates.
+
+  <b>Fortran syntax:</b>
+
+  tixi_uid_set_enforce_unique( integer  handle, integer enforce, integer error )
+
+  @param[in]  handle  handle as returned by ::tixiOpenDocument, ::tixiOpenDocumentRecursive, ::tixiOpenDocumentFromHTTP, ::tixiCreateDocument or ::tixiImportFromString
+  @param[in]  enforce 1 to reject duplicated uIDs on write, 0 to allow them (default)
+
+  @return
+    - SUCCESS if the mode has been set
+    - UID_NOT_UNIQUE if the document already contains duplicated uIDs
+    - INVALID_HANDLE if the handle is not valid
+    - FAILED if reading of uids does not work
+ */
+DLL_EXPORT ReturnCode tixiUIDSetEnforceUnique(TixiDocumentHandle handle, int enforce);
+
+/**
+  @brief Sets the number of threads used to read the uIDs and links of the document.
+
+  The uIDs and links are read into an index by the first uID function called, e.g. ::tixiUIDCheckDuplicates
+  or ::tixiUIDCheckLinks, and after the index had to be discarded. Afterwards, the index is updated
+  on each modification and the checks don't need to read the document again.
+
+  With more than one thread, the document is split into subtrees, which are indexed concurrently
+  and merged in document order. This speeds up the checks of large documents on multicore machines.
+  The results are the same as with a single thread.
+
+  <b>Fortran syntax:</b>
+
+  tixi_uid_set_check_threads( integer  handle, integer nThreads, integer error )
+
+  @param[in]  handle   handle as returned by ::tixiOpenDocument, ::tixiOpenDocumentRecursive, ::tixiOpenDocumentFromHTTP, ::tixiCreateDocument or ::tixiImportFromString
+  @param[in]  nThreads number of threads including the calling thread, 0 or 1 to read the document sequentially (default).
+                       Larger values than 256 are limited to 256 threads.
+
+  @return
+    - SUCCESS if the number of threads has been set
+    - INVALID_HANDLE if the handle is not valid
+    - FAILED if nThreads is negative
+ */
+DLL_EXPORT ReturnCode tixiUIDSetCheckThreads(TixiDocumentHandle handle, int nThreads);
+
 
 /*@}*/
 
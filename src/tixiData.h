@@ -30,6 +30,7 @@
 
 #include "libxml/xmlreader.h"
 #include "libxml/xpath.h"
+#include "tixiThreads.h"
 
 #ifndef TIXI_VERSION
 #define TIXI_VERSION  "2.2"
@@ -39,6 +40,7 @@
 #define CPACS_UID_XPATH                 "//@uID"
 #define CPACS_UID_LINK_XPATH            "//@isLink"
 #define CPACS_UID_LINK_ATTRIBUTE_STRING "isLink"
+#define UID_MAX_CHECK_THREADS 256
 
 #define EXTERNAL_DATA_NODE_NAME          "externaldata"
 #define EXTERNAL_DATA_NODE_NAME_PATH     "path"
@@ -53,6 +55,10 @@
  * Definitions about vectors and arrays
  */
 #define VECTOR_SEPARATOR ";"
+#define VECTOR_SEPARATOR_CHAR ';'
+#define VECTOR_FORMAT_EXACT "exact"
+#define VECTOR_ENCODING_ATTRIBUTE "encoding"
+#define VECTOR_ENCODING_BASE64 "base64-f64le"
 #define VECTOR_ATTRIBUTE_NAME "vector"
 #define MAPTYPE_IDENTIFIER "mapType"
 
@@ -107,36 +113,124 @@ typedef  enum DocumentStatusType
 
 
 /**
- * @brief Structure to build a link list of documents.
+ * @brief Chunk of the arena holding the memory returned to the user.
  *
+ * Memory is handed out by bumping the used counter of the newest chunk.
+ * Chunks are linked from the newest to the oldest one and are only freed
+ * in bulk. The data area directly follows the (aligned) chunk header.
  */
-typedef struct TixiMemoryListEntry TixiMemoryListEntry;
-struct TixiMemoryListEntry
+typedef struct TixiMemoryChunk TixiMemoryChunk;
+struct TixiMemoryChunk
 {
-  void* memory;                        /**< Pointer to memory area allocated by libxml */
-  TixiMemoryListEntry* next;    /**< Pointer to next entry in the list */
+  TixiMemoryChunk* next;  /**< Pointer to the next older chunk */
+  size_t size;            /**< Size of the data area in bytes */
+  size_t used;            /**< Number of bytes of the data area already handed out */
+};
+
+/**
+ * @brief Checkpoint of the arena, to which tixiPopMemoryScope rolls back.
+ *
+ */
+typedef struct TixiMemoryScope TixiMemoryScope;
+struct TixiMemoryScope
+{
+  TixiMemoryChunk* chunk;  /**< Newest chunk at the time of the push, NULL if the arena was empty */
+  size_t used;             /**< Bytes used of this chunk at the time of the push */
+  TixiMemoryScope* next;   /**< Pointer to the enclosing scope */
 };
 
 
 /**
- * @brief Structure to build a link list of UIDs.
+ * @brief Entry of the uID index, pointing to an element with a given uID.
  *
+ * Further entries are only chained, if the uID is not unique.
  */
-typedef struct TixiUIDListEntry TixiUIDListEntry;
-struct TixiUIDListEntry
+typedef struct TixiUIDEntry TixiUIDEntry;
+struct TixiUIDEntry
 {
   xmlNodePtr nodePtr;            /**< Pointer to the node with the UID */
-  char* uIDName;              /**< Name of this uID */
-  TixiUIDListEntry* next;        /**< Pointer to next entry in the list */
+  TixiUIDEntry* next;            /**< Pointer to the next node with the same UID */
+};
+
+/**
+ * @brief Cached result of an XPath expression.
+ *
+ * The entries of a cache are chained in the order of their last use.
+ */
+typedef struct XPathCacheEntry XPathCacheEntry;
+struct XPathCacheEntry
+{
+  xmlChar* xpath;               /**< The cached expression */
+  xmlXPathObjectPtr result;     /**< Result of the expression, owned by the cache */
+  XPathCacheEntry* newer;       /**< Entry used next after this one */
+  XPathCacheEntry* older;       /**< Entry used last before this one */
 };
 
+/**
+ * @brief Bounded XPath result cache, evicting the least recently used results.
+ *
+ * The cache owns all results of XPathEvaluateExpression, even if it is disabled.
+ * A result stays valid until it is evicted or the document is modified.
+ * The compiled expressions do not depend on the document and survive modifications.
+ */
 typedef struct
 {
-  xmlChar* xpath;
-  xmlXPathObjectPtr result;
-  int enabled;
+  xmlDictPtr expressions;       /**< Interned expressions, used as keys of the compiled expressions */
+  xmlHashTablePtr compiled;     /**< Compiled expressions by expression */
+  xmlHashTablePtr entries;      /**< Entries by expression */
+  XPathCacheEntry* newest;      /**< Most recently used entry */
+  XPathCacheEntry* oldest;      /**< Least recently used entry, evicted first */
+  int size;                     /**< Number of entries */
+  unsigned long generation;     /**< Generation of the document the cached results belong to */
+  int enabled;                  /**< If disabled, only the last result is kept */
 } XPathCache;
 
+/**
+ * @brief Memo of the path generated last by generateXPathFromNodePtr.
+ *
+ * The path of a node sharing ancestors with the previous node reuses the prefix
+ * of these ancestors. The memo is only valid for the generation of the document
+ * it was built for.
+ */
+typedef struct
+{
+  xmlNodePtr* nodes;            /**< Elements of the last path, from the root element down to the node */
+  size_t* ends;                 /**< Length of the path up to and including each element */
+  int depth;                    /**< Number of valid elements */
+  int capacity;                 /**< Allocated size of nodes and ends */
+  char* path;                   /**< Buffer holding the last path, reused by the next one */
+  size_t pathCapacity;          /**< Allocated size of path */
+  unsigned long generation;     /**< Generation of the document the memo belongs to */
+} TixiPathMemo;
+
+/**
+ * @brief XPath evaluation state of one thread using a thread safe document.
+ *
+ */
+typedef struct TixiThreadContext TixiThreadContext;
+struct TixiThreadContext
+{
+  TixiThreadId thread;             /**< Thread using this context */
+  xmlXPathContextPtr xpathContext; /**< XPath context of the thread */
+  XPathCache* xpathCache;          /**< XPath cache of the thread */
+  int sharedDepth;                 /**< Recursion depth of the shared document lock held by the thread */
+  TixiThreadContext* next;         /**< Pointer to next context in the list */
+};
+
+/**
+ * @brief Synchronization state of a document in thread safe mode.
+ *
+ * Reading API functions hold the lock shared, modifying functions hold it
+ * exclusively. The list of thread contexts only grows, it is traversed without
+ * locking and new contexts are published after they have been initialized.
+ */
+typedef struct
+{
+  TixiRWLock lock;                   /**< Guards the document tree and its meta data */
+  TixiMutex mutex;                   /**< Guards the memory list, adding thread contexts, the path memo and building the uid index for readers */
+  TixiThreadContext* threadContexts; /**< Head of the list of thread contexts */
+} TixiThreadSafety;
+
 /**
  * @brief Structure to hold the document meta data.
  *
@@ -152,26 +246,65 @@ typedef struct
   char* validationFilename;     /**< Name of the file the document is validate against */
   DocumentStatus status;        /**< Status of the document: opened/saved/closed */
   TixiDocumentHandle handle;
-  TixiMemoryListEntry* memoryListHead; /**< Pointer to the head of the list of memory location */
-  TixiMemoryListEntry* memoryListTail; /**< Pointer to the tail of the list of memory location */
+  TixiMemoryChunk* memoryArena;        /**< Newest chunk of the memory returned to the user */
+  TixiMemoryScope* memoryScopes;       /**< Innermost memory scope, NULL if no scope is open */
   int hasIncludedExternalFiles;        /**< Flag to indicate if the master file includes external files */
   int usePrettyPrint;                  /**< if pretty print should used when saving a file */
-  TixiUIDListEntry* uidListHead;       /**< Pointer to the head of the list of uids */
+  xmlDictPtr uidDict;                  /**< Interned uIDs and links, the keys of uidIndex and linkIndex */
+  xmlHashTablePtr uidIndex;            /**< uID entries by uID, NULL until the first uID function is used */
+  xmlHashTablePtr linkIndex;           /**< Linking elements by the uID in their isLink attribute, built together with uidIndex */
+  int uidDuplicates;                   /**< Number of non empty uIDs used by more than one element */
+  int enforceUniqueUIDs;               /**< If set, writing a uID already used by another element fails */
+  int uidCheckThreads;                 /**< Number of threads building the uid index, 0 or 1 to build it sequentially */
   xmlXPathContextPtr xpathContext;     /**< Pointer to the XPath Context */
   XPathCache* xpathCache;              /**< Pointer to the XPath Cache */
+  unsigned long generation;            /**< Incremented on each modification of the document */
+  TixiPathMemo* pathMemo;              /**< Memo of generateXPathFromNodePtr, NULL until it is used */
+  TixiThreadSafety* threadSafety;      /**< Synchronization state, NULL if the document is not thread safe */
 } TixiDocument;
 
-typedef struct TixiDocumentListEntry TixiDocumentListEntry;
-struct TixiDocumentListEntry
+/**
+ * @brief Slot of the document handle table.
+ *
+ * A document handle encodes the index of its slot together with the
+ * generation of the slot at the time the document was registered.
+ * Removing the document increments the generation, such that stale
+ * handles are rejected even if the slot is reused.
+ */
+typedef struct
 {
-  TixiDocument* document; /**< Document meta data */
-  TixiDocumentListEntry* next;    /**< Pointer to next document in the list */
-};
+  TixiDocument* document; /**< Document meta data, NULL if the slot is free */
+  int generation;         /**< Generation of the slot, incremented whenever the slot is freed */
+  int nextFree;           /**< Index of the next free slot, -1 if this is the last free slot */
+} TixiDocumentSlot;
+
+#define TIXI_DOCUMENT_PAGE_BITS 8
+#define TIXI_DOCUMENT_PAGE_SIZE (1 << TIXI_DOCUMENT_PAGE_BITS)
+#define TIXI_DOCUMENT_MAX_PAGES 256
+
+/**
+ * @brief Table of the documents managed by TIXI.
+ *
+ * The slots are allocated in pages that never move, such that documents
+ * can be looked up without locking while other threads add or remove
+ * documents. Adding and removing documents is serialized by the lock.
+ *
+ * Free slots are kept in a FIFO list, so that a slot is reused as late as
+ * possible and the generations of all slots advance evenly.
+ */
+typedef struct
+{
+  TixiDocumentSlot* pages[TIXI_DOCUMENT_MAX_PAGES]; /**< Pages of slots, allocated on demand */
+  int used;                /**< Number of slots that have been used so far */
+  int firstFree;           /**< Index of the first free slot, -1 if there is none */
+  int lastFree;            /**< Index of the last free slot, -1 if there is none */
+  TixiMutex lock;          /**< Serializes adding and removing documents */
+} TixiDocumentTable;
 
 /**
-   Pointer to the head of the list of documents managed by TIXI
+   Table of the documents managed by TIXI
  */
-extern TixiDocumentListEntry* documentListHead;
+extern TixiDocumentTable documentTable;
 
 /**
   Possible values how to save with/without external data.
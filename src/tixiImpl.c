@@ -24,10 +24,13 @@
  */
 
 #include <assert.h>
+#include <ctype.h>
+#include <limits.h>
 #include <stdio.h>
 #include <time.h>
 #include <math.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include "libxml/parser.h"
 #include "libxml/xpath.h"
@@ -42,15 +45,16 @@
 #include "tixi.h"
 #include "tixi_version.h"
 #include "namespaceFunctions.h"
+#include "numberConversion.h"
 
 static xmlNsPtr nameSpace = NULL;
 
 void tixiDefaultMessageHandler(MessageType type, const char* msg);
 
 /**
-  Pointer to the head of the list of documents managed by TIXI
+  Table of the documents managed by TIXI
 */
-TixiDocumentListEntry *documentListHead = NULL;
+TixiDocumentTable documentTable = {{NULL}, 0, -1, -1, TIXI_MUTEX_INITIALIZER};
 
 TixiPrintMsgFnc tixiMessageHandler = tixiDefaultMessageHandler;
 
@@ -94,6 +98,7 @@ TIXI_INTERNAL_EXPORT void printMsg(MessageType type, const char* message, ...)
 }
 
 int _initialized = 0;
+static TixiMutex initLock = TIXI_MUTEX_INITIALIZER;
 
 void xmlErrorHandler(void * ctx, const char *message, ...) {
   char buffer[2048];
@@ -123,11 +128,19 @@ void xmlErrorHandler(void * ctx, const char *message, ...) {
 
 static void tixiInit(void)
 {
-  if (!_initialized) {
-    printMsg(MESSAGETYPE_STATUS, "TiXI initialized\n");
-    xmlSetGenericErrorFunc(NULL, xmlErrorHandler);
-    xsltSetGenericErrorFunc(NULL, xmlErrorHandler);
-    _initialized = 1;
+  /* libxml2 keeps the generic error handler per thread */
+  xmlSetGenericErrorFunc(NULL, xmlErrorHandler);
+
+  if (!tixiAtomicLoadInt(&_initialized)) {
+    tixiMutexLock(&initLock);
+    if (!_initialized) {
+      printMsg(MESSAGETYPE_STATUS, "TiXI initialized\n");
+      /* the parser must be initialized once before it is used by several threads */
+      xmlInitParser();
+      xsltSetGenericErrorFunc(NULL, xmlErrorHandler);
+      tixiAtomicStoreInt(&_initialized, 1);
+    }
+    tixiMutexUnlock(&initLock);
   }
 }
 
@@ -303,13 +316,21 @@ DLL_EXPORT ReturnCode tixiOpenDocumentRecursive(const char *xmlFilename, TixiDoc
     document->currentNode = NULL;
     document->isValid = UNDEFINED;
     document->status = OPENED;
-    document->memoryListHead = NULL;
-    document->memoryListTail = NULL;
+    document->memoryArena = NULL;
+    document->memoryScopes = NULL;
     document->hasIncludedExternalFiles = 1;
     document->usePrettyPrint = 1;
-    document->uidListHead = NULL;
+    document->uidDict = NULL;
+    document->uidIndex = NULL;
+    document->linkIndex = NULL;
+    document->uidDuplicates = 0;
+    document->enforceUniqueUIDs = 0;
+    document->uidCheckThreads = 0;
     document->xpathContext = xmlXPathNewContext(xmlDocument);
     document->xpathCache = XPathNewCache();
+    document->generation = 0;
+    document->pathMemo = NULL;
+    document->threadSafety = NULL;
     addDocumentToList(document, &(document->handle));
     *handle = document->handle;
     returnValue = SUCCESS; /*?*/
@@ -407,13 +428,21 @@ DLL_EXPORT ReturnCode tixiCreateDocument(const char *rootElementName, TixiDocume
   document->currentNode = rootNode;
   document->isValid = UNDEFINED;
   document->status = OPENED;
-  document->memoryListHead = NULL;
-  document->memoryListTail = NULL;
+  document->memoryArena = NULL;
+  document->memoryScopes = NULL;
   document->hasIncludedExternalFiles = 1;
   document->usePrettyPrint = 1;
-  document->uidListHead = NULL;
+  document->uidDict = NULL;
+  document->uidIndex = NULL;
+  document->linkIndex = NULL;
+  document->uidDuplicates = 0;
+  document->enforceUniqueUIDs = 0;
+  document->uidCheckThreads = 0;
   document->xpathContext = xmlXPathNewContext(xmlDocument);
   document->xpathCache = XPathNewCache();
+  document->generation = 0;
+  document->pathMemo = NULL;
+  document->threadSafety = NULL;
 
   if (addDocumentToList(document, &(document->handle)) != SUCESS) {
     printMsg(MESSAGETYPE_ERROR, "Error: Failed  adding document to document list.");
@@ -424,7 +453,7 @@ DLL_EXPORT ReturnCode tixiCreateDocument(const char *rootElementName, TixiDocume
   return SUCCESS;
 }
 
-DLL_EXPORT ReturnCode tixiGetDocumentPath(TixiDocumentHandle handle, char** documentPath)
+static ReturnCode tixiGetDocumentPathImpl(TixiDocumentHandle handle, char** documentPath)
 {
   TixiDocument *document = NULL;
 
@@ -444,27 +473,61 @@ DLL_EXPORT ReturnCode tixiGetDocumentPath(TixiDocumentHandle handle, char** docu
   return SUCCESS;
 }
 
+DLL_EXPORT ReturnCode tixiGetDocumentPath(TixiDocumentHandle handle, char** documentPath)
+{
+  TixiDocument* document = getDocument(handle);
+  ReturnCode error;
+
+  lockDocument(document, LOCK_SHARED);
+  error = tixiGetDocumentPathImpl(handle, documentPath);
+  unlockDocument(document, LOCK_SHARED);
+  return error;
+}
+
 /*
 Distinguish internal/user/fatal errors!!!
 */
 DLL_EXPORT ReturnCode tixiSaveDocument(TixiDocumentHandle handle, const char *xmlFilename)
 {
-  return saveDocument(handle, xmlFilename, SPLITTED);
+  TixiDocument* document = getDocument(handle);
+  ReturnCode error;
+
+  lockDocument(document, LOCK_EXCLUSIVE);
+  error = saveDocument(handle, xmlFilename, SPLITTED);
+  unlockDocument(document, LOCK_EXCLUSIVE);
+  return error;
 }
 
 
 
 DLL_EXPORT ReturnCode tixiSaveCompleteDocument(TixiDocumentHandle handle, const char *xmlFilename)
 {
-  return saveDocument(handle, xmlFilename, COMPLETE);
+  TixiDocument* document = getDocument(handle);
+  ReturnCode error;
+
+  lockDocument(document, LOCK_EXCLUSIVE);
+  error = saveDocument(handle, xmlFilename, COMPLETE);
+  unlockDocument(document, LOCK_EXCLUSIVE);
+  return error;
 }
 
 
-DLL_EXPORT ReturnCode tixiSaveAndRemoveDocument (TixiDocumentHandle handle, const char *xmlFilename)
+static ReturnCode tixiSaveAndRemoveDocumentImpl(TixiDocumentHandle handle, const char *xmlFilename)
 {
   return saveDocument(handle, xmlFilename, REMOVED);
 }
 
+DLL_EXPORT ReturnCode tixiSaveAndRemoveDocument (TixiDocumentHandle handle, const char *xmlFilename)
+{
+  TixiDocument* document = getDocument(handle);
+  ReturnCode error;
+
+  lockDocument(document, LOCK_EXCLUSIVE);
+  error = tixiSaveAndRemoveDocumentImpl(handle, xmlFilename);
+  unlockDocument(document, LOCK_EXCLUSIVE);
+  return error;
+}
+
 
 DLL_EXPORT ReturnCode tixiCloseDocument(TixiDocumentHandle handle)
 {
@@ -494,12 +557,73 @@ DLL_EXPORT ReturnCode tixiCloseDocument(TixiDocumentHandle handle)
 DLL_EXPORT ReturnCode tixiCloseAllDocuments()
 {
   ReturnCode returnValue = SUCCESS;
+  int index;
+
+  for (index = 0; index < getDocumentSlotCount(); ++index) {
+    TixiDocument* document = getDocumentInSlot(index);
+    if (document) {
+      TixiDocumentHandle handle = document->handle;
+      returnValue = tixiCloseDocument(handle);
+      if(returnValue != SUCCESS)
+        return returnValue;
+    }
+  }
+  return SUCCESS;
+}
+
+DLL_EXPORT ReturnCode tixiReleaseReturnedMemory(TixiDocumentHandle handle)
+{
+  TixiDocument *document = getDocument(handle);
 
-  while(documentListHead && documentListHead->document) {
-    TixiDocumentHandle handle = documentListHead->document->handle;
-    returnValue = tixiCloseDocument(handle);
-    if(returnValue != SUCCESS)
-      return returnValue;
+  if (!document) {
+    printMsg(MESSAGETYPE_ERROR, "Error: Invalid document handle.\n");
+    return INVALID_HANDLE;
+  }
+
+  lockDocument(document, LOCK_EXCLUSIVE);
+  clearMemoryArena(document);
+  unlockDocument(document, LOCK_EXCLUSIVE);
+  return SUCCESS;
+}
+
+DLL_EXPORT ReturnCode tixiPushMemoryScope(TixiDocumentHandle handle)
+{
+  TixiDocument *document = getDocument(handle);
+  InternalReturnCode error;
+
+  if (!document) {
+    printMsg(MESSAGETYPE_ERROR, "Error: Invalid document handle.\n");
+    return INVALID_HANDLE;
+  }
+
+  lockDocument(document, LOCK_EXCLUSIVE);
+  error = pushMemoryScope(document);
+  unlockDocument(document, LOCK_EXCLUSIVE);
+
+  if (error != SUCESS) {
+    printMsg(MESSAGETYPE_ERROR, "Error: Could not open memory scope.\n");
+    return FAILED;
+  }
+  return SUCCESS;
+}
+
+DLL_EXPORT ReturnCode tixiPopMemoryScope(TixiDocumentHandle handle)
+{
+  TixiDocument *document = getDocument(handle);
+  int closed;
+
+  if (!document) {
+    printMsg(MESSAGETYPE_ERROR, "Error: Invalid document handle.\n");
+    return INVALID_HANDLE;
+  }
+
+  lockDocument(document, LOCK_EXCLUSIVE);
+  closed = popMemoryScope(document);
+  unlockDocument(document, LOCK_EXCLUSIVE);
+
+  if (!closed) {
+    printMsg(MESSAGETYPE_ERROR, "Error: tixiPopMemoryScope called without matching tixiPushMemoryScope.\n");
+    return FAILED;
   }
   return SUCCESS;
 }
@@ -516,7 +640,7 @@ DLL_EXPORT ReturnCode tixiCleanup()
 }
 
 
-DLL_EXPORT ReturnCode tixiExportDocumentAsString(const TixiDocumentHandle handle, char **text)
+static ReturnCode tixiExportDocumentAsStringImpl(const TixiDocumentHandle handle, char **text)
 {
   TixiDocument *document = getDocument(handle);
   xmlDocPtr xmlDocument = NULL;
@@ -542,16 +666,25 @@ DLL_EXPORT ReturnCode tixiExportDocumentAsString(const TixiDocumentHandle handle
   textPtr = (char *) xmlbuff;
 
   if ( textPtr ) {
-    *text = (char *) malloc((strlen(textPtr) + 1) * sizeof(char));
-    strcpy(*text, textPtr);
+    *text = copyToMemoryArena(document, textPtr);
     xmlFree(textPtr);
   }
   else {
-    *text = (char *) malloc(sizeof(char));
-    strcpy(*text, "");
+    *text = copyToMemoryArena(document, "");
   }
-  error = addToMemoryList(document, (void *) *text);
+  error = *text ? SUCCESS : FAILED;
+
+  return error;
+}
+
+DLL_EXPORT ReturnCode tixiExportDocumentAsString(const TixiDocumentHandle handle, char **text)
+{
+  TixiDocument* document = getDocument(handle);
+  ReturnCode error;
 
+  lockDocument(document, LOCK_SHARED);
+  error = tixiExportDocumentAsStringImpl(handle, text);
+  unlockDocument(document, LOCK_SHARED);
   return error;
 }
 
@@ -586,13 +719,21 @@ DLL_EXPORT ReturnCode tixiImportFromString (const char *xmlImportString, TixiDoc
     document->currentNode = NULL;
     document->isValid = UNDEFINED;
     document->status = OPENED;
-    document->memoryListHead = NULL;
-    document->memoryListTail = NULL;
+    document->memoryArena = NULL;
+    document->memoryScopes = NULL;
     document->hasIncludedExternalFiles = 1;
     document->usePrettyPrint = 1;
-    document->uidListHead = NULL;
+    document->uidDict = NULL;
+    document->uidIndex = NULL;
+    document->linkIndex = NULL;
+    document->uidDuplicates = 0;
+    document->enforceUniqueUIDs = 0;
+    document->uidCheckThreads = 0;
     document->xpathContext = xmlXPathNewContext(xmlDocument);
     document->xpathCache = XPathNewCache();
+    document->generation = 0;
+    document->pathMemo = NULL;
+    document->threadSafety = NULL;
     addDocumentToList(document, &(document->handle));
     *handle = document->handle;
     returnValue = SUCCESS; /*?*/
@@ -608,7 +749,7 @@ DLL_EXPORT ReturnCode tixiImportFromString (const char *xmlImportString, TixiDoc
 
 
 
-DLL_EXPORT ReturnCode tixiAddHeader(const TixiDocumentHandle handle, const char *toolName, const char *version, const char *authorName)
+static ReturnCode tixiAddHeaderImpl(const TixiDocumentHandle handle, const char *toolName, const char *version, const char *authorName)
 {
 
   TixiDocument *document = getDocument(handle);
@@ -693,6 +834,7 @@ DLL_EXPORT ReturnCode tixiAddHeader(const TixiDocumentHandle handle, const char
     return FAILED;
   }
 
+  markDocumentModified(document);
   if (!xmlAddChild(rootElement, headerElement)) {
     printMsg(MESSAGETYPE_ERROR, "Error:  Failed to add header element.\n");
     return FAILED;
@@ -700,8 +842,19 @@ DLL_EXPORT ReturnCode tixiAddHeader(const TixiDocumentHandle handle, const char
   return SUCCESS;
 }
 
+DLL_EXPORT ReturnCode tixiAddHeader(const TixiDocumentHandle handle, const char *toolName, const char *version, const char *authorName)
+{
+  TixiDocument* document = getDocument(handle);
+  ReturnCode error;
+
+  lockDocument(document, LOCK_EXCLUSIVE);
+  error = tixiAddHeaderImpl(handle, toolName, version, authorName);
+  unlockDocument(document, LOCK_EXCLUSIVE);
+  return error;
+}
 
-DLL_EXPORT ReturnCode tixiAddCpacsHeader(const TixiDocumentHandle handle,
+
+static ReturnCode tixiAddCpacsHeaderImpl(const TixiDocumentHandle handle,
                                          const char *name, const char *creator, const char *version,
                                          const char *description, const char * cpacsVersion)
 {
@@ -795,6 +948,7 @@ DLL_EXPORT ReturnCode tixiAddCpacsHeader(const TixiDocumentHandle handle,
     return FAILED;
   }
 
+  markDocumentModified(document);
   if (!xmlAddChild(rootElement, headerElement)) {
     printMsg(MESSAGETYPE_ERROR, "Error:  Failed to add header element.\n");
     return FAILED;
@@ -802,8 +956,21 @@ DLL_EXPORT ReturnCode tixiAddCpacsHeader(const TixiDocumentHandle handle,
   return SUCCESS;
 }
 
+DLL_EXPORT ReturnCode tixiAddCpacsHeader(const TixiDocumentHandle handle,
+                                         const char *name, const char *creator, const char *version,
+                                         const char *description, const char * cpacsVersion)
+{
+  TixiDocument* document = getDocument(handle);
+  ReturnCode error;
 
-DLL_EXPORT ReturnCode tixiSchemaValidateFromFile(const TixiDocumentHandle handle, const char *xsdFilename)
+  lockDocument(document, LOCK_EXCLUSIVE);
+  error = tixiAddCpacsHeaderImpl(handle, name, creator, version, description, cpacsVersion);
+  unlockDocument(document, LOCK_EXCLUSIVE);
+  return error;
+}
+
+
+static ReturnCode tixiSchemaValidateFromFileImpl(const TixiDocumentHandle handle, const char *xsdFilename)
 {
   xmlDocPtr schema_doc;
 
@@ -811,15 +978,44 @@ DLL_EXPORT ReturnCode tixiSchemaValidateFromFile(const TixiDocumentHandle handle
   return( validateSchema(handle, &schema_doc, 0));
 }
 
-DLL_EXPORT ReturnCode tixiSchemaValidateWithDefaultsFromFile(const TixiDocumentHandle handle, const char *xsdFilename)
+DLL_EXPORT ReturnCode tixiSchemaValidateFromFile(const TixiDocumentHandle handle, const char *xsdFilename)
+{
+  TixiDocument* document = getDocument(handle);
+  ReturnCode error;
+
+  lockDocument(document, LOCK_EXCLUSIVE);
+  error = tixiSchemaValidateFromFileImpl(handle, xsdFilename);
+  unlockDocument(document, LOCK_EXCLUSIVE);
+  return error;
+}
+
+static ReturnCode tixiSchemaValidateWithDefaultsFromFileImpl(const TixiDocumentHandle handle, const char *xsdFilename)
 {
   xmlDocPtr schema_doc;
+  TixiDocument* document = getDocument(handle);
+
+  /* the validation adds the default attributes to the document */
+  if (document) {
+    markDocumentModified(document);
+    uid_clearIndex(document);
+  }
 
   schema_doc = xmlReadFile(xsdFilename, NULL, XML_PARSE_NONET);
   return( validateSchema(handle, &schema_doc, 1));
 }
 
-DLL_EXPORT ReturnCode tixiSchemaValidateFromString(const TixiDocumentHandle handle, const char *xsdString)
+DLL_EXPORT ReturnCode tixiSchemaValidateWithDefaultsFromFile(const TixiDocumentHandle handle, const char *xsdFilename)
+{
+  TixiDocument* document = getDocument(handle);
+  ReturnCode error;
+
+  lockDocument(document, LOCK_EXCLUSIVE);
+  error = tixiSchemaValidateWithDefaultsFromFileImpl(handle, xsdFilename);
+  unlockDocument(document, LOCK_EXCLUSIVE);
+  return error;
+}
+
+static ReturnCode tixiSchemaValidateFromStringImpl(const TixiDocumentHandle handle, const char *xsdString)
 {
   xmlDocPtr schema_doc;
 
@@ -827,6 +1023,17 @@ DLL_EXPORT ReturnCode tixiSchemaValidateFromString(const TixiDocumentHandle hand
   return(validateSchema(handle, &schema_doc, 0));
 }
 
+DLL_EXPORT ReturnCode tixiSchemaValidateFromString(const TixiDocumentHandle handle, const char *xsdString)
+{
+  TixiDocument* document = getDocument(handle);
+  ReturnCode error;
+
+  lockDocument(document, LOCK_EXCLUSIVE);
+  error = tixiSchemaValidateFromStringImpl(handle, xsdString);
+  unlockDocument(document, LOCK_EXCLUSIVE);
+  return error;
+}
+
 
 DLL_EXPORT ReturnCode tixiDTDValidate(const TixiDocumentHandle handle, const char *DTDFilename)
 {
@@ -837,49 +1044,100 @@ DLL_EXPORT ReturnCode tixiDTDValidate(const TixiDocumentHandle handle, const cha
   return SUCCESS;
 }
 
-DLL_EXPORT ReturnCode tixiGetTextElement(const TixiDocumentHandle handle, const char *elementPath, char **text)
+/* Returns the text of an element. Text nodes are returned without copying. Texts
+ * assembled from several nodes are also returned in allocated and must be freed
+ * by the caller. */
+static const char* getElementText(TixiDocument *document, xmlNodePtr element, xmlChar **allocated)
+{
+  const xmlChar *textPtr = NULL;
+
+  *allocated = NULL;
+
+  if (xmlNodeIsText(element)) {
+      textPtr = element->content;
+  }
+  else if(getChildNodeCount(element) == 1 && xmlNodeIsText(element->children)) {
+      textPtr = element->children->content;
+  }
+  else {
+      *allocated = xmlNodeListGetString(document->docPtr, element->children, 0);
+      textPtr = *allocated;
+  }
+
+  return textPtr ? (const char *) textPtr : "";
+}
+
+static ReturnCode tixiGetTextElementImpl(const TixiDocumentHandle handle, const char *elementPath, char **text)
 {
   TixiDocument *document = getDocument(handle);
   xmlNodePtr element = NULL;
   ReturnCode error = SUCCESS;
-  int nChilds = 0;
 
   if (!document) {
     printMsg(MESSAGETYPE_ERROR, "Error: Invalid document handle.\n");
     return INVALID_HANDLE;
   }
 
-  error = checkElement(document->xpathContext, elementPath, &element);
+  error = checkElement(document, elementPath, &element);
 
   if (!error) {
-    xmlChar *textPtr = NULL;
+    xmlChar *allocated = NULL;
 
-    nChilds = getChildNodeCount(element);
+    *text = copyToMemoryArena(document, getElementText(document, element, &allocated));
+    xmlFree(allocated);
+    error = *text ? SUCCESS : FAILED;
+  }
 
-    if (xmlNodeIsText(element)) {
-        textPtr = (char *) xmlNodeGetContent(element);
-    }
-    else if(nChilds == 1 && xmlNodeIsText(element->children)) {
-        textPtr = (char *) xmlNodeGetContent(element->children);
-    }
-    else {
-        textPtr = (char *) xmlNodeListGetString(document->docPtr, element->children, 0);
-    }
+  return error;
+}
 
-    if ( textPtr ) {
-      *text = (char *) malloc((strlen(textPtr) + 1) * sizeof(char));
-      strcpy(*text, textPtr);
-      xmlFree(textPtr);
-    } else {
-      *text = (char *) malloc(sizeof(char));
-      strcpy(*text, "");
-    }
-    error = addToMemoryList(document, (void *) *text);
+DLL_EXPORT ReturnCode tixiGetTextElement(const TixiDocumentHandle handle, const char *elementPath, char **text)
+{
+  TixiDocument* document = getDocument(handle);
+  ReturnCode error;
+
+  lockDocument(document, LOCK_SHARED);
+  error = tixiGetTextElementImpl(handle, elementPath, text);
+  unlockDocument(document, LOCK_SHARED);
+  return error;
+}
+
+static ReturnCode tixiGetTextElementIntoImpl(const TixiDocumentHandle handle, const char *elementPath,
+                                             char *buffer, int bufferSize, int *neededSize)
+{
+  TixiDocument *document = getDocument(handle);
+  xmlNodePtr element = NULL;
+  ReturnCode error = SUCCESS;
+
+  if (!document) {
+    printMsg(MESSAGETYPE_ERROR, "Error: Invalid document handle.\n");
+    return INVALID_HANDLE;
+  }
+
+  error = checkElement(document, elementPath, &element);
+
+  if (!error) {
+    xmlChar *allocated = NULL;
+
+    error = copyToBuffer(getElementText(document, element, &allocated), buffer, bufferSize, neededSize);
+    xmlFree(allocated);
   }
 
   return error;
 }
 
+DLL_EXPORT ReturnCode tixiGetTextElementInto(const TixiDocumentHandle handle, const char *elementPath,
+                                             char *buffer, int bufferSize, int *neededSize)
+{
+  TixiDocument* document = getDocument(handle);
+  ReturnCode error;
+
+  lockDocument(document, LOCK_SHARED);
+  error = tixiGetTextElementIntoImpl(handle, elementPath, buffer, bufferSize, neededSize);
+  unlockDocument(document, LOCK_SHARED);
+  return error;
+}
+
 DLL_EXPORT ReturnCode tixiGetIntegerElement(const TixiDocumentHandle handle, const char *elementPath, int *number)
 {
   char *text;
@@ -951,7 +1209,7 @@ DLL_EXPORT ReturnCode tixiGetBooleanElement(const TixiDocumentHandle handle, con
   return SUCCESS;
 }
 
-DLL_EXPORT ReturnCode tixiUpdateTextElement (const TixiDocumentHandle handle, const char *elementPath, const char *text)
+static ReturnCode tixiUpdateTextElementImpl(const TixiDocumentHandle handle, const char *elementPath, const char *text)
 {
   TixiDocument *document = getDocument(handle);
   xmlNodePtr element = NULL;
@@ -968,7 +1226,7 @@ DLL_EXPORT ReturnCode tixiUpdateTextElement (const TixiDocumentHandle handle, co
     return ALREADY_SAVED;
   }
 
-  error = checkElement(document->xpathContext, elementPath, &element);
+  error = checkElement(document, elementPath, &element);
 
   if (!error) {
     // from the documentation:
@@ -990,6 +1248,7 @@ DLL_EXPORT ReturnCode tixiUpdateTextElement (const TixiDocumentHandle handle, co
       return FAILED;
     }
 
+    markDocumentModified(document);
     newElement = xmlNewText((xmlChar*) text);
     if(element->children) {
       xmlNodePtr nodeToReplace = element->children;
@@ -1003,6 +1262,17 @@ DLL_EXPORT ReturnCode tixiUpdateTextElement (const TixiDocumentHandle handle, co
   return error;
 }
 
+DLL_EXPORT ReturnCode tixiUpdateTextElement (const TixiDocumentHandle handle, const char *elementPath, const char *text)
+{
+  TixiDocument* document = getDocument(handle);
+  ReturnCode error;
+
+  lockDocument(document, LOCK_EXCLUSIVE);
+  error = tixiUpdateTextElementImpl(handle, elementPath, text);
+  unlockDocument(document, LOCK_EXCLUSIVE);
+  return error;
+}
+
 
 DLL_EXPORT ReturnCode tixiUpdateDoubleElement (const TixiDocumentHandle handle, const char *elementPath, double number, const char *format)
 {
@@ -1062,11 +1332,72 @@ DLL_EXPORT ReturnCode tixiUpdateBooleanElement (const TixiDocumentHandle handle,
 }
 
 
-DLL_EXPORT ReturnCode tixiGetTextAttribute(const TixiDocumentHandle handle, const char *elementPath,
+/* Returns the value of an attribute or NULL, if the attribute does not exist. Values
+ * consisting of a single text node are returned without copying, all others are also
+ * returned in allocated and must be freed by the caller. */
+static const char* getAttributeText(xmlNodePtr element, const char *attributeName,
+                                    xmlChar **allocated, ReturnCode *errorCode)
+{
+  const char *name = attributeName;
+  const xmlChar *namespaceURI = NULL;
+  xmlAttrPtr attribute = NULL;
+
+  *allocated = NULL;
+  *errorCode = ATTRIBUTE_NOT_FOUND;
+
+  if (strchr(attributeName, ':')) {
+    char* prefix = NULL;
+    char* localName = NULL;
+    xmlNsPtr ns = NULL;
+
+    extractPrefixAndName(attributeName, &prefix, &localName);
+    ns = xmlSearchNs(element->doc, element, (xmlChar*) prefix);
+    if (!ns) {
+      printMsg(MESSAGETYPE_ERROR, "Error: unknown namespace prefix \"%s\".\n",
+               prefix);
+      *errorCode = INVALID_NAMESPACE_PREFIX;
+    }
+    free(prefix);
+    free(localName);
+
+    if (!ns) {
+      return NULL;
+    }
+    name = strchr(attributeName, ':') + 1;
+    namespaceURI = ns->href;
+  }
+
+  if (namespaceURI) {
+    attribute = xmlHasNsProp(element, (xmlChar*) name, namespaceURI);
+  }
+  else {
+    attribute = xmlHasProp(element, (xmlChar *) name);
+  }
+
+  if (!attribute) {
+    return NULL;
+  }
+
+  if (attribute->type == XML_ATTRIBUTE_NODE && attribute->children && !attribute->children->next &&
+      attribute->children->type == XML_TEXT_NODE && attribute->children->content) {
+    return (const char *) attribute->children->content;
+  }
+
+  /* defaults of the DTD or values including entity references */
+  if (namespaceURI) {
+    *allocated = xmlGetNsProp(element, (xmlChar*) name, namespaceURI);
+  }
+  else {
+    *allocated = xmlGetProp(element, (xmlChar *) name);
+  }
+  return (const char *) *allocated;
+}
+
+static ReturnCode tixiGetTextAttributeImpl(const TixiDocumentHandle handle, const char *elementPath,
                                            const char *attributeName, char **text)
 {
   TixiDocument *document = getDocument(handle);
-  char *textPtr;
+  const char *textPtr;
   xmlNodePtr element = NULL;
   ReturnCode error = SUCCESS;
 
@@ -1076,39 +1407,17 @@ DLL_EXPORT ReturnCode tixiGetTextAttribute(const TixiDocumentHandle handle, cons
     return INVALID_HANDLE;
   }
 
-  error = checkElement(document->xpathContext, elementPath, &element);
+  error = checkElement(document, elementPath, &element);
   if (!error) {
-    char* prefix = NULL;
-    char* name = NULL;
+    xmlChar* allocated = NULL;
     ReturnCode errorCode = ATTRIBUTE_NOT_FOUND;
 
-    extractPrefixAndName(attributeName, &prefix, &name);
-
-    if (prefix) {
-      xmlNsPtr ns = xmlSearchNs(element->doc, element, (xmlChar*) prefix);
-      if (!ns) {
-        printMsg(MESSAGETYPE_ERROR, "Error: unknown namespace prefix \"%s\".\n",
-                 prefix);
-        textPtr = NULL;
-        errorCode = INVALID_NAMESPACE_PREFIX;
-      }
-      else {
-        textPtr = (char *) xmlGetNsProp(element, (xmlChar*) name, ns->href);
-      }
-
-      free(prefix);
-    }
-    else {
-      textPtr = (char *) xmlGetProp(element, (xmlChar *) attributeName);
-    }
-
-    free(name);
+    textPtr = getAttributeText(element, attributeName, &allocated, &errorCode);
 
     if (textPtr) {
-      *text = (char *) malloc((strlen(textPtr) + 1) * sizeof(char));
-      strcpy(*text, textPtr);
-      xmlFree(textPtr);
-      error = addToMemoryList(document, (void *) *text);
+      *text = copyToMemoryArena(document, textPtr);
+      xmlFree(allocated);
+      error = *text ? SUCCESS : FAILED;
       return error;
     }
     else {
@@ -1122,6 +1431,59 @@ DLL_EXPORT ReturnCode tixiGetTextAttribute(const TixiDocumentHandle handle, cons
   return error;
 }
 
+DLL_EXPORT ReturnCode tixiGetTextAttribute(const TixiDocumentHandle handle, const char *elementPath,
+                                           const char *attributeName, char **text)
+{
+  TixiDocument* document = getDocument(handle);
+  ReturnCode error;
+
+  lockDocument(document, LOCK_SHARED);
+  error = tixiGetTextAttributeImpl(handle, elementPath, attributeName, text);
+  unlockDocument(document, LOCK_SHARED);
+  return error;
+}
+
+static ReturnCode tixiGetTextAttributeIntoImpl(const TixiDocumentHandle handle, const char *elementPath,
+                                               const char *attributeName, char *buffer, int bufferSize,
+                                               int *neededSize)
+{
+  TixiDocument *document = getDocument(handle);
+  const char *textPtr;
+  xmlNodePtr element = NULL;
+  ReturnCode error = SUCCESS;
+
+  if (!document) {
+    printMsg(MESSAGETYPE_ERROR, "Error: Invalid document handle.\n");
+    return INVALID_HANDLE;
+  }
+
+  error = checkElement(document, elementPath, &element);
+  if (!error) {
+    xmlChar* allocated = NULL;
+
+    textPtr = getAttributeText(element, attributeName, &allocated, &error);
+    if (textPtr) {
+      error = copyToBuffer(textPtr, buffer, bufferSize, neededSize);
+      xmlFree(allocated);
+    }
+  }
+
+  return error;
+}
+
+DLL_EXPORT ReturnCode tixiGetTextAttributeInto(const TixiDocumentHandle handle, const char *elementPath,
+                                               const char *attributeName, char *buffer, int bufferSize,
+                                               int *neededSize)
+{
+  TixiDocument* document = getDocument(handle);
+  ReturnCode error;
+
+  lockDocument(document, LOCK_SHARED);
+  error = tixiGetTextAttributeIntoImpl(handle, elementPath, attributeName, buffer, bufferSize, neededSize);
+  unlockDocument(document, LOCK_SHARED);
+  return error;
+}
+
 DLL_EXPORT ReturnCode tixiGetDoubleAttribute(const TixiDocumentHandle handle,
                                              const char *elementPath, const char *attributeName, double *number)
 {
@@ -1251,7 +1613,7 @@ ReturnCode tixiAddTextElementNSAtIndexImpl(const TixiDocumentHandle handle, cons
   }
 
   /* Check parent element */
-  xpathObject = xmlXPathEvalExpression((xmlChar *) parentPath, document->xpathContext);
+  xpathObject = XPathEvaluateCompiled(document, parentPath, XPathElementPathLength(parentPath));
 
   if (!xpathObject) {
     printMsg(MESSAGETYPE_ERROR, "Error: unable to evaluate xpath expression \"%s\"\n", parentPath);
@@ -1294,7 +1656,7 @@ ReturnCode tixiAddTextElementNSAtIndexImpl(const TixiDocumentHandle handle, cons
     targetNode = targetNode->next;
 
   // structure change!, we have to empty the xpath cache
-  XPathClearCache(document->xpathCache);
+  markDocumentModified(document);
 
   child = xmlNewNode(NULL, (xmlChar *) elemName);
   if (text != NULL) {
@@ -1326,18 +1688,31 @@ ReturnCode tixiAddTextElementNSAtIndexImpl(const TixiDocumentHandle handle, cons
 DLL_EXPORT ReturnCode tixiAddTextElementNSAtIndex(const TixiDocumentHandle handle, const char *parentPath,
                                                   const char *qualifiedName, const char* namespaceURI, const char *text, int index)
 {
+  TixiDocument* document = NULL;
+  ReturnCode error;
+
   if (!namespaceURI) {
     printMsg(MESSAGETYPE_ERROR, "Error: null pointer for namespaceURI!\n");
     return INVALID_NAMESPACE_URI;
   }
 
-  return tixiAddTextElementNSAtIndexImpl(handle, parentPath, qualifiedName, namespaceURI, text, index);
+  document = getDocument(handle);
+  lockDocument(document, LOCK_EXCLUSIVE);
+  error = tixiAddTextElementNSAtIndexImpl(handle, parentPath, qualifiedName, namespaceURI, text, index);
+  unlockDocument(document, LOCK_EXCLUSIVE);
+  return error;
 }
 
 DLL_EXPORT ReturnCode tixiAddTextElementAtIndex(const TixiDocumentHandle handle, const char *parentPath,
                                                const char *elementName, const char *text, int index)
 {
-  return tixiAddTextElementNSAtIndexImpl(handle, parentPath, elementName, NULL, text, index);
+  TixiDocument* document = getDocument(handle);
+  ReturnCode error;
+
+  lockDocument(document, LOCK_EXCLUSIVE);
+  error = tixiAddTextElementNSAtIndexImpl(handle, parentPath, elementName, NULL, text, index);
+  unlockDocument(document, LOCK_EXCLUSIVE);
+  return error;
 }
 
 
@@ -1478,7 +1853,7 @@ DLL_EXPORT ReturnCode tixiAddIntegerElementNS(const TixiDocumentHandle handle, c
 }
 
 
-DLL_EXPORT ReturnCode tixiAddTextAttribute(const TixiDocumentHandle handle, const char *elementPath,
+static ReturnCode tixiAddTextAttributeImpl(const TixiDocumentHandle handle, const char *elementPath,
                                            const char *attributeName, const char *attributeValue)
 {
   TixiDocument *document = getDocument(handle);
@@ -1493,7 +1868,20 @@ DLL_EXPORT ReturnCode tixiAddTextAttribute(const TixiDocumentHandle handle, cons
     return ALREADY_SAVED;
   }
 
-  return genericAddTextAttribute(document->xpathContext, elementPath, attributeName, attributeValue);
+  markDocumentModified(document);
+  return genericAddTextAttribute(document, elementPath, attributeName, attributeValue);
+}
+
+DLL_EXPORT ReturnCode tixiAddTextAttribute(const TixiDocumentHandle handle, const char *elementPath,
+                                           const char *attributeName, const char *attributeValue)
+{
+  TixiDocument* document = getDocument(handle);
+  ReturnCode error;
+
+  lockDocument(document, LOCK_EXCLUSIVE);
+  error = tixiAddTextAttributeImpl(handle, elementPath, attributeName, attributeValue);
+  unlockDocument(document, LOCK_EXCLUSIVE);
+  return error;
 }
 
 DLL_EXPORT ReturnCode tixiAddDoubleAttribute(const TixiDocumentHandle handle,
@@ -1547,7 +1935,30 @@ DLL_EXPORT ReturnCode tixiAddIntegerAttribute(const TixiDocumentHandle handle,
 }
 
 
-DLL_EXPORT ReturnCode tixiAddFloatVector (const TixiDocumentHandle handle, const char *parentPath, const char *elementName, const double *vector, const int numElements, const char* format)
+/* encodings of the numbers of a vector element */
+#define VECTOR_ENCODING_TEXT 0
+#define VECTOR_ENCODING_BASE64_F64LE 1
+
+/* Returns the encoding given by the encoding attribute of a vector element. The binary
+ * encoding is opt-in, elements without it hold text, whatever other encoding they name. */
+static int getVectorEncoding(xmlNodePtr element)
+{
+  xmlChar *encoding = NULL;
+  int result = VECTOR_ENCODING_TEXT;
+
+  if (!xmlHasProp(element, (xmlChar *) VECTOR_ENCODING_ATTRIBUTE)) {
+    return VECTOR_ENCODING_TEXT;
+  }
+
+  encoding = xmlGetProp(element, (xmlChar *) VECTOR_ENCODING_ATTRIBUTE);
+  if (encoding && !strcmp((char *) encoding, VECTOR_ENCODING_BASE64)) {
+    result = VECTOR_ENCODING_BASE64_F64LE;
+  }
+  xmlFree(encoding);
+  return result;
+}
+
+static ReturnCode tixiAddFloatVectorImpl(const TixiDocumentHandle handle, const char *parentPath, const char *elementName, const double *vector, const int numElements, const char* format)
 {
   ReturnCode error;
   char *stringVector = NULL;
@@ -1558,9 +1969,14 @@ DLL_EXPORT ReturnCode tixiAddFloatVector (const TixiDocumentHandle handle, const
   };
 
   stringVector = vectorToString(vector, numElements, format);
+  if (!stringVector) {
+    printMsg(MESSAGETYPE_ERROR, "Internal Error: Failed to allocate memory in tixiAddFloatVector.\n");
+    return FAILED;
+  }
 
   /* Add element */
   error = tixiAddTextElement(handle, parentPath, elementName, stringVector);
+  free(stringVector);
   if(error != SUCCESS) {
     return error;
   }
@@ -1572,39 +1988,107 @@ DLL_EXPORT ReturnCode tixiAddFloatVector (const TixiDocumentHandle handle, const
   strcat(textBuffer, "/");
   strcat(textBuffer, elementName);
   error = tixiAddTextAttribute(handle, textBuffer, MAPTYPE_IDENTIFIER, VECTOR_ATTRIBUTE_NAME);
+  if (error == SUCCESS && !strcmp(format, VECTOR_ENCODING_BASE64)) {
+    error = tixiAddTextAttribute(handle, textBuffer, VECTOR_ENCODING_ATTRIBUTE, VECTOR_ENCODING_BASE64);
+  }
   if(error != SUCCESS) {
     return error;
   }
   free(textBuffer);
-  free(stringVector);
 
   return SUCCESS;
 }
 
-DLL_EXPORT ReturnCode tixiUpdateFloatVector (const TixiDocumentHandle handle, const char *path, const double *vector, const int numElements, const char* format)
+DLL_EXPORT ReturnCode tixiAddFloatVector (const TixiDocumentHandle handle, const char *parentPath, const char *elementName, const double *vector, const int numElements, const char* format)
+{
+  TixiDocument* document = getDocument(handle);
+  ReturnCode error;
+
+  lockDocument(document, LOCK_EXCLUSIVE);
+  error = tixiAddFloatVectorImpl(handle, parentPath, elementName, vector, numElements, format);
+  unlockDocument(document, LOCK_EXCLUSIVE);
+  return error;
+}
+
+static ReturnCode tixiUpdateFloatVectorImpl(const TixiDocumentHandle handle, const char *path, const double *vector, const int numElements, const char* format)
 {
+  TixiDocument *document = getDocument(handle);
+  xmlNodePtr element = NULL;
   ReturnCode error;
   char *stringVector = NULL;
+  int encoding = VECTOR_ENCODING_TEXT;
+  int base64 = 0;
 
   if(numElements < 1) {
     return FAILED;
   }
 
+  if (!document) {
+    printMsg(MESSAGETYPE_ERROR, "Error: Invalid document handle.\n");
+    return INVALID_HANDLE;
+  }
+
+  error = checkElement(document, path, &element);
+  if (error != SUCCESS) {
+    return error;
+  }
+
+  /* without a format, an encoded vector keeps its encoding */
+  encoding = getVectorEncoding(element);
   if (!format) {
-    format = "%g";
+    format = encoding == VECTOR_ENCODING_BASE64_F64LE ? VECTOR_ENCODING_BASE64 : "%g";
   };
+  base64 = !strcmp(format, VECTOR_ENCODING_BASE64);
 
   stringVector = vectorToString(vector, numElements, format);
+  if (!stringVector) {
+    printMsg(MESSAGETYPE_ERROR, "Internal Error: Failed to allocate memory in tixiUpdateFloatVector.\n");
+    return FAILED;
+  }
+
+  /* text and encoding have to match after a failure as well: the attribute, whose
+   * setting may fail, is set before the text and restored, if the text can't be updated.
+   * Removing the attribute after the text can't fail. */
+  if (base64 && encoding != VECTOR_ENCODING_BASE64_F64LE) {
+    xmlChar *previousEncoding = xmlGetProp(element, (xmlChar *) VECTOR_ENCODING_ATTRIBUTE);
+
+    error = tixiAddTextAttribute(handle, path, VECTOR_ENCODING_ATTRIBUTE, VECTOR_ENCODING_BASE64);
+    if (error == SUCCESS) {
+      error = tixiUpdateTextElement(handle, path, stringVector);
+      if (error != SUCCESS && previousEncoding) {
+        xmlSetProp(element, (xmlChar *) VECTOR_ENCODING_ATTRIBUTE, previousEncoding);
+      }
+      else if (error != SUCCESS) {
+        xmlUnsetProp(element, (xmlChar *) VECTOR_ENCODING_ATTRIBUTE);
+      }
+    }
+    xmlFree(previousEncoding);
+    free(stringVector);
+    return error;
+  }
 
   error = tixiUpdateTextElement(handle, path, stringVector);
   free(stringVector);
+  if (error == SUCCESS && !base64 && encoding == VECTOR_ENCODING_BASE64_F64LE) {
+    error = tixiRemoveAttribute(handle, path, VECTOR_ENCODING_ATTRIBUTE);
+  }
+  return error;
+}
+
+DLL_EXPORT ReturnCode tixiUpdateFloatVector (const TixiDocumentHandle handle, const char *path, const double *vector, const int numElements, const char* format)
+{
+  TixiDocument* document = getDocument(handle);
+  ReturnCode error;
 
+  lockDocument(document, LOCK_EXCLUSIVE);
+  error = tixiUpdateFloatVectorImpl(handle, path, vector, numElements, format);
+  unlockDocument(document, LOCK_EXCLUSIVE);
   return error;
 }
 
 
 
-DLL_EXPORT ReturnCode tixiRemoveAttribute(const TixiDocumentHandle handle, const char *elementPath, const char *attributeName)
+static ReturnCode tixiRemoveAttributeImpl(const TixiDocumentHandle handle, const char *elementPath, const char *attributeName)
 {
   xmlNodePtr parent;
   int retVal = 0;
@@ -1626,8 +2110,17 @@ DLL_EXPORT ReturnCode tixiRemoveAttribute(const TixiDocumentHandle handle, const
   document = getDocument(handle);
   extractPrefixAndName(attributeName, &prefix, &name);
   if (!prefix) {
-    XPathClearCache(document->xpathCache);
+    int isIndexed = uid_isIndexedAttribute(attributeName);
+
+    markDocumentModified(document);
+    if (isIndexed) {
+      uid_removeElement(document, parent);
+    }
     retVal = xmlUnsetProp(parent, (xmlChar *) attributeName);
+    if (isIndexed) {
+      /* the other indexed attribute may still be there */
+      uid_addElement(document, parent);
+    }
   }
   else {
     xmlNsPtr ns = xmlSearchNs(parent->doc, parent, (xmlChar *) prefix);
@@ -1637,7 +2130,7 @@ DLL_EXPORT ReturnCode tixiRemoveAttribute(const TixiDocumentHandle handle, const
       errorCode = INVALID_NAMESPACE_PREFIX;
     }
     else {
-      XPathClearCache(document->xpathCache);
+      markDocumentModified(document);
       retVal = xmlUnsetNsProp(parent, ns, (xmlChar*) name);
     }
     free(prefix);
@@ -1656,7 +2149,18 @@ DLL_EXPORT ReturnCode tixiRemoveAttribute(const TixiDocumentHandle handle, const
   }
 }
 
-DLL_EXPORT ReturnCode tixiRenameElement(const TixiDocumentHandle handle,
+DLL_EXPORT ReturnCode tixiRemoveAttribute(const TixiDocumentHandle handle, const char *elementPath, const char *attributeName)
+{
+  TixiDocument* document = getDocument(handle);
+  ReturnCode error;
+
+  lockDocument(document, LOCK_EXCLUSIVE);
+  error = tixiRemoveAttributeImpl(handle, elementPath, attributeName);
+  unlockDocument(document, LOCK_EXCLUSIVE);
+  return error;
+}
+
+static ReturnCode tixiRenameElementImpl(const TixiDocumentHandle handle,
                                         const char* parentPath,
                                         const char* oldName,
                                         const char* newName)
@@ -1682,11 +2186,26 @@ DLL_EXPORT ReturnCode tixiRenameElement(const TixiDocumentHandle handle,
         return retVal;
     }
 
+    markDocumentModified(getDocument(handle));
     xmlNodeSetName(element, (xmlChar*) newName);
     return SUCCESS;
 }
 
-DLL_EXPORT ReturnCode tixiRemoveElement(const TixiDocumentHandle handle, const char *elementPath)
+DLL_EXPORT ReturnCode tixiRenameElement(const TixiDocumentHandle handle,
+                                        const char* parentPath,
+                                        const char* oldName,
+                                        const char* newName)
+{
+  TixiDocument* document = getDocument(handle);
+  ReturnCode error;
+
+  lockDocument(document, LOCK_EXCLUSIVE);
+  error = tixiRenameElementImpl(handle, parentPath, oldName, newName);
+  unlockDocument(document, LOCK_EXCLUSIVE);
+  return error;
+}
+
+static ReturnCode tixiRemoveElementImpl(const TixiDocumentHandle handle, const char *elementPath)
 {
   xmlNodePtr parent = NULL;
   ReturnCode retVal;
@@ -1695,7 +2214,8 @@ DLL_EXPORT ReturnCode tixiRemoveElement(const TixiDocumentHandle handle, const c
 
   if(parent != NULL) {
     TixiDocument* document = getDocument(handle);
-    XPathClearCache(document->xpathCache);
+    markDocumentModified(document);
+    uid_removeSubtree(document, parent);
     xmlUnlinkNode(parent);
     xmlFreeNode(parent);
     return SUCCESS;
@@ -1705,8 +2225,19 @@ DLL_EXPORT ReturnCode tixiRemoveElement(const TixiDocumentHandle handle, const c
   }
 }
 
+DLL_EXPORT ReturnCode tixiRemoveElement(const TixiDocumentHandle handle, const char *elementPath)
+{
+  TixiDocument* document = getDocument(handle);
+  ReturnCode error;
 
-DLL_EXPORT ReturnCode tixiGetNamedChildrenCount(const TixiDocumentHandle handle,
+  lockDocument(document, LOCK_EXCLUSIVE);
+  error = tixiRemoveElementImpl(handle, elementPath);
+  unlockDocument(document, LOCK_EXCLUSIVE);
+  return error;
+}
+
+
+static ReturnCode tixiGetNamedChildrenCountImpl(const TixiDocumentHandle handle,
                                                 const char *elementPath, const char *childName, int *count)
 {
   TixiDocument *document = getDocument(handle);
@@ -1716,9 +2247,10 @@ DLL_EXPORT ReturnCode tixiGetNamedChildrenCount(const TixiDocumentHandle handle,
   char * childTagName = NULL;
 
   int iNode;
+  size_t pathLength = XPathElementPathLength(elementPath);
   char *childElementPath =
-      (char *) malloc(sizeof(char) * (strlen(elementPath) + strlen(childName) + 2));
-  char *allChildren = (char *) malloc(sizeof(char) * (strlen(elementPath) + 3));
+      (char *) malloc(sizeof(char) * (pathLength + strlen(childName) + 2));
+  char *allChildren = (char *) malloc(sizeof(char) * (pathLength + 3));
 
 
 
@@ -1729,20 +2261,20 @@ DLL_EXPORT ReturnCode tixiGetNamedChildrenCount(const TixiDocumentHandle handle,
     return INVALID_HANDLE;
   }
 
-  childElementPath[0] = '\0';
-  allChildren[0] = '\0';
+  memcpy(childElementPath, elementPath, pathLength);
+  childElementPath[pathLength] = '\0';
+  memcpy(allChildren, elementPath, pathLength);
+  allChildren[pathLength] = '\0';
 
-  strcat(childElementPath, elementPath);
   strcat(childElementPath, "/");
   strcat(childElementPath, childName);
 
-  strcat(allChildren, elementPath);
   strcat(allChildren, "/*");
 
   *count = 0;
 
   /* first check parent */
-  xpathObject = xmlXPathEvalExpression((xmlChar *) elementPath, document->xpathContext);
+  xpathObject = XPathEvaluateCompiled(document, elementPath, pathLength);
 
   if (!xpathObject) {
     printMsg(MESSAGETYPE_ERROR, "Error: unable to evaluate xpath expression \"%s\"\n", elementPath);
@@ -1775,7 +2307,7 @@ DLL_EXPORT ReturnCode tixiGetNamedChildrenCount(const TixiDocumentHandle handle,
   /* check if there are children at all */
 
 
-  xpathObject = xmlXPathEvalExpression((xmlChar *) allChildren, document->xpathContext);
+  xpathObject = XPathEvaluateCompiled(document, allChildren, strlen(allChildren));
 
   if (!xpathObject) {
     printMsg(MESSAGETYPE_ERROR, "Error: unable to evaluate xpath expression \"%s\"\n", allChildren);
@@ -1799,7 +2331,7 @@ DLL_EXPORT ReturnCode tixiGetNamedChildrenCount(const TixiDocumentHandle handle,
 
   /* now check child */
 
-  xpathObject = xmlXPathEvalExpression((xmlChar *) childElementPath, document->xpathContext);
+  xpathObject = XPathEvaluateCompiled(document, childElementPath, strlen(childElementPath));
 
   if (!xpathObject) {
     printMsg(MESSAGETYPE_ERROR, "Error: unable to evaluate xpath expression \"%s\"\n", childElementPath);
@@ -1848,7 +2380,19 @@ DLL_EXPORT ReturnCode tixiGetNamedChildrenCount(const TixiDocumentHandle handle,
   return SUCCESS;
 }
 
-DLL_EXPORT ReturnCode tixiAddDoubleListWithAttributes(const TixiDocumentHandle handle,
+DLL_EXPORT ReturnCode tixiGetNamedChildrenCount(const TixiDocumentHandle handle,
+                                                const char *elementPath, const char *childName, int *count)
+{
+  TixiDocument* document = getDocument(handle);
+  ReturnCode error;
+
+  lockDocument(document, LOCK_SHARED);
+  error = tixiGetNamedChildrenCountImpl(handle, elementPath, childName, count);
+  unlockDocument(document, LOCK_SHARED);
+  return error;
+}
+
+static ReturnCode tixiAddDoubleListWithAttributesImpl(const TixiDocumentHandle handle,
                                                       const char *parentPath, const char *listName,
                                                       const char *childName,
                                                       const char *attributeName,
@@ -1891,7 +2435,7 @@ DLL_EXPORT ReturnCode tixiAddDoubleListWithAttributes(const TixiDocumentHandle h
     format = "%g";
   }
 
-  error = checkElement(document->xpathContext, parentPath, &parent);
+  error = checkElement(document, parentPath, &parent);
   if (!error) {
 
     /* create node containing the list */
@@ -1931,6 +2475,7 @@ DLL_EXPORT ReturnCode tixiAddDoubleListWithAttributes(const TixiDocumentHandle h
     }
 
 
+    markDocumentModified(document);
     if (!xmlAddChild(parent, listNode)) {
       printMsg(MESSAGETYPE_ERROR,
                "Error:  Failed to add list element \"%s\" to parent \"%s\".\n",
@@ -1939,7 +2484,12 @@ DLL_EXPORT ReturnCode tixiAddDoubleListWithAttributes(const TixiDocumentHandle h
       return FAILED;
     }
     else {
-      return SUCCESS;
+      error = uid_addSubtreeUnique(document, listNode);
+      if (error != SUCCESS) {
+        xmlUnlinkNode(listNode);
+        xmlFreeNode(listNode);
+      }
+      return error;
     }
   }
   else {
@@ -1947,7 +2497,23 @@ DLL_EXPORT ReturnCode tixiAddDoubleListWithAttributes(const TixiDocumentHandle h
   }
 }
 
-DLL_EXPORT ReturnCode tixiAddPoint(const TixiDocumentHandle handle, const char *parentPath,
+DLL_EXPORT ReturnCode tixiAddDoubleListWithAttributes(const TixiDocumentHandle handle,
+                                                      const char *parentPath, const char *listName,
+                                                      const char *childName,
+                                                      const char *attributeName,
+                                                      const double *values, const char *format,
+                                                      const char **attributes, int nValues)
+{
+  TixiDocument* document = getDocument(handle);
+  ReturnCode error;
+
+  lockDocument(document, LOCK_EXCLUSIVE);
+  error = tixiAddDoubleListWithAttributesImpl(handle, parentPath, listName, childName, attributeName, values, format, attributes, nValues);
+  unlockDocument(document, LOCK_EXCLUSIVE);
+  return error;
+}
+
+static ReturnCode tixiAddPointImpl(const TixiDocumentHandle handle, const char *parentPath,
                                    double x, double y, double z, const char *format)
 {
   ReturnCode error = -1;
@@ -1968,7 +2534,7 @@ DLL_EXPORT ReturnCode tixiAddPoint(const TixiDocumentHandle handle, const char *
     format = "%g";
   }
 
-  error = checkElement(document->xpathContext, parentPath, &parent);
+  error = checkElement(document, parentPath, &parent);
 
   if (!error) {
     /* create node containing the point coordinates */
@@ -1978,7 +2544,7 @@ DLL_EXPORT ReturnCode tixiAddPoint(const TixiDocumentHandle handle, const char *
 
     /* add x coordinate */
     char *textBuffer = buildString(format, x);
-    XPathClearCache(document->xpathCache);
+    markDocumentModified(document);
 
     if (textBuffer) {
 
@@ -2041,8 +2607,20 @@ DLL_EXPORT ReturnCode tixiAddPoint(const TixiDocumentHandle handle, const char *
   return SUCCESS;
 }
 
+DLL_EXPORT ReturnCode tixiAddPoint(const TixiDocumentHandle handle, const char *parentPath,
+                                   double x, double y, double z, const char *format)
+{
+  TixiDocument* document = getDocument(handle);
+  ReturnCode error;
+
+  lockDocument(document, LOCK_EXCLUSIVE);
+  error = tixiAddPointImpl(handle, parentPath, x, y, z, format);
+  unlockDocument(document, LOCK_EXCLUSIVE);
+  return error;
+}
+
 
-DLL_EXPORT ReturnCode tixiGetPoint(const TixiDocumentHandle handle, const char *parentPath,
+static ReturnCode tixiGetPointImpl(const TixiDocumentHandle handle, const char *parentPath,
                                    double *x, double *y, double *z)
 {
   int ignoreMissingElement = 1;
@@ -2055,12 +2633,43 @@ DLL_EXPORT ReturnCode tixiGetPoint(const TixiDocumentHandle handle, const char *
   return error;
 }
 
-DLL_EXPORT ReturnCode tixiAddExternalLink(const TixiDocumentHandle handle, const char *parentPath,
+DLL_EXPORT ReturnCode tixiGetPoint(const TixiDocumentHandle handle, const char *parentPath,
+                                   double *x, double *y, double *z)
+{
+  TixiDocument* document = getDocument(handle);
+  ReturnCode error;
+
+  lockDocument(document, LOCK_SHARED);
+  error = tixiGetPointImpl(handle, parentPath, x, y, z);
+  unlockDocument(document, LOCK_SHARED);
+  return error;
+}
+
+/* removes the children of parent between previous and next (both excluded, NULL for the
+ * ends of the list), that have been loaded from external files, from the document */
+static void removeLoadedExternalNodes(TixiDocument *document, xmlNodePtr parent, xmlNodePtr previous, xmlNodePtr next)
+{
+  xmlNodePtr node = previous ? previous->next : parent->children;
+
+  markDocumentModified(document);
+  while (node && node != next) {
+    xmlNodePtr following = node->next;
+
+    uid_removeSubtree(document, node);
+    xmlUnlinkNode(node);
+    xmlFreeNode(node);
+    node = following;
+  }
+}
+
+static ReturnCode tixiAddExternalLinkImpl(const TixiDocumentHandle handle, const char *parentPath,
                                           const char *path, const char *filename, AddLinkMode mode)
 {
   ReturnCode errorCode = FAILED;
   xmlNodePtr parent = NULL;
   xmlNodePtr externalNode = NULL;
+  xmlNodePtr previous = NULL;
+  xmlNodePtr next = NULL;
   TixiDocument *document = NULL;
 
   // check arguments
@@ -2085,7 +2694,7 @@ DLL_EXPORT ReturnCode tixiAddExternalLink(const TixiDocumentHandle handle, const
       return INVALID_HANDLE;
   }
 
-  errorCode = checkElement(document->xpathContext, parentPath, &parent);
+  errorCode = checkElement(document, parentPath, &parent);
   if (errorCode != SUCCESS) {
       return errorCode;
   }
@@ -2096,17 +2705,48 @@ DLL_EXPORT ReturnCode tixiAddExternalLink(const TixiDocumentHandle handle, const
       return FAILED;
   }
 
+  markDocumentModified(document);
   externalNode = xmlAddChild(parent, externalNode);
 
   if (mode == ADDLINK_CREATE_AND_OPEN) {
     int fileCount = 0;
-    return loadExternalDataNode(document, externalNode, &fileCount);
+
+    /* the loaded files replace the link between these siblings */
+    previous = externalNode->prev;
+    next = externalNode->next;
+    errorCode = loadExternalDataNode(document, externalNode, &fileCount);
+    if (errorCode != SUCCESS || !document->enforceUniqueUIDs) {
+      return errorCode;
+    }
+
+    /* the loaded files are checked as a whole in the rebuilt index. If they
+     * contain a uID already in use, the document is restored. */
+    if (uid_readDocumentUIDs(document) != SUCCESS) {
+      removeLoadedExternalNodes(document, parent, previous, next);
+      return FAILED;
+    }
+    if (uid_checkForDuplicates(document) != SUCCESS) {
+      removeLoadedExternalNodes(document, parent, previous, next);
+      return UID_NOT_UNIQUE;
+    }
   }
 
   return SUCCESS;
 }
 
-DLL_EXPORT ReturnCode tixiRemoveExternalLinks(TixiDocumentHandle handle)
+DLL_EXPORT ReturnCode tixiAddExternalLink(const TixiDocumentHandle handle, const char *parentPath,
+                                          const char *path, const char *filename, AddLinkMode mode)
+{
+  TixiDocument* document = getDocument(handle);
+  ReturnCode error;
+
+  lockDocument(document, LOCK_EXCLUSIVE);
+  error = tixiAddExternalLinkImpl(handle, parentPath, path, filename, mode);
+  unlockDocument(document, LOCK_EXCLUSIVE);
+  return error;
+}
+
+static ReturnCode tixiRemoveExternalLinksImpl(TixiDocumentHandle handle)
 {
     TixiDocument* document = getDocument(handle);
     xmlNodePtr rootNode = 0;
@@ -2116,13 +2756,25 @@ DLL_EXPORT ReturnCode tixiRemoveExternalLinks(TixiDocumentHandle handle)
       return INVALID_HANDLE;
     }
 
+    markDocumentModified(document);
     rootNode = xmlDocGetRootElement(document->docPtr);
     removeExternalNodeLinks(rootNode);
 
     return SUCCESS;
 }
 
-DLL_EXPORT ReturnCode tixiUsePrettyPrint(TixiDocumentHandle handle, int usePrettyPrint)
+DLL_EXPORT ReturnCode tixiRemoveExternalLinks(TixiDocumentHandle handle)
+{
+  TixiDocument* document = getDocument(handle);
+  ReturnCode error;
+
+  lockDocument(document, LOCK_EXCLUSIVE);
+  error = tixiRemoveExternalLinksImpl(handle);
+  unlockDocument(document, LOCK_EXCLUSIVE);
+  return error;
+}
+
+static ReturnCode tixiUsePrettyPrintImpl(TixiDocumentHandle handle, int usePrettyPrint)
 {
   TixiDocument *document = getDocument(handle);
 
@@ -2139,6 +2791,17 @@ DLL_EXPORT ReturnCode tixiUsePrettyPrint(TixiDocumentHandle handle, int usePrett
   return SUCCESS;
 }
 
+DLL_EXPORT ReturnCode tixiUsePrettyPrint(TixiDocumentHandle handle, int usePrettyPrint)
+{
+  TixiDocument* document = getDocument(handle);
+  ReturnCode error;
+
+  lockDocument(document, LOCK_EXCLUSIVE);
+  error = tixiUsePrettyPrintImpl(handle, usePrettyPrint);
+  unlockDocument(document, LOCK_EXCLUSIVE);
+  return error;
+}
+
 DLL_EXPORT ReturnCode tixiSetPrintMsgFunc(TixiPrintMsgFnc func)
 {
   tixiInit();
@@ -2159,27 +2822,79 @@ DLL_EXPORT TixiPrintMsgFnc tixiGetPrintMsgFunc()
 }
 
 
-DLL_EXPORT ReturnCode tixiGetVectorSize (const TixiDocumentHandle handle, const char *vectorPath, int *nElements)
+/* Counts the non-empty elements of a vector text. The loop has no branches
+ * depending on the text, so that compilers can vectorize it. */
+static int countVectorElements(const char *text)
 {
-  ReturnCode error = FAILED;
-  char *tmpString = NULL;
-  char *token = NULL;
-  *nElements = 0;
+  const unsigned char *position = (const unsigned char *) text;
+  size_t length = strlen(text);
+  size_t i;
+  int count = 0;
+  int previousIsSeparator = 1;
 
-  error = tixiGetTextElement(handle, vectorPath, &tmpString);
-  if(error != SUCCESS) {
-    return error;
+  for (i = 0; i < length; ++i) {
+    int isSeparator = position[i] == VECTOR_SEPARATOR_CHAR;
+
+    count += previousIsSeparator & !isSeparator;
+    previousIsSeparator = isSeparator;
+  }
+  return count;
+}
+
+/* Counts the elements of a vector element with the given text */
+static ReturnCode countVector(xmlNodePtr element, const char *text, int *count)
+{
+  *count = 0;
+  if (getVectorEncoding(element) == VECTOR_ENCODING_TEXT) {
+    *count = countVectorElements(text);
+    return SUCCESS;
   }
 
-  token = strtok(tmpString, VECTOR_SEPARATOR);
-  while(token != NULL) {
-    *nElements = *nElements + 1;
-    token = strtok(0, VECTOR_SEPARATOR);
+  *count = base64DoubleCount(text);
+  if (*count < 0) {
+    *count = 0;
+    printMsg(MESSAGETYPE_ERROR, "Error: The vector is no valid " VECTOR_ENCODING_BASE64 " data.\n");
+    return NO_NUMBER;
   }
   return SUCCESS;
 }
 
-DLL_EXPORT ReturnCode tixiSetCacheEnabled(TixiDocumentHandle handle, int enabled)
+static ReturnCode tixiGetVectorSizeImpl(const TixiDocumentHandle handle, const char *vectorPath, int *nElements)
+{
+  TixiDocument *document = getDocument(handle);
+  xmlNodePtr element = NULL;
+  xmlChar *allocated = NULL;
+  ReturnCode error = SUCCESS;
+
+  *nElements = 0;
+
+  if (!document) {
+    printMsg(MESSAGETYPE_ERROR, "Error: Invalid document handle.\n");
+    return INVALID_HANDLE;
+  }
+
+  error = checkElement(document, vectorPath, &element);
+  if (error != SUCCESS) {
+    return error;
+  }
+
+  error = countVector(element, getElementText(document, element, &allocated), nElements);
+  xmlFree(allocated);
+  return error;
+}
+
+DLL_EXPORT ReturnCode tixiGetVectorSize (const TixiDocumentHandle handle, const char *vectorPath, int *nElements)
+{
+  TixiDocument* document = getDocument(handle);
+  ReturnCode error;
+
+  lockDocument(document, LOCK_SHARED);
+  error = tixiGetVectorSizeImpl(handle, vectorPath, nElements);
+  unlockDocument(document, LOCK_SHARED);
+  return error;
+}
+
+static ReturnCode tixiSetCacheEnabledImpl(TixiDocumentHandle handle, int enabled)
 {
     TixiDocument *document = getDocument(handle);
 
@@ -2192,15 +2907,47 @@ DLL_EXPORT ReturnCode tixiSetCacheEnabled(TixiDocumentHandle handle, int enabled
         return FAILED;
     }
 
-    document->xpathCache->enabled = enabled;
+    setXPathCachesEnabled(document, enabled);
+
+    return SUCCESS;
+}
+
+DLL_EXPORT ReturnCode tixiSetCacheEnabled(TixiDocumentHandle handle, int enabled)
+{
+  TixiDocument* document = getDocument(handle);
+  ReturnCode error;
+
+  lockDocument(document, LOCK_EXCLUSIVE);
+  error = tixiSetCacheEnabledImpl(handle, enabled);
+  unlockDocument(document, LOCK_EXCLUSIVE);
+  return error;
+}
+
+DLL_EXPORT ReturnCode tixiSetThreadSafe(TixiDocumentHandle handle, int enabled)
+{
+  TixiDocument *document = getDocument(handle);
+
+  if (!document) {
+    printMsg(MESSAGETYPE_ERROR, "Error: Invalid document handle.\n");
+    return INVALID_HANDLE;
+  }
 
+  if (!enabled) {
+    disableThreadSafety(document);
     return SUCCESS;
+  }
+
+  if (enableThreadSafety(document) != SUCESS) {
+    printMsg(MESSAGETYPE_ERROR, "Error: Could not enable thread safe mode.\n");
+    return FAILED;
+  }
+  return SUCCESS;
 }
 
 ReturnCode tixiGetArrayElementCountImpl (const TixiDocumentHandle handle, const char *arrayPath,
                                                     const char *elementType, int *elements);
 
-DLL_EXPORT ReturnCode tixiGetArrayDimensions (const TixiDocumentHandle handle,
+static ReturnCode tixiGetArrayDimensionsImpl(const TixiDocumentHandle handle,
                                               const char *arrayPath, int *dimensions)
 {
 
@@ -2208,10 +2955,22 @@ DLL_EXPORT ReturnCode tixiGetArrayDimensions (const TixiDocumentHandle handle,
   return tixiGetArrayElementCountImpl(handle, arrayPath, "vector", dimensions);
 }
 
+DLL_EXPORT ReturnCode tixiGetArrayDimensions (const TixiDocumentHandle handle,
+                                              const char *arrayPath, int *dimensions)
+{
+  TixiDocument* document = getDocument(handle);
+  ReturnCode error;
+
+  lockDocument(document, LOCK_SHARED);
+  error = tixiGetArrayDimensionsImpl(handle, arrayPath, dimensions);
+  unlockDocument(document, LOCK_SHARED);
+  return error;
+}
+
 ReturnCode tixiGetArrayElementNamesImpl (const TixiDocumentHandle handle, const char *arrayPath,
                                          const char * elementType, char **elementNames);
 
-DLL_EXPORT ReturnCode tixiGetArrayDimensionNames (const TixiDocumentHandle handle,
+static ReturnCode tixiGetArrayDimensionNamesImpl(const TixiDocumentHandle handle,
                                                   const char *arrayPath,
                                                   char **dimensionNames)
 {
@@ -2219,8 +2978,21 @@ DLL_EXPORT ReturnCode tixiGetArrayDimensionNames (const TixiDocumentHandle handl
   return tixiGetArrayElementNamesImpl(handle, arrayPath, "vector", dimensionNames);
 }
 
-
-DLL_EXPORT ReturnCode tixiGetArrayDimensionSizes (const TixiDocumentHandle handle, const char *arrayPath,
+DLL_EXPORT ReturnCode tixiGetArrayDimensionNames (const TixiDocumentHandle handle,
+                                                  const char *arrayPath,
+                                                  char **dimensionNames)
+{
+  TixiDocument* document = getDocument(handle);
+  ReturnCode error;
+
+  lockDocument(document, LOCK_SHARED);
+  error = tixiGetArrayDimensionNamesImpl(handle, arrayPath, dimensionNames);
+  unlockDocument(document, LOCK_SHARED);
+  return error;
+}
+
+
+static ReturnCode tixiGetArrayDimensionSizesImpl(const TixiDocumentHandle handle, const char *arrayPath,
                                                   int *sizes, int *arraySizes)
 {
   TixiDocument *document = getDocument(handle);
@@ -2232,6 +3004,7 @@ DLL_EXPORT ReturnCode tixiGetArrayDimensionSizes (const TixiDocumentHandle handl
   char *tmpContent = NULL;
   char *tmpContCpy = NULL;
   char *token = NULL;
+  char *tokenPosition = NULL;
   int dimensions = 0;
   int dim = 0;
 
@@ -2247,7 +3020,7 @@ DLL_EXPORT ReturnCode tixiGetArrayDimensionSizes (const TixiDocumentHandle handl
   strcpy(xpathSubElementsName, arrayPath);
   strcat(xpathSubElementsName, suffix);    /* meaning: find all vector sub elements */
 
-  xpathObject = xmlXPathEvalExpression((xmlChar *) xpathSubElementsName, document->xpathContext);
+  xpathObject = XPathEvaluateCompiled(document, xpathSubElementsName, strlen(xpathSubElementsName));
 
   if (!xpathObject) {
     printMsg(MESSAGETYPE_ERROR, "Error: unable to evaluate xpath expression \"%s\"\n", xpathSubElementsName);
@@ -2291,10 +3064,10 @@ DLL_EXPORT ReturnCode tixiGetArrayDimensionSizes (const TixiDocumentHandle handl
     xmlFree(tmpContent);
     /* tokenize string into distinct elements to count */
     sizes[dim] = 0;    /* reset before increasing for each token */
-    token = strtok(tmpContCpy, VECTOR_SEPARATOR);
+    token = string_tokenize(tmpContCpy, VECTOR_SEPARATOR, &tokenPosition);
     while (token != NULL) {
       sizes[dim] ++;  /* count no. of values in dimension */
-      token = strtok(0, VECTOR_SEPARATOR);
+      token = string_tokenize(0, VECTOR_SEPARATOR, &tokenPosition);
     }
     free(tmpContCpy);
     *arraySizes *= sizes[dim];    /* calculate product */
@@ -2304,8 +3077,20 @@ DLL_EXPORT ReturnCode tixiGetArrayDimensionSizes (const TixiDocumentHandle handl
   return SUCCESS;
 }
 
+DLL_EXPORT ReturnCode tixiGetArrayDimensionSizes (const TixiDocumentHandle handle, const char *arrayPath,
+                                                  int *sizes, int *arraySizes)
+{
+  TixiDocument* document = getDocument(handle);
+  ReturnCode error;
 
-DLL_EXPORT ReturnCode tixiGetArrayDimensionValues (const TixiDocumentHandle handle, const char *arrayPath,
+  lockDocument(document, LOCK_SHARED);
+  error = tixiGetArrayDimensionSizesImpl(handle, arrayPath, sizes, arraySizes);
+  unlockDocument(document, LOCK_SHARED);
+  return error;
+}
+
+
+static ReturnCode tixiGetArrayDimensionValuesImpl(const TixiDocumentHandle handle, const char *arrayPath,
                                                    const int dimension, double *dimensionValues)
 {
   TixiDocument *document = getDocument(handle);
@@ -2317,6 +3102,7 @@ DLL_EXPORT ReturnCode tixiGetArrayDimensionValues (const TixiDocumentHandle hand
   char *tmpContent = NULL;    /* reference copy */
   char *tmpContCpy = NULL;    /* tokenizer */
   char *token = NULL;
+  char *tokenPosition = NULL;
   int dimensions = 0;
   int count = 0;
 
@@ -2332,7 +3118,7 @@ DLL_EXPORT ReturnCode tixiGetArrayDimensionValues (const TixiDocumentHandle hand
   strcpy(xpathSubElementsName, arrayPath);
   strcat(xpathSubElementsName, suffix);    /* meaning: find all vector sub elements */
 
-  xpathObject = xmlXPathEvalExpression((xmlChar *) xpathSubElementsName, document->xpathContext);
+  xpathObject = XPathEvaluateCompiled(document, xpathSubElementsName, strlen(xpathSubElementsName));
 
   if (!xpathObject) {
     printMsg(MESSAGETYPE_ERROR, "Error: unable to evaluate xpath expression \"%s\"\n", xpathSubElementsName);
@@ -2374,10 +3160,10 @@ DLL_EXPORT ReturnCode tixiGetArrayDimensionValues (const TixiDocumentHandle hand
     tmpContCpy[0] = '\0';
   }
   /* tokenize string into distinct elements to count */
-  token = strtok(tmpContCpy, VECTOR_SEPARATOR);
+  token = string_tokenize(tmpContCpy, VECTOR_SEPARATOR, &tokenPosition);
   while (token != NULL) {
     dimensionValues[count ++]= atof(token);
-    token = strtok(0, VECTOR_SEPARATOR);
+    token = string_tokenize(0, VECTOR_SEPARATOR, &tokenPosition);
   }
   free(tmpContCpy);
   xmlFree(tmpContent);
@@ -2388,18 +3174,42 @@ DLL_EXPORT ReturnCode tixiGetArrayDimensionValues (const TixiDocumentHandle hand
   return SUCCESS;
 }
 
+DLL_EXPORT ReturnCode tixiGetArrayDimensionValues (const TixiDocumentHandle handle, const char *arrayPath,
+                                                   const int dimension, double *dimensionValues)
+{
+  TixiDocument* document = getDocument(handle);
+  ReturnCode error;
+
+  lockDocument(document, LOCK_SHARED);
+  error = tixiGetArrayDimensionValuesImpl(handle, arrayPath, dimension, dimensionValues);
+  unlockDocument(document, LOCK_SHARED);
+  return error;
+}
+
 
 
 
-DLL_EXPORT ReturnCode tixiGetArrayParameters (const TixiDocumentHandle handle,
+static ReturnCode tixiGetArrayParametersImpl(const TixiDocumentHandle handle,
                                               const char *arrayPath, int *parameters)
 {
   printMsg(MESSAGETYPE_WARNING, "DEPRECATED: tixiGetArrayParameters is an outdated CPACS specific function. It will be removed in the next major release");
   return tixiGetArrayElementCountImpl(handle, arrayPath, "array", parameters);
 }
 
+DLL_EXPORT ReturnCode tixiGetArrayParameters (const TixiDocumentHandle handle,
+                                              const char *arrayPath, int *parameters)
+{
+  TixiDocument* document = getDocument(handle);
+  ReturnCode error;
+
+  lockDocument(document, LOCK_SHARED);
+  error = tixiGetArrayParametersImpl(handle, arrayPath, parameters);
+  unlockDocument(document, LOCK_SHARED);
+  return error;
+}
+
 
-DLL_EXPORT ReturnCode tixiGetArrayParameterNames (const TixiDocumentHandle handle,
+static ReturnCode tixiGetArrayParameterNamesImpl(const TixiDocumentHandle handle,
                                                   const char *arrayPath,
                                                   char **parameterNames)
 {
@@ -2407,8 +3217,21 @@ DLL_EXPORT ReturnCode tixiGetArrayParameterNames (const TixiDocumentHandle handl
   return tixiGetArrayElementNamesImpl(handle, arrayPath, "array", parameterNames);
 }
 
+DLL_EXPORT ReturnCode tixiGetArrayParameterNames (const TixiDocumentHandle handle,
+                                                  const char *arrayPath,
+                                                  char **parameterNames)
+{
+  TixiDocument* document = getDocument(handle);
+  ReturnCode error;
+
+  lockDocument(document, LOCK_SHARED);
+  error = tixiGetArrayParameterNamesImpl(handle, arrayPath, parameterNames);
+  unlockDocument(document, LOCK_SHARED);
+  return error;
+}
+
 
-DLL_EXPORT ReturnCode tixiGetArray (const TixiDocumentHandle handle, const char *arrayPath,
+static ReturnCode tixiGetArrayImpl(const TixiDocumentHandle handle, const char *arrayPath,
                                     const char *elementName, int arraySize, double **pValues)
 {
   TixiDocument *document = getDocument(handle);
@@ -2420,6 +3243,7 @@ DLL_EXPORT ReturnCode tixiGetArray (const TixiDocumentHandle handle, const char
   char *tmpContent = NULL;    /* reference copy */
   char *tmpContCpy = NULL;    /* tokenizer */
   char *token = NULL;
+  char *tokenPosition = NULL;
   double * tmpArray = NULL;
   int count = 0;
 
@@ -2436,7 +3260,7 @@ DLL_EXPORT ReturnCode tixiGetArray (const TixiDocumentHandle handle, const char
   strcat(xpathSubElementsName, "/");
   strcat(xpathSubElementsName, elementName);
 
-  xpathObject = xmlXPathEvalExpression((xmlChar *) xpathSubElementsName, document->xpathContext);
+  xpathObject = XPathEvaluateCompiled(document, xpathSubElementsName, strlen(xpathSubElementsName));
 
   if (!xpathObject) {
     printMsg(MESSAGETYPE_ERROR, "Error: unable to evaluate xpath expression \"%s\"\n", xpathSubElementsName);
@@ -2503,13 +3327,20 @@ DLL_EXPORT ReturnCode tixiGetArray (const TixiDocumentHandle handle, const char
   }
 
   /* allocate memory for array */
-  tmpArray = (double *) malloc(sizeof(double) * arraySize);
+  tmpArray = (double *) allocateFromMemoryArena(document, sizeof(double) * arraySize);
+  if (!tmpArray) {
+    free(tmpContCpy);
+    free(xpathSubElementsName);
+    xmlFree(attributeName);
+    xmlXPathFreeObject(xpathObject);
+    return FAILED;
+  }
 
   /* tokenize string into distinct elements to separate values */
-  token = strtok(tmpContCpy, VECTOR_SEPARATOR);
+  token = string_tokenize(tmpContCpy, VECTOR_SEPARATOR, &tokenPosition);
   while (token != NULL && count < arraySize) {
     tmpArray[count ++] = atof(token);
-    token = strtok(0, VECTOR_SEPARATOR);
+    token = string_tokenize(0, VECTOR_SEPARATOR, &tokenPosition);
   }
   free(tmpContCpy);
 
@@ -2523,15 +3354,25 @@ DLL_EXPORT ReturnCode tixiGetArray (const TixiDocumentHandle handle, const char
     printMsg(MESSAGETYPE_ERROR,
              "Error: the number of elements of array \"%s\" does not match the specified size of %d (should be %d)!\n",
              elementName, arraySize, count);
-    free(tmpArray);
     return NON_MATCHING_SIZE;
   }
 
-  addToMemoryList(document, tmpArray);
   *pValues = tmpArray;
   return SUCCESS;
 }
 
+DLL_EXPORT ReturnCode tixiGetArray (const TixiDocumentHandle handle, const char *arrayPath,
+                                    const char *elementName, int arraySize, double **pValues)
+{
+  TixiDocument* document = getDocument(handle);
+  ReturnCode error;
+
+  lockDocument(document, LOCK_SHARED);
+  error = tixiGetArrayImpl(handle, arrayPath, elementName, arraySize, pValues);
+  unlockDocument(document, LOCK_SHARED);
+  return error;
+}
+
 
 DLL_EXPORT double tixiGetArrayValue(const double *array, const int *dimSize, const int *dimPos, const int dims)
 {
@@ -2581,7 +3422,7 @@ ReturnCode tixiGetArrayElementCountImpl (const TixiDocumentHandle handle, const
   strcat(xpathSubElementsName, elementType);
   strcat(xpathSubElementsName, "\"]");
 
-  xpathObject = xmlXPathEvalExpression((xmlChar *) xpathSubElementsName, document->xpathContext);
+  xpathObject = XPathEvaluateCompiled(document, xpathSubElementsName, strlen(xpathSubElementsName));
 
   if (!xpathObject) {
     printMsg(MESSAGETYPE_ERROR, "Error: unable to evaluate xpath expression \"%s\"\n", xpathSubElementsName);
@@ -2609,7 +3450,13 @@ ReturnCode tixiGetArrayElementCountImpl (const TixiDocumentHandle handle, const
 DLL_EXPORT ReturnCode tixiGetArrayElementCount (const TixiDocumentHandle handle, const char *arrayPath,
                                                 const char *elementType, int *elements)
 {
-    return tixiGetArrayElementCountImpl(handle, arrayPath, elementType, elements);
+  TixiDocument* document = getDocument(handle);
+  ReturnCode error;
+
+  lockDocument(document, LOCK_SHARED);
+  error = tixiGetArrayElementCountImpl(handle, arrayPath, elementType, elements);
+  unlockDocument(document, LOCK_SHARED);
+  return error;
 }
 
 
@@ -2638,7 +3485,7 @@ ReturnCode tixiGetArrayElementNamesImpl (const TixiDocumentHandle handle, const
   strcat(xpathSubElementsName, elementType);
   strcat(xpathSubElementsName, "\"]");
 
-  xpathObject = xmlXPathEvalExpression((xmlChar *) xpathSubElementsName, document->xpathContext);
+  xpathObject = XPathEvaluateCompiled(document, xpathSubElementsName, strlen(xpathSubElementsName));
 
   if (!xpathObject) {
     printMsg(MESSAGETYPE_ERROR, "Error: unable to evaluate xpath expression \"%s\"\n", xpathSubElementsName);
@@ -2674,46 +3521,228 @@ ReturnCode tixiGetArrayElementNamesImpl (const TixiDocumentHandle handle, const
 DLL_EXPORT ReturnCode tixiGetArrayElementNames (const TixiDocumentHandle handle, const char *arrayPath,
                                                 const char * elementType, char **elementNames)
 {
-    return tixiGetArrayElementNamesImpl(handle, arrayPath, elementType, elementNames);
+  TixiDocument* document = getDocument(handle);
+  ReturnCode error;
+
+  lockDocument(document, LOCK_SHARED);
+  error = tixiGetArrayElementNamesImpl(handle, arrayPath, elementType, elementNames);
+  unlockDocument(document, LOCK_SHARED);
+  return error;
+}
+
+
+/* Parses up to nValues numbers of a vector text directly into values. Empty
+ * elements are skipped, count returns the number of parsed values. */
+static ReturnCode parseFloatVector(const char *text, double *values, int nValues, int *count)
+{
+  const char *position = text;
+
+  *count = 0;
+  while (*count < nValues) {
+    const char *end = NULL;
+
+    position += strspn(position, VECTOR_SEPARATOR);
+    if (*position == '\0') {
+      break;
+    }
+
+    end = parseDouble(position, &values[*count]);
+    if (end != position) {
+      while (isspace((unsigned char) *end)) {
+        end++;
+      }
+    }
+    if (end == position || (*end != '\0' && !strchr(VECTOR_SEPARATOR, *end))) {
+      int length = (int) strcspn(position, VECTOR_SEPARATOR);
+
+      while (length > 0 && isspace((unsigned char) position[length - 1])) {
+        length--;
+      }
+      printMsg(MESSAGETYPE_ERROR, "Error: tixiGetFloatVector cannot parse the %i-th element \"%.*s\" as a float.\n",
+               *count + 1, length, position);
+      return NO_NUMBER;
+    }
+
+    (*count)++;
+    position = end;
+  }
+  return SUCCESS;
+}
+
+/* Reads up to nValues numbers of a vector element with the given text into values */
+static ReturnCode readVector(xmlNodePtr element, const char *text, double *values, int nValues, int *count)
+{
+  ReturnCode error = SUCCESS;
+
+  if (getVectorEncoding(element) == VECTOR_ENCODING_TEXT) {
+    return parseFloatVector(text, values, nValues, count);
+  }
+
+  error = countVector(element, text, count);
+  if (error != SUCCESS) {
+    return error;
+  }
+
+  if (*count > nValues) {
+    *count = nValues;
+  }
+  decodeDoublesBase64(text, values, *count);
+  return SUCCESS;
 }
 
+static ReturnCode tixiGetFloatVectorImpl(const TixiDocumentHandle handle, const char *vectorPath,
+                                         double **vectorArray, const int eNumber)
+{
+  TixiDocument *document = getDocument(handle);
+  xmlNodePtr element = NULL;
+  xmlChar *allocated = NULL;
+  ReturnCode error = SUCCESS;
+  int count = 0;
+
+  if (!document) {
+    printMsg(MESSAGETYPE_ERROR, "Error: Invalid document handle.\n");
+    return INVALID_HANDLE;
+  }
+
+  error = checkElement(document, vectorPath, &element);
+  if (error != SUCCESS) {
+    return error;
+  }
+
+  *vectorArray = (double *) allocateFromMemoryArena(document, eNumber * sizeof(double));
+  if (!*vectorArray) {
+    return FAILED;
+  }
+
+  /* the numbers are parsed in place from the text node */
+  error = readVector(element, getElementText(document, element, &allocated), *vectorArray, eNumber, &count);
+  xmlFree(allocated);
+
+  if (error == SUCCESS && count < eNumber) {
+    error = INDEX_OUT_OF_RANGE;
+  }
+  return error;
+}
 
 DLL_EXPORT ReturnCode tixiGetFloatVector (const TixiDocumentHandle handle, const char *vectorPath,
                                           double **vectorArray, const int eNumber)
 {
+  TixiDocument* document = getDocument(handle);
   ReturnCode error;
-  char *tmpString = NULL;
+
+  lockDocument(document, LOCK_SHARED);
+  error = tixiGetFloatVectorImpl(handle, vectorPath, vectorArray, eNumber);
+  unlockDocument(document, LOCK_SHARED);
+  return error;
+}
+
+static ReturnCode tixiGetFloatVectorAllocImpl(const TixiDocumentHandle handle, const char *vectorPath,
+                                              int *nElements, double **vectorArray)
+{
+  TixiDocument *document = getDocument(handle);
+  xmlNodePtr element = NULL;
+  xmlChar *allocated = NULL;
+  const char *text = NULL;
+  ReturnCode error = SUCCESS;
   int count = 0;
-  char *token = NULL;
-  TixiDocument *document = NULL;
 
-  error = tixiGetTextElement(handle, vectorPath, &tmpString); /* check if element is of right type */
+  *nElements = 0;
+
+  if (!document) {
+    printMsg(MESSAGETYPE_ERROR, "Error: Invalid document handle.\n");
+    return INVALID_HANDLE;
+  }
+
+  error = checkElement(document, vectorPath, &element);
   if (error != SUCCESS) {
     return error;
   }
 
-  *vectorArray = (double *) malloc(eNumber * sizeof(double));
-  document = getDocument(handle);
-  addToMemoryList(document, *vectorArray);
+  /* the element is looked up once, its text is sized and parsed in place */
+  text = getElementText(document, element, &allocated);
+  error = countVector(element, text, &count);
+  if (error != SUCCESS) {
+    xmlFree(allocated);
+    return error;
+  }
 
-  token = strtok(tmpString, VECTOR_SEPARATOR);    /* modifies tmpString */
-  while(token != NULL) {  /* as long as there are tokens */
-    if (count == eNumber) {
-      return SUCCESS;
-    }
+  *vectorArray = (double *) allocateFromMemoryArena(document, count * sizeof(double));
+  if (!*vectorArray) {
+    xmlFree(allocated);
+    return FAILED;
+  }
 
-    trim_trailing_whitespace(token);
-    if (isNumeric(token)) {
-        (*vectorArray)[count ++] = atof(token);    /* starting with zero */
-    }
-    else {
-        printMsg(MESSAGETYPE_ERROR, "Error: tixiGetFloatVector cannot parse the %i-th element \"%s\" as a float.\n", count+1, token);
-        return NO_NUMBER;
+  error = readVector(element, text, *vectorArray, count, nElements);
+  xmlFree(allocated);
+  return error;
+}
+
+DLL_EXPORT ReturnCode tixiGetFloatVectorAlloc (const TixiDocumentHandle handle, const char *vectorPath,
+                                               int *nElements, double **vectorArray)
+{
+  TixiDocument* document = getDocument(handle);
+  ReturnCode error;
+
+  lockDocument(document, LOCK_SHARED);
+  error = tixiGetFloatVectorAllocImpl(handle, vectorPath, nElements, vectorArray);
+  unlockDocument(document, LOCK_SHARED);
+  return error;
+}
+
+static ReturnCode tixiGetFloatVectorIntoImpl(const TixiDocumentHandle handle, const char *vectorPath,
+                                             double *vectorArray, int capacity, int *nElements)
+{
+  TixiDocument *document = getDocument(handle);
+  xmlNodePtr element = NULL;
+  xmlChar *allocated = NULL;
+  const char *text = NULL;
+  ReturnCode error = SUCCESS;
+  int count = 0;
+
+  if (!document) {
+    printMsg(MESSAGETYPE_ERROR, "Error: Invalid document handle.\n");
+    return INVALID_HANDLE;
+  }
+
+  if (capacity < 0 || (!vectorArray && capacity > 0)) {
+    printMsg(MESSAGETYPE_ERROR, "Error: Invalid buffer for the result.\n");
+    return FAILED;
+  }
+
+  error = checkElement(document, vectorPath, &element);
+  if (error != SUCCESS) {
+    return error;
+  }
+
+  /* the numbers are parsed straight into the buffer of the caller */
+  text = getElementText(document, element, &allocated);
+  error = readVector(element, text, vectorArray, capacity, &count);
+
+  /* the remaining elements are only counted */
+  if (error == SUCCESS && count == capacity) {
+    error = countVector(element, text, &count);
+    if (error == SUCCESS && count > capacity) {
+      error = INDEX_OUT_OF_RANGE;
     }
+  }
+  xmlFree(allocated);
 
-    token = strtok(0, VECTOR_SEPARATOR);
+  if (nElements) {
+    *nElements = count;
   }
-  return count < eNumber ? INDEX_OUT_OF_RANGE : SUCCESS;
+  return error;
+}
+
+DLL_EXPORT ReturnCode tixiGetFloatVectorInto (const TixiDocumentHandle handle, const char *vectorPath,
+                                              double *vectorArray, int capacity, int *nElements)
+{
+  TixiDocument* document = getDocument(handle);
+  ReturnCode error;
+
+  lockDocument(document, LOCK_SHARED);
+  error = tixiGetFloatVectorIntoImpl(handle, vectorPath, vectorArray, capacity, nElements);
+  unlockDocument(document, LOCK_SHARED);
+  return error;
 }
 
 
@@ -2758,7 +3787,7 @@ DLL_EXPORT ReturnCode tixiCheckDocumentHandle(const TixiDocumentHandle handle)
   }
 }
 
-DLL_EXPORT ReturnCode tixiCheckElement(const TixiDocumentHandle handle, const char *elementPath)
+static ReturnCode tixiCheckElementImpl(const TixiDocumentHandle handle, const char *elementPath)
 {
 
   TixiDocument *document = getDocument(handle);
@@ -2772,15 +3801,26 @@ DLL_EXPORT ReturnCode tixiCheckElement(const TixiDocumentHandle handle, const ch
     return INVALID_HANDLE;
   }
 
-  error = checkExistence(document->xpathContext, elementPath, &xpathObject);
+  error = checkExistence(document, elementPath, &xpathObject);
   xmlXPathFreeObject(xpathObject);
 
   return error;
 }
 
+DLL_EXPORT ReturnCode tixiCheckElement(const TixiDocumentHandle handle, const char *elementPath)
+{
+  TixiDocument* document = getDocument(handle);
+  ReturnCode error;
+
+  lockDocument(document, LOCK_SHARED);
+  error = tixiCheckElementImpl(handle, elementPath);
+  unlockDocument(document, LOCK_SHARED);
+  return error;
+}
 
 
-DLL_EXPORT ReturnCode tixiCheckAttribute(TixiDocumentHandle handle, const char *elementPath, const char *attributeName)
+
+static ReturnCode tixiCheckAttributeImpl(TixiDocumentHandle handle, const char *elementPath, const char *attributeName)
 {
   TixiDocument *document = getDocument(handle);
 
@@ -2793,7 +3833,7 @@ DLL_EXPORT ReturnCode tixiCheckAttribute(TixiDocumentHandle handle, const char *
     return INVALID_HANDLE;
   }
 
-  error = checkElement(document->xpathContext, elementPath, &element);
+  error = checkElement(document, elementPath, &element);
   if (!error) {
     char* name = NULL;
     char* prefix = NULL;
@@ -2825,7 +3865,18 @@ DLL_EXPORT ReturnCode tixiCheckAttribute(TixiDocumentHandle handle, const char *
   }
 }
 
-DLL_EXPORT ReturnCode tixiXSLTransformationToString(TixiDocumentHandle handle, const char *xslFilename, char **resultText)
+DLL_EXPORT ReturnCode tixiCheckAttribute(TixiDocumentHandle handle, const char *elementPath, const char *attributeName)
+{
+  TixiDocument* document = getDocument(handle);
+  ReturnCode error;
+
+  lockDocument(document, LOCK_SHARED);
+  error = tixiCheckAttributeImpl(handle, elementPath, attributeName);
+  unlockDocument(document, LOCK_SHARED);
+  return error;
+}
+
+static ReturnCode tixiXSLTransformationToStringImpl(TixiDocumentHandle handle, const char *xslFilename, char **resultText)
 {
   TixiDocument *document = getDocument(handle);
   int error = SUCCESS;
@@ -2833,10 +3884,9 @@ DLL_EXPORT ReturnCode tixiXSLTransformationToString(TixiDocumentHandle handle, c
 
   textPtr = xsltTransformToString(document->docPtr, xslFilename);
   if ( textPtr ) {
-    *resultText = (char *) malloc((strlen(textPtr) + 1) * sizeof(char));
-    strcpy(*resultText, textPtr);
+    *resultText = copyToMemoryArena(document, textPtr);
     xmlFree(textPtr);
-    error = addToMemoryList(document, (void *) *resultText);
+    error = *resultText ? SUCCESS : FAILED;
   } else {
     *resultText = NULL;
     error = FAILED;
@@ -2845,31 +3895,48 @@ DLL_EXPORT ReturnCode tixiXSLTransformationToString(TixiDocumentHandle handle, c
   return error;
 }
 
-DLL_EXPORT ReturnCode tixiXSLTransformationToFile(TixiDocumentHandle handle, const char *xslFilename, const char *resultFilename)
+DLL_EXPORT ReturnCode tixiXSLTransformationToString(TixiDocumentHandle handle, const char *xslFilename, char **resultText)
+{
+  TixiDocument* document = getDocument(handle);
+  ReturnCode error;
+
+  lockDocument(document, LOCK_SHARED);
+  error = tixiXSLTransformationToStringImpl(handle, xslFilename, resultText);
+  unlockDocument(document, LOCK_SHARED);
+  return error;
+}
+
+static ReturnCode tixiXSLTransformationToFileImpl(TixiDocumentHandle handle, const char *xslFilename, const char *resultFilename)
 {
   TixiDocument *document = getDocument(handle);
 
   return xsltTransformToFile(document->docPtr, xslFilename, resultFilename);
 }
 
+DLL_EXPORT ReturnCode tixiXSLTransformationToFile(TixiDocumentHandle handle, const char *xslFilename, const char *resultFilename)
+{
+  TixiDocument* document = getDocument(handle);
+  ReturnCode error;
+
+  lockDocument(document, LOCK_SHARED);
+  error = tixiXSLTransformationToFileImpl(handle, xslFilename, resultFilename);
+  unlockDocument(document, LOCK_SHARED);
+  return error;
+}
+
 
 /** -----------
  * UID Functions
  *--------------*/
 
 
-DLL_EXPORT ReturnCode tixiUIDCheckDuplicates(TixiDocumentHandle handle)
+static ReturnCode tixiUIDCheckDuplicatesImpl(TixiDocumentHandle handle)
 {
   TixiDocument *document = getDocument(handle);
 
   if(!document)
     return INVALID_HANDLE;
 
-  // if the UID list is already set, delete and rebuild it.
-  if(document->uidListHead) {
-    uid_clearUIDList(document);
-  }
-
   if (uid_readDocumentUIDs(document) != SUCCESS) {
     return FAILED;
   }
@@ -2881,17 +3948,23 @@ DLL_EXPORT ReturnCode tixiUIDCheckDuplicates(TixiDocumentHandle handle)
   return SUCCESS;
 }
 
+DLL_EXPORT ReturnCode tixiUIDCheckDuplicates(TixiDocumentHandle handle)
+{
+  TixiDocument* document = getDocument(handle);
+  ReturnCode error;
+
+  lockDocument(document, LOCK_EXCLUSIVE);
+  error = tixiUIDCheckDuplicatesImpl(handle);
+  unlockDocument(document, LOCK_EXCLUSIVE);
+  return error;
+}
+
 
 
-DLL_EXPORT ReturnCode tixiUIDCheckLinks(TixiDocumentHandle handle)
+static ReturnCode tixiUIDCheckLinksImpl(TixiDocumentHandle handle)
 {
   TixiDocument *document = getDocument(handle);
 
-  // if the UID list is already set, delete and rebuild it.
-  if(document->uidListHead) {
-    uid_clearUIDList(document);
-  }
-
   if (uid_readDocumentUIDs(document) != SUCCESS) {
     return FAILED;
   }
@@ -2903,74 +3976,502 @@ DLL_EXPORT ReturnCode tixiUIDCheckLinks(TixiDocumentHandle handle)
   return SUCCESS;
 }
 
-
-DLL_EXPORT ReturnCode tixiUIDGetXPath(TixiDocumentHandle handle, const char *uID, char **xPath)
+DLL_EXPORT ReturnCode tixiUIDCheckLinks(TixiDocumentHandle handle)
 {
+  TixiDocument* document = getDocument(handle);
   ReturnCode error;
-  TixiDocument *document = getDocument(handle);
-  char *textPtr = NULL;
-
-  error = tixiUIDCheckDuplicates(handle);
-  if (error != SUCCESS) {
-    printMsg(MESSAGETYPE_WARNING, "Warning: There are duplicated UID's in the data set!");
-  }
 
-  textPtr = (char *) uid_getXpath(document, uID);
-  if ( textPtr ) {
-    *xPath = (char *) malloc((strlen(textPtr) + 1) * sizeof(char));
-    strcpy(*xPath, textPtr);
-    xmlFree(textPtr);
-  }
-  else {
-    *xPath = (char *) malloc(sizeof(char));
-    strcpy(*xPath, "");
-  }
-  error = addToMemoryList(document, (void *) *xPath);
+  lockDocument(document, LOCK_EXCLUSIVE);
+  error = tixiUIDCheckLinksImpl(handle);
+  unlockDocument(document, LOCK_EXCLUSIVE);
   return error;
 }
 
 
-DLL_EXPORT ReturnCode tixiUIDCheckExists(TixiDocumentHandle handle, const char *uID)
+static ReturnCode tixiUIDGetBrokenLinksCountImpl(TixiDocumentHandle handle, int* nBrokenLinks)
 {
   TixiDocument *document = getDocument(handle);
-  ReturnCode error = FAILED;
 
-  if(!document)
+  if (!document) {
     return INVALID_HANDLE;
+  }
 
-  // if the UID list is already set, delete and rebuild it.
-  if(document->uidListHead) {
-    uid_clearUIDList(document);
+  if (!nBrokenLinks) {
+    printMsg(MESSAGETYPE_ERROR, "Error: Null Pointer in tixiUIDGetBrokenLinksCount.\n");
+    return FAILED;
   }
 
   if (uid_readDocumentUIDs(document) != SUCCESS) {
     return FAILED;
   }
 
-  if (uid_checkExists(document, uID) == 0) {
-    error = SUCCESS;
-  } else {
-    error = UID_DONT_EXISTS;
-  }
+  return uid_getBrokenLinks(document, NULL, 0, nBrokenLinks) == SUCCESS ? SUCCESS : FAILED;
+}
 
+DLL_EXPORT ReturnCode tixiUIDGetBrokenLinksCount(TixiDocumentHandle handle, int* nBrokenLinks)
+{
+  TixiDocument* document = getDocument(handle);
+  ReturnCode error;
+
+  lockDocument(document, LOCK_EXCLUSIVE);
+  error = tixiUIDGetBrokenLinksCountImpl(handle, nBrokenLinks);
+  unlockDocument(document, LOCK_EXCLUSIVE);
+  return error;
+}
+
+
+static ReturnCode tixiUIDGetBrokenLinksImpl(TixiDocumentHandle handle, char** linkPaths)
+{
+  TixiDocument *document = getDocument(handle);
+  int nBrokenLinks = 0;
+
+  if (!document) {
+    return INVALID_HANDLE;
+  }
+
+  if (!linkPaths) {
+    printMsg(MESSAGETYPE_ERROR, "Error: Null Pointer in tixiUIDGetBrokenLinks.\n");
+    return FAILED;
+  }
+
+  if (uid_readDocumentUIDs(document) != SUCCESS) {
+    return FAILED;
+  }
+
+  /* the array has been sized by a prior call to tixiUIDGetBrokenLinksCount */
+  if (uid_getBrokenLinks(document, linkPaths, INT_MAX, &nBrokenLinks) != SUCCESS) {
+    return FAILED;
+  }
+  return SUCCESS;
+}
+
+DLL_EXPORT ReturnCode tixiUIDGetBrokenLinks(TixiDocumentHandle handle, char** linkPaths)
+{
+  TixiDocument* document = getDocument(handle);
+  ReturnCode error;
+
+  lockDocument(document, LOCK_EXCLUSIVE);
+  error = tixiUIDGetBrokenLinksImpl(handle, linkPaths);
+  unlockDocument(document, LOCK_EXCLUSIVE);
+  return error;
+}
+
+
+/* Builds the uID index for functions reading the document. Reading functions hold the
+ * document lock shared, hence building the index is guarded by the mutex of the document.
+ * Once built, the index is not modified until the document lock is held exclusively. */
+static ReturnCode readDocumentUIDsShared(TixiDocument *document)
+{
+  ReturnCode error = SUCCESS;
+
+  if (document->threadSafety) {
+    tixiMutexLock(&document->threadSafety->mutex);
+  }
+  if (uid_readDocumentUIDs(document) != SUCCESS) {
+    error = FAILED;
+  }
+  if (document->threadSafety) {
+    tixiMutexUnlock(&document->threadSafety->mutex);
+  }
+  return error;
+}
+
+static ReturnCode getReferencingXPaths(TixiDocumentHandle handle, const char* uID, char** xPaths, int* count)
+{
+  TixiDocument* document = getDocument(handle);
+
+  if (!document) {
+    printMsg(MESSAGETYPE_ERROR, "Error: Invalid document handle.\n");
+    return INVALID_HANDLE;
+  }
+
+  if (!uID) {
+    printMsg(MESSAGETYPE_ERROR, "Error: No uID specified.\n");
+    return FAILED;
+  }
+
+  if (readDocumentUIDsShared(document) != SUCCESS) {
+    return FAILED;
+  }
+
+  /* the array has been sized by a prior call to tixiUIDGetReferencingXPathsCount */
+  if (uid_getReferencingXPaths(document, uID, xPaths, INT_MAX, count) != SUCCESS) {
+    return FAILED;
+  }
+  return SUCCESS;
+}
+
+DLL_EXPORT ReturnCode tixiUIDGetReferencingXPathsCount(TixiDocumentHandle handle, const char* uID, int* count)
+{
+  TixiDocument* document = getDocument(handle);
+  ReturnCode error;
+
+  if (!count) {
+    printMsg(MESSAGETYPE_ERROR, "Error: Null Pointer in tixiUIDGetReferencingXPathsCount.\n");
+    return FAILED;
+  }
+
+  lockDocument(document, LOCK_SHARED);
+  error = getReferencingXPaths(handle, uID, NULL, count);
+  unlockDocument(document, LOCK_SHARED);
+  return error;
+}
+
+DLL_EXPORT ReturnCode tixiUIDGetReferencingXPaths(TixiDocumentHandle handle, const char* uID, char** xPaths)
+{
+  TixiDocument* document = getDocument(handle);
+  ReturnCode error;
+  int count = 0;
+
+  if (!xPaths) {
+    printMsg(MESSAGETYPE_ERROR, "Error: Null Pointer in tixiUIDGetReferencingXPaths.\n");
+    return FAILED;
+  }
+
+  lockDocument(document, LOCK_SHARED);
+  error = getReferencingXPaths(handle, uID, xPaths, &count);
+  unlockDocument(document, LOCK_SHARED);
+  return error;
+}
+
+
+static ReturnCode tixiUIDGetXPathImpl(TixiDocumentHandle handle, const char *uID, char **xPath)
+{
+  ReturnCode error;
+  TixiDocument *document = getDocument(handle);
+  char *textPtr = NULL;
+
+  if (!document) {
+    return INVALID_HANDLE;
+  }
+
+  if (readDocumentUIDsShared(document) != SUCCESS) {
+    return FAILED;
+  }
+
+  /* the index counts the duplicates, tixiUIDCheckDuplicates lists them */
+  if (document->uidDuplicates > 0) {
+    printMsg(MESSAGETYPE_WARNING, "Warning: There are duplicated UID's in the data set!");
+  }
+
+  textPtr = (char *) uid_getXpath(document, uID);
+  if ( textPtr ) {
+    *xPath = copyToMemoryArena(document, textPtr);
+    xmlFree(textPtr);
+  }
+  else {
+    *xPath = copyToMemoryArena(document, "");
+  }
+  error = *xPath ? SUCCESS : FAILED;
+  return error;
+}
+
+DLL_EXPORT ReturnCode tixiUIDGetXPath(TixiDocumentHandle handle, const char *uID, char **xPath)
+{
+  TixiDocument* document = getDocument(handle);
+  ReturnCode error;
+
+  lockDocument(document, LOCK_SHARED);
+  error = tixiUIDGetXPathImpl(handle, uID, xPath);
+  unlockDocument(document, LOCK_SHARED);
   return error;
 }
 
 
+static ReturnCode tixiUIDGetXPathsImpl(TixiDocumentHandle handle, const char **uIDs, int nUIDs, char **xPaths)
+{
+  TixiDocument *document = getDocument(handle);
+  int i;
+
+  if (!document) {
+    return INVALID_HANDLE;
+  }
+
+  if (nUIDs < 0 || (nUIDs > 0 && (!uIDs || !xPaths))) {
+    printMsg(MESSAGETYPE_ERROR, "Error: Null Pointer in tixiUIDGetXPaths.\n");
+    return FAILED;
+  }
+
+  /* builds the index, duplicates are checked only once for all uids */
+  if (readDocumentUIDsShared(document) != SUCCESS) {
+    return FAILED;
+  }
+  if (document->uidDuplicates > 0) {
+    printMsg(MESSAGETYPE_WARNING, "Warning: There are duplicated UID's in the data set!");
+  }
+
+  for (i = 0; i < nUIDs; ++i) {
+    char *textPtr = uIDs[i] ? uid_getXpath(document, uIDs[i]) : NULL;
+    xPaths[i] = copyToMemoryArena(document, textPtr ? textPtr : "");
+    xmlFree(textPtr);
+    if (!xPaths[i]) {
+      return FAILED;
+    }
+  }
+  return SUCCESS;
+}
+
+DLL_EXPORT ReturnCode tixiUIDGetXPaths(TixiDocumentHandle handle, const char **uIDs, int nUIDs, char **xPaths)
+{
+  TixiDocument* document = getDocument(handle);
+  ReturnCode error;
+
+  lockDocument(document, LOCK_SHARED);
+  error = tixiUIDGetXPathsImpl(handle, uIDs, nUIDs, xPaths);
+  unlockDocument(document, LOCK_SHARED);
+  return error;
+}
+
+
+static ReturnCode tixiUIDCheckExistsImpl(TixiDocumentHandle handle, const char *uID)
+{
+  TixiDocument *document = getDocument(handle);
+  ReturnCode error = FAILED;
+
+  if(!document)
+    return INVALID_HANDLE;
+
+  if (readDocumentUIDsShared(document) != SUCCESS) {
+    return FAILED;
+  }
+
+  if (uid_checkExists(document, uID) == 0) {
+    error = SUCCESS;
+  } else {
+    error = UID_DONT_EXISTS;
+  }
+
+  return error;
+}
+
+DLL_EXPORT ReturnCode tixiUIDCheckExists(TixiDocumentHandle handle, const char *uID)
+{
+  TixiDocument* document = getDocument(handle);
+  ReturnCode error;
+
+  lockDocument(document, LOCK_SHARED);
+  error = tixiUIDCheckExistsImpl(handle, uID);
+  unlockDocument(document, LOCK_SHARED);
+  return error;
+}
+
+
+static ReturnCode tixiUIDSetToXPathImpl(TixiDocumentHandle handle, const char *xPath, const char *uID)
+{
+  TixiDocument *document = getDocument(handle);
+  ReturnCode error;
+
+  if (!document) {
+    printMsg(MESSAGETYPE_ERROR, "Error: Invalid document handle.\n");
+    return INVALID_HANDLE;
+  }
+
+  /* with enforced unique uIDs, the document is known to be free of duplicates
+   * and the new uID is checked against the index when it is written */
+  if (!document->enforceUniqueUIDs) {
+    error = tixiUIDCheckDuplicates(handle);
+    if (error != SUCCESS) {
+      return error;
+    }
+  }
+
+  return tixiAddTextAttribute (handle, xPath, CPACS_UID_ATTRIBUTE_STRING, uID);
+}
+
 DLL_EXPORT ReturnCode tixiUIDSetToXPath(TixiDocumentHandle handle, const char *xPath, const char *uID)
 {
+  TixiDocument* document = getDocument(handle);
   ReturnCode error;
 
-  error = tixiUIDCheckDuplicates(handle);
-  if (error != SUCCESS) {
+  lockDocument(document, LOCK_EXCLUSIVE);
+  error = tixiUIDSetToXPathImpl(handle, xPath, uID);
+  unlockDocument(document, LOCK_EXCLUSIVE);
+  return error;
+}
+
+
+static ReturnCode tixiUIDSetEnforceUniqueImpl(TixiDocumentHandle handle, int enforce)
+{
+  TixiDocument *document = getDocument(handle);
+
+  if (!document) {
+    printMsg(MESSAGETYPE_ERROR, "Error: Invalid document handle.\n");
+    return INVALID_HANDLE;
+  }
+
+  if (enforce && !document->enforceUniqueUIDs) {
+    if (uid_readDocumentUIDs(document) != SUCCESS) {
+      return FAILED;
+    }
+    /* uniqueness can only be kept, if it holds already */
+    if (uid_checkForDuplicates(document) != SUCCESS) {
+      return UID_NOT_UNIQUE;
+    }
+  }
+
+  document->enforceUniqueUIDs = enforce ? 1 : 0;
+  return SUCCESS;
+}
+
+DLL_EXPORT ReturnCode tixiUIDSetEnforceUnique(TixiDocumentHandle handle, int enforce)
+{
+  TixiDocument* document = getDocument(handle);
+  ReturnCode error;
+
+  lockDocument(document, LOCK_EXCLUSIVE);
+  error = tixiUIDSetEnforceUniqueImpl(handle, enforce);
+  unlockDocument(document, LOCK_EXCLUSIVE);
+  return error;
+}
+
+
+static ReturnCode tixiUIDSetCheckThreadsImpl(TixiDocumentHandle handle, int nThreads)
+{
+  TixiDocument *document = getDocument(handle);
+
+  if (!document) {
+    printMsg(MESSAGETYPE_ERROR, "Error: Invalid document handle.\n");
+    return INVALID_HANDLE;
+  }
+
+  if (nThreads < 0) {
+    printMsg(MESSAGETYPE_ERROR, "Error: Invalid number of threads %d in tixiUIDSetCheckThreads.\n", nThreads);
+    return FAILED;
+  }
+
+  document->uidCheckThreads = nThreads < UID_MAX_CHECK_THREADS ? nThreads : UID_MAX_CHECK_THREADS;
+  return SUCCESS;
+}
+
+DLL_EXPORT ReturnCode tixiUIDSetCheckThreads(TixiDocumentHandle handle, int nThreads)
+{
+  TixiDocument* document = getDocument(handle);
+  ReturnCode error;
+
+  lockDocument(document, LOCK_EXCLUSIVE);
+  error = tixiUIDSetCheckThreadsImpl(handle, nThreads);
+  unlockDocument(document, LOCK_EXCLUSIVE);
+  return error;
+}
+
+
+/* Returns the element at elementPath relative to the element with the uID */
+static ReturnCode getElementByUID(TixiDocument *document, const char *uID, const char *elementPath,
+                                  xmlNodePtr *element)
+{
+  xmlNodePtr uidElement = NULL;
+  ReturnCode error = SUCCESS;
+
+  if (!uID) {
+    printMsg(MESSAGETYPE_ERROR, "Error: No uID specified.\n");
+    return FAILED;
+  }
+
+  error = readDocumentUIDsShared(document);
+  if (error == SUCCESS) {
+    error = uid_getNode(document, uID, &uidElement);
+  }
+
+  if (error == UID_DONT_EXISTS) {
+    printMsg(MESSAGETYPE_STATUS, "Error: uID '%s' not found!\n", uID);
+    return error;
+  }
+  else if (error == UID_NOT_UNIQUE) {
+    printMsg(MESSAGETYPE_ERROR, "Error: uID '%s' is not unique!\n", uID);
+    return error;
+  }
+  else if (error != SUCCESS) {
     return error;
   }
 
-  return tixiAddTextAttribute (handle, xPath, CPACS_UID_ATTRIBUTE_STRING, uID);
+  return checkElementAt(document, uidElement, elementPath ? elementPath : "", element);
 }
 
+static ReturnCode tixiGetTextElementByUIDImpl(const TixiDocumentHandle handle, const char *uID,
+                                              const char *elementPath, char **text)
+{
+  TixiDocument *document = getDocument(handle);
+  xmlNodePtr element = NULL;
+  ReturnCode error = SUCCESS;
 
-DLL_EXPORT ReturnCode tixiXPathEvaluateNodeNumber(TixiDocumentHandle handle, const char *xPathExpression, int *number)
+  if (!document) {
+    printMsg(MESSAGETYPE_ERROR, "Error: Invalid document handle.\n");
+    return INVALID_HANDLE;
+  }
+
+  error = getElementByUID(document, uID, elementPath, &element);
+
+  if (!error) {
+    xmlChar *allocated = NULL;
+
+    *text = copyToMemoryArena(document, getElementText(document, element, &allocated));
+    xmlFree(allocated);
+    error = *text ? SUCCESS : FAILED;
+  }
+
+  return error;
+}
+
+DLL_EXPORT ReturnCode tixiGetTextElementByUID(const TixiDocumentHandle handle, const char *uID,
+                                              const char *elementPath, char **text)
+{
+  TixiDocument* document = getDocument(handle);
+  ReturnCode error;
+
+  lockDocument(document, LOCK_SHARED);
+  error = tixiGetTextElementByUIDImpl(handle, uID, elementPath, text);
+  unlockDocument(document, LOCK_SHARED);
+  return error;
+}
+
+DLL_EXPORT ReturnCode tixiGetIntegerElementByUID(const TixiDocumentHandle handle, const char *uID,
+                                                 const char *elementPath, int *number)
+{
+  char *text = NULL;
+  ReturnCode error = 0;
+
+  error = tixiGetTextElementByUID(handle, uID, elementPath, &text);
+
+  if (error) {
+    printMsg(MESSAGETYPE_STATUS, "Error: tixiGetTextElementByUID returns %d in tixiGetIntegerElementByUID.\n", error);
+    return error;
+  }
+
+  trim_trailing_whitespace(text);
+  if (isNumeric(text)) {
+    *number = atoi(text);
+    return SUCCESS;
+  }
+  else {
+      return NO_NUMBER;
+  }
+}
+
+DLL_EXPORT ReturnCode tixiGetDoubleElementByUID(const TixiDocumentHandle handle, const char *uID,
+                                                const char *elementPath, double *number)
+{
+  char *text = NULL;
+  ReturnCode error = 0;
+
+  error = tixiGetTextElementByUID(handle, uID, elementPath, &text);
+
+  if (error) {
+    printMsg(MESSAGETYPE_STATUS, "Error: tixiGetTextElementByUID returns %d in tixiGetDoubleElementByUID.\n", error);
+    return error;
+  }
+
+  trim_trailing_whitespace(text);
+  if (isNumeric(text)) {
+    *number = atof(text);
+    return SUCCESS;
+  }
+  else {
+      return NO_NUMBER;
+  }
+}
+
+
+static ReturnCode tixiXPathEvaluateNodeNumberImpl(TixiDocumentHandle handle, const char *xPathExpression, int *number)
 {
   TixiDocument *document = getDocument(handle);
   int error = SUCCESS;
@@ -2983,7 +4484,18 @@ DLL_EXPORT ReturnCode tixiXPathEvaluateNodeNumber(TixiDocumentHandle handle, con
   return error;
 }
 
-DLL_EXPORT ReturnCode tixiXPathExpressionGetXPath(TixiDocumentHandle handle, const char *xPathExpression, int index, char** xPath)
+DLL_EXPORT ReturnCode tixiXPathEvaluateNodeNumber(TixiDocumentHandle handle, const char *xPathExpression, int *number)
+{
+  TixiDocument* document = getDocument(handle);
+  ReturnCode error;
+
+  lockDocument(document, LOCK_SHARED);
+  error = tixiXPathEvaluateNodeNumberImpl(handle, xPathExpression, number);
+  unlockDocument(document, LOCK_SHARED);
+  return error;
+}
+
+static ReturnCode tixiXPathExpressionGetXPathImpl(TixiDocumentHandle handle, const char *xPathExpression, int index, char** xPath)
 {
   TixiDocument *document = getDocument(handle);
   char* tmpXPath = NULL;
@@ -2997,28 +4509,42 @@ DLL_EXPORT ReturnCode tixiXPathExpressionGetXPath(TixiDocumentHandle handle, con
   tmpXPath = XPathExpressionGetElementPath(document, xPathExpression, index);
   if (!tmpXPath) {
     *xPath = NULL;
-    error = FAILED;
+    return FAILED;
   }
 
   // copy to output
-  *xPath = buildString("%s", tmpXPath);
+  *xPath = copyToMemoryArena(document, tmpXPath);
   free(tmpXPath);
-  addToMemoryList(document, (void*) *xPath);
+  if (!*xPath) {
+    error = FAILED;
+  }
 
   return error;
 }
 
-DLL_EXPORT ReturnCode tixiXPathExpressionGetTextByIndex(TixiDocumentHandle handle, const char *xPathExpression, int elementNumber, char **text)
+DLL_EXPORT ReturnCode tixiXPathExpressionGetXPath(TixiDocumentHandle handle, const char *xPathExpression, int index, char** xPath)
+{
+  TixiDocument* document = getDocument(handle);
+  ReturnCode error;
+
+  lockDocument(document, LOCK_SHARED);
+  error = tixiXPathExpressionGetXPathImpl(handle, xPathExpression, index, xPath);
+  unlockDocument(document, LOCK_SHARED);
+  return error;
+}
+
+static ReturnCode tixiXPathExpressionGetTextByIndexImpl(TixiDocumentHandle handle, const char *xPathExpression, int elementNumber, char **text)
 {
   TixiDocument *document = getDocument(handle);
   int error = SUCCESS;
-  char *textPtr = NULL;
+  const char *textPtr = NULL;
+  char *allocated = NULL;
 
-  textPtr = XPathExpressionGetText(document, xPathExpression, elementNumber);
+  textPtr = XPathExpressionGetText(document, xPathExpression, elementNumber, &allocated);
   if ( textPtr ) {
-    *text = (char *) malloc((strlen(textPtr) + 1) * sizeof(char));
-    strcpy(*text, textPtr);
-    error = addToMemoryList(document, (void *) *text);
+    *text = copyToMemoryArena(document, textPtr);
+    xmlFree(allocated);
+    error = *text ? SUCCESS : FAILED;
   } else {
     *text = NULL;
     error = FAILED;
@@ -3027,7 +4553,56 @@ DLL_EXPORT ReturnCode tixiXPathExpressionGetTextByIndex(TixiDocumentHandle handl
   return error;
 }
 
-DLL_EXPORT ReturnCode   tixiGetChildNodeName(const TixiDocumentHandle handle, const char *elementPath,  int index, char **text)
+DLL_EXPORT ReturnCode tixiXPathExpressionGetTextByIndex(TixiDocumentHandle handle, const char *xPathExpression, int elementNumber, char **text)
+{
+  TixiDocument* document = getDocument(handle);
+  ReturnCode error;
+
+  lockDocument(document, LOCK_SHARED);
+  error = tixiXPathExpressionGetTextByIndexImpl(handle, xPathExpression, elementNumber, text);
+  unlockDocument(document, LOCK_SHARED);
+  return error;
+}
+
+static ReturnCode tixiXPathExpressionGetTextByIndexIntoImpl(TixiDocumentHandle handle, const char *xPathExpression,
+                                                            int elementNumber, char *buffer, int bufferSize,
+                                                            int *neededSize)
+{
+  TixiDocument *document = getDocument(handle);
+  ReturnCode error = SUCCESS;
+  const char *textPtr = NULL;
+  char *allocated = NULL;
+
+  if (!document) {
+    printMsg(MESSAGETYPE_ERROR, "Error: Invalid document handle.\n");
+    return INVALID_HANDLE;
+  }
+
+  textPtr = XPathExpressionGetText(document, xPathExpression, elementNumber, &allocated);
+  if ( textPtr ) {
+    error = copyToBuffer(textPtr, buffer, bufferSize, neededSize);
+    xmlFree(allocated);
+  } else {
+    error = FAILED;
+  }
+
+  return error;
+}
+
+DLL_EXPORT ReturnCode tixiXPathExpressionGetTextByIndexInto(TixiDocumentHandle handle, const char *xPathExpression,
+                                                            int elementNumber, char *buffer, int bufferSize,
+                                                            int *neededSize)
+{
+  TixiDocument* document = getDocument(handle);
+  ReturnCode error;
+
+  lockDocument(document, LOCK_SHARED);
+  error = tixiXPathExpressionGetTextByIndexIntoImpl(handle, xPathExpression, elementNumber, buffer, bufferSize, neededSize);
+  unlockDocument(document, LOCK_SHARED);
+  return error;
+}
+
+static ReturnCode tixiGetChildNodeNameImpl(const TixiDocumentHandle handle, const char *elementPath,  int index, char **text)
 {
   TixiDocument *document = getDocument(handle);
   xmlNodePtr element = NULL;
@@ -3042,7 +4617,7 @@ DLL_EXPORT ReturnCode   tixiGetChildNodeName(const TixiDocumentHandle handle, co
     return INDEX_OUT_OF_RANGE;
   }
 
-  error = checkElement(document->xpathContext, elementPath, &element);
+  error = checkElement(document, elementPath, &element);
 
   if(!error){
     xmlNodePtr child = element->children;
@@ -3062,32 +4637,41 @@ DLL_EXPORT ReturnCode   tixiGetChildNodeName(const TixiDocumentHandle handle, co
 
     // return node value according to dom specification: http://www.w3schools.com/dom/dom_nodetype.asp
     if(child->type == XML_TEXT_NODE){
-      *text = (char *) malloc(10 * sizeof(char));
-      strcpy(*text, "#text");
+      *text = copyToMemoryArena(document, "#text");
     }
     else if(child->type == XML_CDATA_SECTION_NODE){
-      *text = (char *) malloc(20 * sizeof(char));
-      strcpy(*text, "#cdata-section");
+      *text = copyToMemoryArena(document, "#cdata-section");
     }
     else if(child->type == XML_COMMENT_NODE){
-      *text = (char *) malloc(10 * sizeof(char));
-      strcpy(*text, "#comment");
+      *text = copyToMemoryArena(document, "#comment");
     }
     else if (child->ns && child->ns->prefix) {
-      *text = (char *) malloc((strlen((const char*)child->name) + strlen((const char*)child->ns->prefix) + 4) * sizeof(char));
-      sprintf(*text, "%s:%s", child->ns->prefix, child->name);
+      *text = (char *) allocateFromMemoryArena(document, (strlen((const char*)child->name) + strlen((const char*)child->ns->prefix) + 2) * sizeof(char));
+      if (*text) {
+        sprintf(*text, "%s:%s", child->ns->prefix, child->name);
+      }
     }
     else {
       // get name
-      *text = (char *) malloc((strlen((const char*)child->name) + 3) * sizeof(char));
-      strcpy(*text,  (const char*) child->name);
+      *text = copyToMemoryArena(document, (const char*) child->name);
     }
-    error = addToMemoryList(document, (void *) *text);
+    error = *text ? SUCCESS : FAILED;
   }
   return error;
 }
 
-ReturnCode tixiSwapElements(const TixiDocumentHandle handle, const char* element1Path, const char* element2Path)
+DLL_EXPORT ReturnCode   tixiGetChildNodeName(const TixiDocumentHandle handle, const char *elementPath,  int index, char **text)
+{
+  TixiDocument* document = getDocument(handle);
+  ReturnCode error;
+
+  lockDocument(document, LOCK_SHARED);
+  error = tixiGetChildNodeNameImpl(handle, elementPath, index, text);
+  unlockDocument(document, LOCK_SHARED);
+  return error;
+}
+
+static ReturnCode tixiSwapElementsImpl(const TixiDocumentHandle handle, const char* element1Path, const char* element2Path)
 {
     TixiDocument *document = getDocument(handle);
     xmlNodePtr element1 = NULL;
@@ -3100,12 +4684,12 @@ ReturnCode tixiSwapElements(const TixiDocumentHandle handle, const char* element
       return INVALID_HANDLE;
     }
 
-    error = checkElement(document->xpathContext, element1Path, &element1);
+    error = checkElement(document, element1Path, &element1);
     if (error != SUCCESS) {
         return error;
     }
 
-    error = checkElement(document->xpathContext, element2Path, &element2);
+    error = checkElement(document, element2Path, &element2);
     if (error != SUCCESS) {
         return error;
     }
@@ -3121,7 +4705,7 @@ ReturnCode tixiSwapElements(const TixiDocumentHandle handle, const char* element
     }
 
     // swap nodes
-    XPathClearCache(document->xpathCache);
+    markDocumentModified(document);
     tmp = xmlCopyNode(element1, 0);
     element1 = xmlReplaceNode(element1, tmp);
     element2 = xmlReplaceNode(element2, element1);
@@ -3131,7 +4715,18 @@ ReturnCode tixiSwapElements(const TixiDocumentHandle handle, const char* element
     return SUCCESS;
 }
 
-DLL_EXPORT ReturnCode tixiExportElementAsString(const TixiDocumentHandle handle, const char* elementPath, char **text)
+ReturnCode tixiSwapElements(const TixiDocumentHandle handle, const char* element1Path, const char* element2Path)
+{
+  TixiDocument* document = getDocument(handle);
+  ReturnCode error;
+
+  lockDocument(document, LOCK_EXCLUSIVE);
+  error = tixiSwapElementsImpl(handle, element1Path, element2Path);
+  unlockDocument(document, LOCK_EXCLUSIVE);
+  return error;
+}
+
+static ReturnCode tixiExportElementAsStringImpl(const TixiDocumentHandle handle, const char* elementPath, char **text)
 {
   TixiDocument *document = getDocument(handle);
   xmlDocPtr xmlDocument = NULL;
@@ -3154,7 +4749,7 @@ DLL_EXPORT ReturnCode tixiExportElementAsString(const TixiDocumentHandle handle,
     return FAILED;
   }
 
-  error = checkElement(document->xpathContext, elementPath, &element);
+  error = checkElement(document, elementPath, &element);
 
   if (!error) {
     buffer = xmlBufferCreate();
@@ -3162,10 +4757,12 @@ DLL_EXPORT ReturnCode tixiExportElementAsString(const TixiDocumentHandle handle,
     textLen = xmlNodeDump(buffer, xmlDocument, element, 0, document->usePrettyPrint);
     
     if (textLen >= 0) {
-      *text = (char *) malloc((textLen+1) * sizeof(char));
-      strncpy(*text, (const char*) xmlBufferContent(buffer), textLen);
-      (*text)[textLen] = '\0';
-      error = addToMemoryList(document, (void *) *text);
+      *text = (char *) allocateFromMemoryArena(document, (textLen+1) * sizeof(char));
+      if (*text) {
+        memcpy(*text, (const char*) xmlBufferContent(buffer), textLen);
+        (*text)[textLen] = '\0';
+      }
+      error = *text ? SUCCESS : FAILED;
     }
     else {
       error = FAILED;
@@ -3177,12 +4774,23 @@ DLL_EXPORT ReturnCode tixiExportElementAsString(const TixiDocumentHandle handle,
   return error;
 }
 
+DLL_EXPORT ReturnCode tixiExportElementAsString(const TixiDocumentHandle handle, const char* elementPath, char **text)
+{
+  TixiDocument* document = getDocument(handle);
+  ReturnCode error;
+
+  lockDocument(document, LOCK_SHARED);
+  error = tixiExportElementAsStringImpl(handle, elementPath, text);
+  unlockDocument(document, LOCK_SHARED);
+  return error;
+}
+
 DLL_EXPORT ReturnCode tixiImportElementFromString (const TixiDocumentHandle handle, const char *parentPath, const char *xmlImportString)
 {
   return tixiImportElementFromStringAtIndex(handle, parentPath, -1, xmlImportString);
 }
 
-DLL_EXPORT ReturnCode tixiImportElementFromStringAtIndex (const TixiDocumentHandle handle, const char *parentPath, int index, const char *xmlImportString)
+static ReturnCode tixiImportElementFromStringAtIndexImpl(const TixiDocumentHandle handle, const char *parentPath, int index, const char *xmlImportString)
 {
   TixiDocument *document = getDocument(handle);
   xmlDocPtr xmlDocument = NULL;
@@ -3206,7 +4814,7 @@ DLL_EXPORT ReturnCode tixiImportElementFromStringAtIndex (const TixiDocumentHand
     return FAILED;
   }
 
-  error = checkElement(document->xpathContext, parentPath, &parentElement);
+  error = checkElement(document, parentPath, &parentElement);
   if (error) {
     return error;
   }
@@ -3224,7 +4832,7 @@ DLL_EXPORT ReturnCode tixiImportElementFromStringAtIndex (const TixiDocumentHand
     targetNode = targetNode->next;
 
   // structure change!, we have to empty the xpath cache
-  XPathClearCache(document->xpathCache);
+  markDocumentModified(document);
 
   if (targetNode != NULL && index > 0) {
     /* insert at position index */
@@ -3234,11 +4842,27 @@ DLL_EXPORT ReturnCode tixiImportElementFromStringAtIndex (const TixiDocumentHand
     /* insert at the end of the list */
     xmlAddChild(parentElement, newElement);
   }
+  error = uid_addSubtreeUnique(document, newElement);
+  if (error != SUCCESS) {
+    xmlUnlinkNode(newElement);
+    xmlFreeNode(newElement);
+  }
 
-  return SUCCESS;
+  return error;
 }
 
-DLL_EXPORT ReturnCode tixiGetNumberOfChilds(const TixiDocumentHandle handle, const char *elementPath, int* nChilds)
+DLL_EXPORT ReturnCode tixiImportElementFromStringAtIndex (const TixiDocumentHandle handle, const char *parentPath, int index, const char *xmlImportString)
+{
+  TixiDocument* document = getDocument(handle);
+  ReturnCode error;
+
+  lockDocument(document, LOCK_EXCLUSIVE);
+  error = tixiImportElementFromStringAtIndexImpl(handle, parentPath, index, xmlImportString);
+  unlockDocument(document, LOCK_EXCLUSIVE);
+  return error;
+}
+
+static ReturnCode tixiGetNumberOfChildsImpl(const TixiDocumentHandle handle, const char *elementPath, int* nChilds)
 {
   TixiDocument *document = getDocument(handle);
   xmlNodePtr element = NULL;
@@ -3250,7 +4874,7 @@ DLL_EXPORT ReturnCode tixiGetNumberOfChilds(const TixiDocumentHandle handle, con
     return INVALID_HANDLE;
   }
 
-  error = checkElement(document->xpathContext, elementPath, &element);
+  error = checkElement(document, elementPath, &element);
 
   if (!error) {
     xmlNodePtr children = element->children;
@@ -3267,7 +4891,18 @@ DLL_EXPORT ReturnCode tixiGetNumberOfChilds(const TixiDocumentHandle handle, con
   return error;
 }
 
-DLL_EXPORT ReturnCode tixiGetNumberOfAttributes(const TixiDocumentHandle handle, const char *elementPath, int* nAttributes)
+DLL_EXPORT ReturnCode tixiGetNumberOfChilds(const TixiDocumentHandle handle, const char *elementPath, int* nChilds)
+{
+  TixiDocument* document = getDocument(handle);
+  ReturnCode error;
+
+  lockDocument(document, LOCK_SHARED);
+  error = tixiGetNumberOfChildsImpl(handle, elementPath, nChilds);
+  unlockDocument(document, LOCK_SHARED);
+  return error;
+}
+
+static ReturnCode tixiGetNumberOfAttributesImpl(const TixiDocumentHandle handle, const char *elementPath, int* nAttributes)
 {
   TixiDocument *document = getDocument(handle);
   xmlNodePtr element = NULL;
@@ -3279,7 +4914,7 @@ DLL_EXPORT ReturnCode tixiGetNumberOfAttributes(const TixiDocumentHandle handle,
     return INVALID_HANDLE;
   }
 
-  error = checkElement(document->xpathContext, elementPath, &element);
+  error = checkElement(document, elementPath, &element);
 
   if (!error) {
     xmlAttrPtr attr = element->properties;
@@ -3294,7 +4929,18 @@ DLL_EXPORT ReturnCode tixiGetNumberOfAttributes(const TixiDocumentHandle handle,
   return error;
 }
 
-DLL_EXPORT ReturnCode tixiGetAttributeName(const TixiDocumentHandle handle, const char *elementPath, int attrIndex, char** attrName)
+DLL_EXPORT ReturnCode tixiGetNumberOfAttributes(const TixiDocumentHandle handle, const char *elementPath, int* nAttributes)
+{
+  TixiDocument* document = getDocument(handle);
+  ReturnCode error;
+
+  lockDocument(document, LOCK_SHARED);
+  error = tixiGetNumberOfAttributesImpl(handle, elementPath, nAttributes);
+  unlockDocument(document, LOCK_SHARED);
+  return error;
+}
+
+static ReturnCode tixiGetAttributeNameImpl(const TixiDocumentHandle handle, const char *elementPath, int attrIndex, char** attrName)
 {
   TixiDocument *document = getDocument(handle);
   xmlNodePtr element = NULL;
@@ -3310,7 +4956,7 @@ DLL_EXPORT ReturnCode tixiGetAttributeName(const TixiDocumentHandle handle, cons
     return INDEX_OUT_OF_RANGE;
   }
 
-  error = checkElement(document->xpathContext, elementPath, &element);
+  error = checkElement(document, elementPath, &element);
 
   if (!error) {
     xmlAttrPtr attr = element->properties;
@@ -3326,22 +4972,34 @@ DLL_EXPORT ReturnCode tixiGetAttributeName(const TixiDocumentHandle handle, cons
     }
 
     if (attr->ns && attr->ns->prefix) {
-      *attrName = (char *) malloc((strlen((char*)attr->name) + strlen((char*)attr->ns->prefix) + 4) * sizeof(char));
-      sprintf(*attrName, "%s:%s", attr->ns->prefix, attr->name);
+      *attrName = (char *) allocateFromMemoryArena(document, (strlen((char*)attr->name) + strlen((char*)attr->ns->prefix) + 2) * sizeof(char));
+      if (*attrName) {
+        sprintf(*attrName, "%s:%s", attr->ns->prefix, attr->name);
+      }
     }
     else {
       // get name
-      *attrName = (char *) malloc((strlen((char*)attr->name) + 3) * sizeof(char));
-      strcpy(*attrName,  (char*)attr->name);
+      *attrName = copyToMemoryArena(document, (char*)attr->name);
     }
-    error = addToMemoryList(document, (void *) *attrName);
+    error = *attrName ? SUCCESS : FAILED;
   }
 
   return error;
 }
 
+DLL_EXPORT ReturnCode tixiGetAttributeName(const TixiDocumentHandle handle, const char *elementPath, int attrIndex, char** attrName)
+{
+  TixiDocument* document = getDocument(handle);
+  ReturnCode error;
 
-DLL_EXPORT ReturnCode tixiGetNodeType(const TixiDocumentHandle handle, const char *nodePath, char **nodeType)
+  lockDocument(document, LOCK_SHARED);
+  error = tixiGetAttributeNameImpl(handle, elementPath, attrIndex, attrName);
+  unlockDocument(document, LOCK_SHARED);
+  return error;
+}
+
+
+static ReturnCode tixiGetNodeTypeImpl(const TixiDocumentHandle handle, const char *nodePath, char **nodeType)
 {
   TixiDocument *document = getDocument(handle);
   xmlNodePtr element     = NULL;
@@ -3352,81 +5010,79 @@ DLL_EXPORT ReturnCode tixiGetNodeType(const TixiDocumentHandle handle, const cha
     return INVALID_HANDLE;
   }
 
-  error = checkElement(document->xpathContext, nodePath, &element);
+  error = checkElement(document, nodePath, &element);
 
   if (!error) {
     switch (element->type) {
     case  XML_ELEMENT_NODE:
-      *nodeType = (char*) malloc ( sizeof(char)* (12 + 3));
-      strcpy(*nodeType, "ELEMENT_NODE");
+      *nodeType = copyToMemoryArena(document, "ELEMENT_NODE");
       break;
 
     case  XML_ATTRIBUTE_NODE:
-      *nodeType = (char*) malloc ( sizeof(char)* (14 + 3));
-      strcpy(*nodeType, "ATTRIBUTE_NODE");
+      *nodeType = copyToMemoryArena(document, "ATTRIBUTE_NODE");
       break;
 
     case  XML_TEXT_NODE:
-      *nodeType = (char*) malloc ( sizeof(char)* (9 + 3));
-      strcpy(*nodeType, "TEXT_NODE");
+      *nodeType = copyToMemoryArena(document, "TEXT_NODE");
       break;
 
     case  XML_CDATA_SECTION_NODE:
-      *nodeType = (char*) malloc ( sizeof(char)* (18 + 3));
-      strcpy(*nodeType, "CDATA_SECTION_NODE");
+      *nodeType = copyToMemoryArena(document, "CDATA_SECTION_NODE");
       break;
 
     case  XML_ENTITY_REF_NODE:
-      *nodeType = (char*) malloc ( sizeof(char)* (21 + 3));
-      strcpy(*nodeType, "ENTITY_REFERENCE_NODE");
+      *nodeType = copyToMemoryArena(document, "ENTITY_REFERENCE_NODE");
       break;
 
     case  XML_ENTITY_NODE:
-      *nodeType = (char*) malloc ( sizeof(char)* (11 + 3));
-      strcpy(*nodeType, "ENTITY_NODE");
+      *nodeType = copyToMemoryArena(document, "ENTITY_NODE");
       break;
 
     case  XML_PI_NODE:
-      *nodeType = (char*) malloc ( sizeof(char)* (27 + 3));
-      strcpy(*nodeType, "PROCESSING_INSTRUCTION_NODE");
+      *nodeType = copyToMemoryArena(document, "PROCESSING_INSTRUCTION_NODE");
       break;
 
     case  XML_COMMENT_NODE:
-      *nodeType = (char*) malloc ( sizeof(char)* (12 + 3));
-      strcpy(*nodeType, "COMMENT_NODE");
+      *nodeType = copyToMemoryArena(document, "COMMENT_NODE");
       break;
 
     case  XML_DOCUMENT_NODE:
-      *nodeType = (char*) malloc ( sizeof(char)* (13 + 3));
-      strcpy(*nodeType, "DOCUMENT_NODE");
+      *nodeType = copyToMemoryArena(document, "DOCUMENT_NODE");
       break;
 
     case  XML_DOCUMENT_TYPE_NODE:
-      *nodeType = (char*) malloc ( sizeof(char)* (18 + 3));
-      strcpy(*nodeType, "DOCUMENT_TYPE_NODE");
+      *nodeType = copyToMemoryArena(document, "DOCUMENT_TYPE_NODE");
       break;
 
     case XML_DOCUMENT_FRAG_NODE:
-      *nodeType = (char*) malloc ( sizeof(char)* (22 + 3));
-      strcpy(*nodeType, "DOCUMENT_FRAGMENT_NODE");
+      *nodeType = copyToMemoryArena(document, "DOCUMENT_FRAGMENT_NODE");
       break;
 
     case  XML_NOTATION_NODE:
-      *nodeType = (char*) malloc ( sizeof(char)* (13 + 3));
-      strcpy(*nodeType, "NOTATION_NODE");
+      *nodeType = copyToMemoryArena(document, "NOTATION_NODE");
       break;
 
     default:
-      *nodeType = (char*) malloc ( sizeof(char)* (12 + 3));
-      strcpy(*nodeType, "UNKNOWN_NODE");
+      *nodeType = copyToMemoryArena(document, "UNKNOWN_NODE");
       break;
     }
 
-    error = addToMemoryList(document, (void *) *nodeType);
+    error = *nodeType ? SUCCESS : FAILED;
   }
   return error;
 }
 
+DLL_EXPORT ReturnCode tixiGetNodeType(const TixiDocumentHandle handle, const char *nodePath, char **nodeType)
+{
+  TixiDocument* document = getDocument(handle);
+  ReturnCode error;
+
+  lockDocument(document, LOCK_SHARED);
+  error = tixiGetNodeTypeImpl(handle, nodePath, nodeType);
+  unlockDocument(document, LOCK_SHARED);
+  return error;
+}
+
 void tixiDefaultMessageHandler(MessageType type, const char *message)
 {
   // only show errors and warnings by default
@@ -3435,7 +5091,7 @@ void tixiDefaultMessageHandler(MessageType type, const char *message)
   }
 }
 
-DLL_EXPORT ReturnCode tixiRegisterNamespace(const TixiDocumentHandle handle, const char* namespaceURI, const char* prefix)
+static ReturnCode tixiRegisterNamespaceImpl(const TixiDocumentHandle handle, const char* namespaceURI, const char* prefix)
 {
   TixiDocument *document = getDocument(handle);
   int code = 0;
@@ -3446,6 +5102,8 @@ DLL_EXPORT ReturnCode tixiRegisterNamespace(const TixiDocumentHandle handle, con
   }
 
   code = XPathRegisterNamespace(document->xpathContext, namespaceURI, prefix);
+  updateThreadNamespaces(document);
+  markDocumentModified(document);
   if (code == 0) {
     return SUCCESS;
   }
@@ -3454,7 +5112,18 @@ DLL_EXPORT ReturnCode tixiRegisterNamespace(const TixiDocumentHandle handle, con
   }
 }
 
-DLL_EXPORT ReturnCode tixiRegisterNamespacesFromDocument(const TixiDocumentHandle handle)
+DLL_EXPORT ReturnCode tixiRegisterNamespace(const TixiDocumentHandle handle, const char* namespaceURI, const char* prefix)
+{
+  TixiDocument* document = getDocument(handle);
+  ReturnCode error;
+
+  lockDocument(document, LOCK_EXCLUSIVE);
+  error = tixiRegisterNamespaceImpl(handle, namespaceURI, prefix);
+  unlockDocument(document, LOCK_EXCLUSIVE);
+  return error;
+}
+
+static ReturnCode tixiRegisterNamespacesFromDocumentImpl(const TixiDocumentHandle handle)
 {
   TixiDocument *document = getDocument(handle);
   int code = 0;
@@ -3465,6 +5134,8 @@ DLL_EXPORT ReturnCode tixiRegisterNamespacesFromDocument(const TixiDocumentHandl
   }
 
   code = XPathRegisterDocumentNamespaces(document->xpathContext);
+  updateThreadNamespaces(document);
+  markDocumentModified(document);
   if (code == 0) {
     return SUCCESS;
   }
@@ -3473,7 +5144,18 @@ DLL_EXPORT ReturnCode tixiRegisterNamespacesFromDocument(const TixiDocumentHandl
   }
 }
 
-DLL_EXPORT ReturnCode tixiSetElementNamespace(const TixiDocumentHandle handle, const char* elementPath, const char* namespaceURI, const char* prefix)
+DLL_EXPORT ReturnCode tixiRegisterNamespacesFromDocument(const TixiDocumentHandle handle)
+{
+  TixiDocument* document = getDocument(handle);
+  ReturnCode error;
+
+  lockDocument(document, LOCK_EXCLUSIVE);
+  error = tixiRegisterNamespacesFromDocumentImpl(handle);
+  unlockDocument(document, LOCK_EXCLUSIVE);
+  return error;
+}
+
+static ReturnCode tixiSetElementNamespaceImpl(const TixiDocumentHandle handle, const char* elementPath, const char* namespaceURI, const char* prefix)
 {
   xmlNodePtr node = NULL;
   ReturnCode retval = SUCCESS;
@@ -3499,6 +5181,7 @@ DLL_EXPORT ReturnCode tixiSetElementNamespace(const TixiDocumentHandle handle, c
     return INVALID_XPATH;
   }
 
+  markDocumentModified(document);
   if (!nodeSetNamespace(document->docPtr, node, prefix, namespaceURI)) {
     return FAILED;
   }
@@ -3507,7 +5190,18 @@ DLL_EXPORT ReturnCode tixiSetElementNamespace(const TixiDocumentHandle handle, c
   }
 }
 
-DLL_EXPORT ReturnCode tixiDeclareNamespace(const TixiDocumentHandle handle, const char* elementPath, const char* namespaceURI, const char* prefix)
+DLL_EXPORT ReturnCode tixiSetElementNamespace(const TixiDocumentHandle handle, const char* elementPath, const char* namespaceURI, const char* prefix)
+{
+  TixiDocument* document = getDocument(handle);
+  ReturnCode error;
+
+  lockDocument(document, LOCK_EXCLUSIVE);
+  error = tixiSetElementNamespaceImpl(handle, elementPath, namespaceURI, prefix);
+  unlockDocument(document, LOCK_EXCLUSIVE);
+  return error;
+}
+
+static ReturnCode tixiDeclareNamespaceImpl(const TixiDocumentHandle handle, const char* elementPath, const char* namespaceURI, const char* prefix)
 {
   xmlNodePtr node = NULL;
   ReturnCode retval = SUCCESS;
@@ -3539,6 +5233,7 @@ DLL_EXPORT ReturnCode tixiDeclareNamespace(const TixiDocumentHandle handle, cons
     return INVALID_XPATH;
   }
 
+  markDocumentModified(document);
   if (!nodeAddNamespace(document->docPtr, node, prefix, namespaceURI)) {
     return FAILED;
   }
@@ -3546,3 +5241,14 @@ DLL_EXPORT ReturnCode tixiDeclareNamespace(const TixiDocumentHandle handle, cons
     return SUCCESS;
   }
 }
+
+DLL_EXPORT ReturnCode tixiDeclareNamespace(const TixiDocumentHandle handle, const char* elementPath, const char* namespaceURI, const char* prefix)
+{
+  TixiDocument* document = getDocument(handle);
+  ReturnCode error;
+
+  lockDocument(document, LOCK_EXCLUSIVE);
+  error = tixiDeclareNamespaceImpl(handle, elementPath, namespaceURI, prefix);
+  unlockDocument(document, LOCK_EXCLUSIVE);
+  return error;
+}
@@ -32,7 +32,9 @@
 #include "tixiUtils.h"
 #include "webMethods.h"
 #include "namespaceFunctions.h"
+#include "numberConversion.h"
 #include "libxml/xmlschemas.h"
+#include "libxml/xpathInternals.h"
 
 /**
    @file Auxiliary routines used to implement the interface.
@@ -51,21 +53,64 @@ void xmlStructuredErrorHandler(void * userData, xmlError const* error) {
 }
 
 
-InternalReturnCode clearMemoryList(TixiDocument* document)
+/* frees all chunks newer than the given one */
+static void freeMemoryChunksUntil(TixiDocument* document, TixiMemoryChunk* chunk)
 {
+  TixiMemoryChunk* current = document->memoryArena;
 
-  TixiMemoryListEntry* current = document->memoryListHead;
-
-  while (current) {
-
-    TixiMemoryListEntry* next = (TixiMemoryListEntry*) current->next;
-    free(current->memory);
+  while (current && current != chunk) {
+    TixiMemoryChunk* next = current->next;
     free(current);
     current = next;
   }
-  document->memoryListHead = NULL;
-  document->memoryListTail = NULL;
-  return SUCCESS;
+  document->memoryArena = current;
+}
+
+void clearMemoryArena(TixiDocument* document)
+{
+  TixiMemoryScope* scope = document->memoryScopes;
+
+  while (scope) {
+    TixiMemoryScope* next = scope->next;
+    free(scope);
+    scope = next;
+  }
+  document->memoryScopes = NULL;
+
+  freeMemoryChunksUntil(document, NULL);
+}
+
+InternalReturnCode pushMemoryScope(TixiDocument* document)
+{
+  TixiMemoryScope* scope = (TixiMemoryScope*) malloc(sizeof(TixiMemoryScope));
+
+  if (!scope) {
+    return MEMORY_ALLOCATION_FAILED;
+  }
+
+  scope->chunk = document->memoryArena;
+  scope->used = scope->chunk ? scope->chunk->used : 0;
+  scope->next = document->memoryScopes;
+  document->memoryScopes = scope;
+  return SUCESS;
+}
+
+int popMemoryScope(TixiDocument* document)
+{
+  TixiMemoryScope* scope = document->memoryScopes;
+
+  if (!scope) {
+    return 0;
+  }
+
+  freeMemoryChunksUntil(document, scope->chunk);
+  if (scope->chunk) {
+    scope->chunk->used = scope->used;
+  }
+
+  document->memoryScopes = scope->next;
+  free(scope);
+  return 1;
 }
 
 void freeTixiDocument(TixiDocument* document)
@@ -89,8 +134,10 @@ void freeTixiDocument(TixiDocument* document)
     free(document->filename);
     document->filename = NULL;
   }
-  clearMemoryList(document);
-  uid_clearUIDList(document);
+  clearMemoryArena(document);
+  uid_clearIndex(document);
+  freePathMemo(document);
+  disableThreadSafety(document);
 
   if (document->xpathContext) {
       xmlXPathFreeContext(document->xpathContext);
@@ -106,154 +153,455 @@ void freeTixiDocument(TixiDocument* document)
   free(document);
 }
 
-InternalReturnCode addDocumentToList(TixiDocument* document, TixiDocumentHandle* handle)
+/* number of bits of a document handle used for the slot index */
+#define HANDLE_INDEX_BITS 16
+#define HANDLE_INDEX_MASK ((1 << HANDLE_INDEX_BITS) - 1)
+#define HANDLE_MAX_SLOTS (TIXI_DOCUMENT_PAGE_SIZE * TIXI_DOCUMENT_MAX_PAGES)
+/* the generation uses the remaining 15 bits, so that handles are always positive */
+#define HANDLE_MAX_GENERATION 0x7FFF
+
+static TixiDocumentSlot* getSlotAtIndex(int index)
 {
+  TixiDocumentSlot* page = (TixiDocumentSlot*) tixiAtomicLoadPtr((void* const*) &documentTable.pages[index >> TIXI_DOCUMENT_PAGE_BITS]);
 
-  TixiDocumentListEntry* currentEntry = documentListHead;
-  static int handleCounter = 0;
+  if (!page) {
+    return NULL;
+  }
+  return &page[index & (TIXI_DOCUMENT_PAGE_SIZE - 1)];
+}
 
-  if (documentListHead) {
+InternalReturnCode addDocumentToList(TixiDocument* document, TixiDocumentHandle* handle)
+{
+  TixiDocumentSlot* slot = NULL;
+  int index;
+
+  tixiMutexLock(&documentTable.lock);
+
+  if (documentTable.firstFree >= 0) {
+    /* reuse the oldest free slot */
+    index = documentTable.firstFree;
+    slot = getSlotAtIndex(index);
+    documentTable.firstFree = slot->nextFree;
+    if (documentTable.firstFree < 0) {
+      documentTable.lastFree = -1;
+    }
+  }
+  else {
+    if (documentTable.used == HANDLE_MAX_SLOTS) {
+      tixiMutexUnlock(&documentTable.lock);
+      return MEMORY_ALLOCATION_FAILED;
+    }
 
-    while (currentEntry->next) {
-      currentEntry = (TixiDocumentListEntry*) currentEntry->next;
+    index = documentTable.used;
+    if ((index & (TIXI_DOCUMENT_PAGE_SIZE - 1)) == 0) {
+      /* the page is published after it has been initialized */
+      TixiDocumentSlot* page = (TixiDocumentSlot*) calloc(TIXI_DOCUMENT_PAGE_SIZE, sizeof(TixiDocumentSlot));
+      if (!page) {
+        tixiMutexUnlock(&documentTable.lock);
+        return MEMORY_ALLOCATION_FAILED;
+      }
+      tixiAtomicStorePtr((void**) &documentTable.pages[index >> TIXI_DOCUMENT_PAGE_BITS], page);
     }
+    documentTable.used++;
 
-    currentEntry->next = (struct TixiDocumentListEntry*)
-        malloc(sizeof(TixiDocumentListEntry));
+    slot = getSlotAtIndex(index);
+    tixiAtomicStoreInt(&slot->generation, 1);
+  }
 
-    if (!currentEntry->next) {
+  slot->nextFree = -1;
+  *handle = (slot->generation << HANDLE_INDEX_BITS) | index;
+  tixiAtomicStorePtr((void**) &slot->document, document);
 
-      return MEMORY_ALLOCATION_FAILED;
-    }
+  tixiMutexUnlock(&documentTable.lock);
 
-    currentEntry = (TixiDocumentListEntry*) currentEntry->next;
+  return SUCESS;
+}
+
+/**
+ * @brief Returns the document of the handle or NULL, if the handle is invalid or stale.
+ *
+ * This function does not lock. A slot is cleared before its generation is incremented,
+ * hence re-checking the generation detects a slot that has been reused in between.
+ */
+static TixiDocument* lookupDocument(TixiDocumentHandle handle)
+{
+  TixiDocumentSlot* slot = NULL;
+  TixiDocument* document = NULL;
+  int generation = handle >> HANDLE_INDEX_BITS;
+
+  if (handle <= 0) {
+    return NULL;
   }
-  else {
 
-    currentEntry = (TixiDocumentListEntry*) malloc(sizeof(TixiDocumentListEntry));
+  slot = getSlotAtIndex(handle & HANDLE_INDEX_MASK);
+  if (!slot || tixiAtomicLoadInt(&slot->generation) != generation) {
+    return NULL;
+  }
 
-    if (currentEntry) {
-      documentListHead = currentEntry;
-    }
-    else {
-      return MEMORY_ALLOCATION_FAILED;
-    }
+  document = (TixiDocument*) tixiAtomicLoadPtr((void* const*) &slot->document);
+  if (!document || tixiAtomicLoadInt(&slot->generation) != generation) {
+    return NULL;
+  }
+  return document;
+}
+
+ReturnCode removeDocumentFromList(TixiDocumentHandle handle)
+{
+  TixiDocumentSlot* slot = NULL;
+  int index = handle & HANDLE_INDEX_MASK;
+
+  tixiMutexLock(&documentTable.lock);
+
+  if (!lookupDocument(handle)) {
+    tixiMutexUnlock(&documentTable.lock);
+    return FAILED;
+  }
+
+  slot = getSlotAtIndex(index);
+  tixiAtomicStorePtr((void**) &slot->document, NULL);
+  if (slot->generation == HANDLE_MAX_GENERATION) {
+    tixiAtomicStoreInt(&slot->generation, 1);
+  }
+  else {
+    tixiAtomicStoreInt(&slot->generation, slot->generation + 1);
   }
 
-  currentEntry->document = document;
-  currentEntry->next = NULL;
+  /* append the slot to the free list */
+  slot->nextFree = -1;
+  if (documentTable.lastFree >= 0) {
+    getSlotAtIndex(documentTable.lastFree)->nextFree = index;
+  }
+  else {
+    documentTable.firstFree = index;
+  }
+  documentTable.lastFree = index;
 
-  handleCounter++;
-  *handle = handleCounter;
+  tixiMutexUnlock(&documentTable.lock);
 
   return SUCCESS;
 }
 
-ReturnCode removeDocumentFromList(TixiDocumentHandle handle)
+TixiDocument* getDocument(TixiDocumentHandle handle)
 {
+  return lookupDocument(handle);
+}
 
-  TixiDocumentListEntry* currentEntry = documentListHead;
-  TixiDocumentListEntry* previousEntry = NULL;
+int getDocumentSlotCount()
+{
+  return tixiAtomicLoadInt(&documentTable.used);
+}
 
-  ReturnCode returnValue = SUCCESS;
+TixiDocument* getDocumentInSlot(int index)
+{
+  TixiDocumentSlot* slot = getSlotAtIndex(index);
 
-  if (documentListHead) {
+  if (!slot) {
+    return NULL;
+  }
+  return (TixiDocument*) tixiAtomicLoadPtr((void* const*) &slot->document);
+}
 
-    while (currentEntry) {
+InternalReturnCode enableThreadSafety(TixiDocument* document)
+{
+  TixiThreadSafety* threadSafety = NULL;
 
-      if (currentEntry->document->handle != handle) {
-        previousEntry = currentEntry;
-        currentEntry = (TixiDocumentListEntry*) currentEntry->next;
-      }
-      else {
-        if (previousEntry) {
-          previousEntry->next = currentEntry->next;
-          free(currentEntry);
-          currentEntry = NULL;
-          returnValue = SUCCESS;
-        }
-        else {
-          documentListHead = (TixiDocumentListEntry*) currentEntry->next;
-          free(currentEntry);
-          currentEntry = NULL;
-          returnValue = SUCCESS;
-        }
-      }
+  if (document->threadSafety) {
+    return SUCESS;
+  }
+
+  threadSafety = (TixiThreadSafety*) malloc(sizeof(TixiThreadSafety));
+  if (!threadSafety) {
+    return MEMORY_ALLOCATION_FAILED;
+  }
+
+  tixiRWLockInit(&threadSafety->lock);
+  tixiMutexInit(&threadSafety->mutex);
+  threadSafety->threadContexts = NULL;
+  document->threadSafety = threadSafety;
+
+  return SUCESS;
+}
+
+void disableThreadSafety(TixiDocument* document)
+{
+  TixiThreadContext* context = NULL;
+
+  if (!document->threadSafety) {
+    return;
+  }
+
+  context = document->threadSafety->threadContexts;
+  while (context) {
+    TixiThreadContext* next = context->next;
+    if (context->xpathContext) {
+      xmlXPathFreeContext(context->xpathContext);
+      XPathFreeCache(context->xpathCache);
     }
+    free(context);
+    context = next;
   }
-  else {
-    returnValue = FAILED;
+
+  tixiRWLockDestroy(&document->threadSafety->lock);
+  tixiMutexDestroy(&document->threadSafety->mutex);
+  free(document->threadSafety);
+  document->threadSafety = NULL;
+}
+
+/* returns the context of the calling thread, it is created on first use */
+static TixiThreadContext* getThreadContext(TixiDocument* document)
+{
+  TixiThreadSafety* threadSafety = document->threadSafety;
+  TixiThreadContext* context = (TixiThreadContext*) tixiAtomicLoadPtr((void* const*) &threadSafety->threadContexts);
+
+  for (; context; context = context->next) {
+    if (tixiIsCurrentThread(context->thread)) {
+      return context;
+    }
   }
 
-  return returnValue;
+  context = (TixiThreadContext*) malloc(sizeof(TixiThreadContext));
+  if (!context) {
+    printMsg(MESSAGETYPE_ERROR, "Error: Could not create context for thread.\n");
+    return NULL;
+  }
+  context->thread = tixiCurrentThread();
+  context->xpathContext = NULL;
+  context->xpathCache = NULL;
+  context->sharedDepth = 0;
+
+  /* publish the initialized context */
+  tixiMutexLock(&threadSafety->mutex);
+  context->next = threadSafety->threadContexts;
+  tixiAtomicStorePtr((void**) &threadSafety->threadContexts, context);
+  tixiMutexUnlock(&threadSafety->mutex);
+
+  return context;
 }
 
-TixiDocument* getDocument(TixiDocumentHandle handle)
+void lockDocument(TixiDocument* document, DocumentLockMode mode)
 {
+  TixiThreadContext* context = NULL;
+
+  if (!document || !document->threadSafety) {
+    return;
+  }
+
+  if (mode == LOCK_SHARED) {
+    /* waiting writers block new readers, hence nested shared locks
+     * of the same thread must not touch the lock again */
+    context = getThreadContext(document);
+    if (context && context->sharedDepth++ > 0) {
+      return;
+    }
+    tixiRWLockShared(&document->threadSafety->lock);
+  }
+  else {
+    tixiRWLockExclusive(&document->threadSafety->lock);
+  }
+}
 
-  TixiDocumentListEntry* currentEntry = documentListHead;
-  TixiDocument* returnValue = NULL;
+void unlockDocument(TixiDocument* document, DocumentLockMode mode)
+{
+  TixiThreadContext* context = NULL;
 
-  if (currentEntry) {
-    while (currentEntry && returnValue == NULL) {
+  if (!document || !document->threadSafety) {
+    return;
+  }
 
-      if (currentEntry->document->handle != handle) {
-        currentEntry = (TixiDocumentListEntry*) currentEntry->next;
-      }
-      else {
-        returnValue = currentEntry->document;
-      }
+  if (mode == LOCK_SHARED) {
+    context = getThreadContext(document);
+    if (context && --context->sharedDepth > 0) {
+      return;
     }
+    tixiRWUnlockShared(&document->threadSafety->lock);
   }
   else {
-    returnValue = NULL;
+    tixiRWUnlockExclusive(&document->threadSafety->lock);
   }
+}
 
-  return returnValue;
+static void copyNamespace(void* namespaceURI, void* xpathContext, const xmlChar* prefix)
+{
+  xmlXPathRegisterNs((xmlXPathContextPtr) xpathContext, prefix, (const xmlChar*) namespaceURI);
+}
+
+/* registers all namespaces of the documents xpath context in the thread context */
+static void copyNamespaces(TixiDocument* document, TixiThreadContext* context)
+{
+  if (context->xpathContext && document->xpathContext->nsHash) {
+    xmlHashScan(document->xpathContext->nsHash, copyNamespace, context->xpathContext);
+  }
 }
 
-InternalReturnCode addToMemoryList(TixiDocument* document, void* memory)
+/* returns the context of the calling thread with initialized xpath members. As
+ * the document is locked, no other thread modifies the namespaces or the caches */
+static TixiThreadContext* getXPathThreadContext(TixiDocument* document)
 {
+  TixiThreadContext* context = getThreadContext(document);
 
-  TixiMemoryListEntry* currentEntry = document->memoryListTail;
+  if (!context || context->xpathContext) {
+    return context;
+  }
 
-  if (currentEntry) {
+  context->xpathContext = xmlXPathNewContext(document->docPtr);
+  context->xpathCache = XPathNewCache();
+  context->xpathCache->enabled = document->xpathCache->enabled;
+  copyNamespaces(document, context);
 
-    currentEntry->next = (struct TixiMemoryListEntry*) malloc(sizeof(TixiMemoryListEntry));
+  return context;
+}
 
-    if (currentEntry->next) {
-      currentEntry = (TixiMemoryListEntry*) currentEntry->next;
-      document->memoryListTail = currentEntry;
-    }
-    else {
-      return MEMORY_ALLOCATION_FAILED;
+xmlXPathContextPtr getXPathContext(TixiDocument* document)
+{
+  TixiThreadContext* context = NULL;
+
+  if (!document->threadSafety) {
+    return document->xpathContext;
+  }
+
+  context = getXPathThreadContext(document);
+  return context ? context->xpathContext : NULL;
+}
+
+XPathCache* getXPathCache(TixiDocument* document)
+{
+  TixiThreadContext* context = NULL;
+
+  if (!document->threadSafety) {
+    return document->xpathCache;
+  }
+
+  context = getXPathThreadContext(document);
+  return context ? context->xpathCache : NULL;
+}
+
+void markDocumentModified(TixiDocument* document)
+{
+  /* the caches compare their generation with the document on the next lookup */
+  document->generation++;
+}
+
+void setXPathCachesEnabled(TixiDocument* document, int enabled)
+{
+  TixiThreadContext* context = NULL;
+
+  document->xpathCache->enabled = enabled;
+
+  if (document->threadSafety) {
+    for (context = document->threadSafety->threadContexts; context; context = context->next) {
+      if (context->xpathCache) {
+        context->xpathCache->enabled = enabled;
+      }
     }
   }
-  else {
+}
 
-    currentEntry = (TixiMemoryListEntry*) malloc(sizeof(TixiMemoryListEntry));
+void updateThreadNamespaces(TixiDocument* document)
+{
+  TixiThreadContext* context = NULL;
 
-    if (currentEntry) {
-      document->memoryListHead = currentEntry;
-      document->memoryListTail = currentEntry;
+  if (document->threadSafety) {
+    for (context = document->threadSafety->threadContexts; context; context = context->next) {
+      copyNamespaces(document, context);
     }
-    else {
-      return MEMORY_ALLOCATION_FAILED;
+  }
+}
+
+/* alignment of all memory handed out by the arena, sufficient for doubles and pointers */
+#define MEMORY_ARENA_ALIGNMENT 16
+#define MEMORY_ARENA_ALIGN(size) (((size) + MEMORY_ARENA_ALIGNMENT - 1) & ~((size_t) MEMORY_ARENA_ALIGNMENT - 1))
+#define MEMORY_ARENA_HEADER_SIZE MEMORY_ARENA_ALIGN(sizeof(TixiMemoryChunk))
+#define MEMORY_ARENA_CHUNK_SIZE (64 * 1024)
+
+static void* allocateFromMemoryArenaUnlocked(TixiDocument* document, size_t size)
+{
+  TixiMemoryChunk* chunk = document->memoryArena;
+  void* memory = NULL;
+
+  size = MEMORY_ARENA_ALIGN(size > 0 ? size : 1);
+
+  if (!chunk || chunk->size - chunk->used < size) {
+    /* large requests get a chunk of their own */
+    size_t chunkSize = size > MEMORY_ARENA_CHUNK_SIZE ? size : MEMORY_ARENA_CHUNK_SIZE;
+
+    chunk = (TixiMemoryChunk*) malloc(MEMORY_ARENA_HEADER_SIZE + chunkSize);
+    if (!chunk) {
+      return NULL;
     }
+    chunk->next = document->memoryArena;
+    chunk->size = chunkSize;
+    chunk->used = 0;
+    document->memoryArena = chunk;
   }
 
-  currentEntry->memory = memory;
-  currentEntry->next = NULL;
+  memory = (char*) chunk + MEMORY_ARENA_HEADER_SIZE + chunk->used;
+  chunk->used += size;
+  return memory;
+}
 
-  return SUCCESS;
+void* allocateFromMemoryArena(TixiDocument* document, size_t size)
+{
+  void* memory = NULL;
+
+  /* threads sharing the document allocate concurrently */
+  if (document->threadSafety) {
+    tixiMutexLock(&document->threadSafety->mutex);
+  }
+
+  memory = allocateFromMemoryArenaUnlocked(document, size);
+
+  if (document->threadSafety) {
+    tixiMutexUnlock(&document->threadSafety->mutex);
+  }
+
+  if (!memory) {
+    printMsg(MESSAGETYPE_ERROR, "Error: Could not allocate memory for the result.\n");
+  }
+  return memory;
+}
+
+char* copyToMemoryArena(TixiDocument* document, const char* string)
+{
+  size_t length = strlen(string);
+  char* copy = (char*) allocateFromMemoryArena(document, length + 1);
+
+  if (copy) {
+    memcpy(copy, string, length + 1);
+  }
+  return copy;
 }
 
-ReturnCode checkExistence(const xmlXPathContextPtr xpathContext, const char* elementPath, xmlXPathObjectPtr* xpathObject)
+ReturnCode copyToBuffer(const char* string, char* buffer, int bufferSize, int* neededSize)
+{
+  size_t length = strlen(string);
+
+  if (neededSize) {
+    *neededSize = (int) (length + 1);
+  }
+
+  if (bufferSize < 0 || (!buffer && bufferSize > 0)) {
+    printMsg(MESSAGETYPE_ERROR, "Error: Invalid buffer for the result.\n");
+    return FAILED;
+  }
+
+  if (length < (size_t) bufferSize) {
+    memcpy(buffer, string, length + 1);
+    return SUCCESS;
+  }
+
+  if (bufferSize > 0) {
+    memcpy(buffer, string, bufferSize - 1);
+    buffer[bufferSize - 1] = '\0';
+  }
+  return STRING_TRUNCATED;
+}
+
+ReturnCode checkExistence(TixiDocument* document, const char* elementPath, xmlXPathObjectPtr* xpathObject)
 {
 
   *xpathObject = NULL;
 
-  *xpathObject = xmlXPathEvalExpression((const xmlChar*) elementPath, xpathContext);
+  *xpathObject = XPathEvaluateCompiled(document, elementPath, XPathElementPathLength(elementPath));
   if (!(*xpathObject)) {
     printMsg(MESSAGETYPE_ERROR, "Error: Invalid XPath expression \"%s\"\n", elementPath);
     //xmlXPathFreeObject(*xpathObject);
@@ -310,60 +658,83 @@ ReturnCode checkExternalNode(const xmlNodePtr element)
 }
 
 
-ReturnCode checkElement(const xmlXPathContextPtr xpathContext, const char* elementPathDirty,
-                        xmlNodePtr* element)
+/* Evaluates the element path and returns the number of matching nodes, limited to 2, or -1
+ * if the expression is invalid. Simple paths are resolved without the xpath engine. The
+ * first node is returned, if it is part of the document, i.e. not a namespace node. */
+static int findNodes(TixiDocument* document, xmlNodePtr contextNode, const char* path, xmlNodePtr* first)
 {
-
+  xmlXPathObjectPtr xpathObject = NULL;
   xmlNodeSetPtr nodes = NULL;
-  char elementPath[1024];
+  size_t length = XPathElementPathLength(path);
+  int count = contextNode ? XPathResolveRelativeSimplePath(document, contextNode, path, length, first)
+                          : XPathResolveSimplePath(document, path, length, first);
 
-  xmlXPathObjectPtr xpathObject = NULL;
+  if (count >= 0) {
+    return count;
+  }
 
-  /* remove trailing slash */
-  strncpy(elementPath, elementPathDirty, 1024);
-  if(strlen(elementPath) > 1 && elementPath[strlen(elementPath)-1] == '/') {
-    elementPath[strlen(elementPath)-1] = '\0';
+  xpathObject = XPathEvaluateCompiledAt(document, contextNode, path, length);
+  if (!xpathObject) {
+    return -1;
+  }
+
+  *first = NULL;
+  count = 0;
+  nodes = xpathObject->nodesetval;
+  if (!xmlXPathNodeSetIsEmpty(nodes)) {
+    count = nodes->nodeNr > 1 ? 2 : 1;
+    if (nodes->nodeTab[0]->type != XML_NAMESPACE_DECL) {
+      *first = nodes->nodeTab[0];
+    }
   }
 
+  xmlXPathFreeObject(xpathObject);
+  return count;
+}
+
+ReturnCode checkElement(TixiDocument* document, const char* elementPath,
+                        xmlNodePtr* element)
+{
+  return checkElementAt(document, NULL, elementPath, element);
+}
+
+ReturnCode checkElementAt(TixiDocument* document, xmlNodePtr contextNode, const char* elementPath,
+                          xmlNodePtr* element)
+{
+
+  xmlNodePtr node = NULL;
+  int count = 0;
+
   /* Evaluate Expression */
-  xpathObject = xmlXPathEvalExpression((xmlChar*) elementPath, xpathContext);
-  if (!xpathObject) {
+  count = findNodes(document, contextNode, elementPath, &node);
+  if (count < 0) {
     printMsg(MESSAGETYPE_ERROR, "Error: Invalid XPath expression \"%s\"\n", elementPath);
     return INVALID_XPATH;
   }
 
-  if (xmlXPathNodeSetIsEmpty(xpathObject->nodesetval)) {
+  if (count == 0) {
     char * errorStr = buildString("Error: element %s not found!", elementPath);
-    xmlXPathFreeObject(xpathObject);
 
     printMsg(MESSAGETYPE_STATUS, errorStr);
     free(errorStr);
     return ELEMENT_NOT_FOUND;
   }
 
-  nodes = xpathObject->nodesetval;
-  assert(nodes);
-
-  if (nodes->nodeNr > 1) {
+  if (count > 1) {
     printMsg(MESSAGETYPE_ERROR,
              "Error: Element chosen by XPath \"%s\" expression is not unique. \n", elementPath);
-    xmlXPathFreeObject(xpathObject);
     return ELEMENT_PATH_NOT_UNIQUE;
   }
 
-  assert(nodes->nodeTab[0]);
-
-  if (nodes->nodeTab[0]->type == XML_ELEMENT_NODE ||
-      nodes->nodeTab[0]->type == XML_DOCUMENT_NODE ||
-      nodes->nodeTab[0]->type == XML_TEXT_NODE ) {
-    *element = nodes->nodeTab[0];
-    xmlXPathFreeObject(xpathObject);
+  if (node && (node->type == XML_ELEMENT_NODE ||
+               node->type == XML_DOCUMENT_NODE ||
+               node->type == XML_TEXT_NODE)) {
+    *element = node;
     return SUCCESS;
   }
   else {
     printMsg(MESSAGETYPE_ERROR,
              "Error: XPath expression \"%s\"does not point to an element node.\n", elementPath);
-    xmlXPathFreeObject(xpathObject);
     return NOT_AN_ELEMENT;
   }
 }
@@ -393,7 +764,7 @@ ReturnCode getCoordinateValue(TixiDocument* document, char* pointPath,
   strcpy(coordinatePath, pointPath);
   strcat(coordinatePath, suffixString);
 
-  error = checkElement(document->xpathContext, coordinatePath, &coordinate);
+  error = checkElement(document, coordinatePath, &coordinate);
 
   free(coordinatePath);
   free(suffixString);
@@ -446,7 +817,7 @@ ReturnCode getPoint(const TixiDocumentHandle handle, const char* parentPath, con
     return INDEX_OUT_OF_RANGE;
   }
 
-  error = checkElement(document->xpathContext, parentPath, &parent);
+  error = checkElement(document, parentPath, &parent);
 
   if (!error) {
 
@@ -461,7 +832,7 @@ ReturnCode getPoint(const TixiDocumentHandle handle, const char* parentPath, con
 
     /* pad with trailing blanks, so we can check for the size in getCoordinateValue */
 
-    error = checkExistence(document->xpathContext, pointPath, &xpathPointObject);
+    error = checkExistence(document, pointPath, &xpathPointObject);
 
     if (xpathPointObject) {
       nPointElements = xpathPointObject->nodesetval->nodeNr;
@@ -563,39 +934,91 @@ char* buildString(const char* format, ...)
   return buffer;
 }
 
+/* Grows a string buffer to hold at least size characters by doubling its capacity.
+ * The buffer is freed, if it can't be grown. */
+static int reserveString(char** string, size_t* capacity, size_t size)
+{
+  size_t newCapacity = *capacity;
+  char* grown = NULL;
+
+  if (size <= *capacity) {
+    return 1;
+  }
+
+  while (newCapacity < size) {
+    newCapacity *= 2;
+  }
+  grown = (char*) realloc(*string, newCapacity);
+  if (!grown) {
+    free(*string);
+    *string = NULL;
+    return 0;
+  }
+  *string = grown;
+  *capacity = newCapacity;
+  return 1;
+}
+
 char* vectorToString(const double* vector, int numElements, const char* format)
 {
-    int i = 0, stringSize = 0, delim_size = strlen(VECTOR_SEPARATOR);
-    // the output string
-    char* stringVector = NULL;
-
-    /* calculate the size of the resulting string */
-    for (i=0; i<numElements; i++) {
-        // according to C99 Standard, n=0 allows a null pointer
-        // effectively just counting the written bytes this way
-        stringSize += snprintf(NULL, 0, format, vector[i]) + delim_size;
+  size_t delimSize = strlen(VECTOR_SEPARATOR);
+  size_t capacity = (numElements > 0 ? (size_t) numElements * 16 : 0) + NUMBER_BUFFER_SIZE;
+  size_t length = 0;
+  int general = !format || strcmp(format, "%g") == 0;
+  int exact = format && strcmp(format, VECTOR_FORMAT_EXACT) == 0;
+  int i;
+  // the output string, each number is formatted once directly into it
+  char* stringVector = NULL;
+
+  if (format && strcmp(format, VECTOR_ENCODING_BASE64) == 0) {
+    stringVector = (char *) malloc(BASE64_DOUBLES_LENGTH(numElements > 0 ? numElements : 0) + 1);
+    if (stringVector) {
+      encodeDoublesBase64(vector, numElements, stringVector);
     }
+    return stringVector;
+  }
 
-    /* allocate memory */
-    stringVector = (char *) malloc(sizeof(char) * (stringSize + 1));
-
-    /* copy strings to stringVector */
-    stringVector[0] = '\0';
+  stringVector = (char *) malloc(sizeof(char) * capacity);
+  if (!stringVector) {
+    return NULL;
+  }
 
-    if (numElements > 0) {
-        char* formatExt = buildString("%s%s", VECTOR_SEPARATOR, format);
+  for (i = 0; i < numElements; i++) {
+    // room for the separator and a number of the fast path
+    if (!reserveString(&stringVector, &capacity, length + delimSize + NUMBER_BUFFER_SIZE)) {
+      return NULL;
+    }
+    if (i > 0) {
+      memcpy(stringVector + length, VECTOR_SEPARATOR, delimSize);
+      length += delimSize;
+    }
 
-        stringSize = sprintf(stringVector, format , vector[0]);
-        for (i=1; i < numElements; i++) {
+    if (exact) {
+      length += formatDoubleShortest(vector[i], stringVector + length);
+    }
+    else if (general) {
+      length += formatDoubleGeneral(vector[i], stringVector + length);
+    }
+    else {
+      int written = snprintf(stringVector + length, capacity - length, format, vector[i]);
 
-          // by using the pointer stringVector + stringSize, we can avoid
-          // computing the string length as done by strcat
-          stringSize += sprintf(stringVector + stringSize, formatExt, vector[i]);
+      if (written < 0) {
+        free(stringVector);
+        return NULL;
+      }
+      // only formats producing very long numbers have to be printed twice
+      if ((size_t) written >= capacity - length) {
+        if (!reserveString(&stringVector, &capacity, length + written + 1)) {
+          return NULL;
         }
-        free(formatExt);
+        snprintf(stringVector + length, capacity - length, format, vector[i]);
+      }
+      length += written;
     }
+  }
 
-    return stringVector;
+  stringVector[length] = '\0';
+  return stringVector;
 }
 
 char* loadExternalFileToString(const char* filename)
@@ -629,6 +1052,9 @@ ReturnCode loadExternalDataNode(TixiDocument* aTixiDocument, xmlNodePtr external
     ReturnCode error = SUCCESS;
     int iNode = 0;
 
+    /* the external data node is replaced by the contents of the files */
+    uid_clearIndex(aTixiDocument);
+
     /* get nodes XPath */
     externalDataNodeXPath = (char*) xmlGetNodePath(externalDataNode);
 
@@ -765,11 +1191,11 @@ ReturnCode openExternalFiles(TixiDocument* aTixiDocument, int* number)
     }
     if (iNode == nodeset->nodeNr) {
       // no element node found
-      XPathClearCache(aTixiDocument->xpathCache);
+      markDocumentModified(aTixiDocument);
       break; // while loop
     }
 
-    XPathClearCache(aTixiDocument->xpathCache);
+    markDocumentModified(aTixiDocument);
 
     errCode = loadExternalDataNode(aTixiDocument, cur, number);
     if (errCode != SUCCESS) {
@@ -938,48 +1364,38 @@ xmlNodePtr getParentNodeToXPath(TixiDocumentHandle handle, const char* elementPa
 {
 
   TixiDocument* document = getDocument(handle);
-  xmlXPathObjectPtr xpathObject = NULL;
-  xmlNodeSetPtr nodes = NULL;
-  xmlNodePtr parent = NULL;
+  xmlNodePtr node = NULL;
+  int count = 0;
 
 
   if (!document) {
     printMsg(MESSAGETYPE_ERROR, "Error: Invalid document handle.\n");
-    return parent;
+    return NULL;
   }
 
-  xpathObject = xmlXPathEvalExpression((xmlChar*) elementPath, document->xpathContext);
+  count = findNodes(document, NULL, elementPath, &node);
 
-  if (!xpathObject) {
+  if (count < 0) {
     printMsg(MESSAGETYPE_ERROR, "Error: unable to evaluate xpath expression \"%s\"\n", elementPath);
-    return parent;
+    return NULL;
   }
 
-  if (xmlXPathNodeSetIsEmpty(xpathObject->nodesetval)) {
+  if (count == 0) {
     printMsg(MESSAGETYPE_ERROR, "Error: No element found at XPath expression \"%s\"\n", elementPath);
-    xmlXPathFreeObject(xpathObject);
-    return parent;
+    return NULL;
   }
 
-  nodes = xpathObject->nodesetval;
-
-  assert(nodes);
-
-  if (nodes->nodeNr > 1) {
+  if (count > 1) {
     printMsg(MESSAGETYPE_ERROR,
              "Error: Element chosen by XPath \"%s\" expression is not unique. \n", elementPath);
-    xmlXPathFreeObject(xpathObject);
-    return parent;
+    return NULL;
   }
 
-  parent = nodes->nodeTab[0]->parent;
-
-  xmlXPathFreeObject(xpathObject);
-  return parent;
+  return node ? node->parent : NULL;
 }
 
 
-ReturnCode genericAddTextAttribute(xmlXPathContextPtr xpathContext, const char* elementPath,
+ReturnCode genericAddTextAttribute(TixiDocument* document, const char* elementPath,
                                    const char* attributeName, const char* attributeValue)
 {
   ReturnCode error = -1;
@@ -996,7 +1412,10 @@ ReturnCode genericAddTextAttribute(xmlXPathContextPtr xpathContext, const char*
     return INVALID_XML_NAME;
   }
 
-  error = checkElement(xpathContext, elementPath, &parent);
+  error = checkElement(document, elementPath, &parent);
+  if (!error && !strcmp(attributeName, CPACS_UID_ATTRIBUTE_STRING)) {
+    error = uid_checkAssignable(document, parent, attributeValue);
+  }
   if (!error) {
     char* prefix = NULL;
     char* name = NULL;
@@ -1005,7 +1424,14 @@ ReturnCode genericAddTextAttribute(xmlXPathContextPtr xpathContext, const char*
     extractPrefixAndName(attributeName, &prefix, &name);
 
     if (!prefix) {
+      int isIndexed = uid_isIndexedAttribute(attributeName);
+      if (isIndexed) {
+        uid_removeElement(document, parent);
+      }
       attributePtr = xmlSetProp(parent, (xmlChar*) attributeName, (xmlChar*) attributeValue);
+      if (isIndexed) {
+        uid_addElement(document, parent);
+      }
     }
     else {
       xmlNsPtr ns = xmlSearchNs(parent->doc, parent, (xmlChar *) prefix);
@@ -1041,41 +1467,31 @@ ReturnCode genericAddTextAttribute(xmlXPathContextPtr xpathContext, const char*
 ReturnCode getNodePtrFromElementPath(TixiDocumentHandle handle, const char* elementPath, xmlNodePtr* pNodePrt)
 {
   TixiDocument* document = getDocument(handle);
-  xmlXPathObjectPtr xpathObject = NULL;
-  xmlNodeSetPtr nodes = NULL;
+  int count = 0;
 
   if (!document) {
     printMsg(MESSAGETYPE_ERROR, "Error: Invalid document handle.\n");
     return INVALID_HANDLE;
   }
 
-  xpathObject = xmlXPathEvalExpression((xmlChar*) elementPath, document->xpathContext);
+  count = findNodes(document, NULL, elementPath, pNodePrt);
 
-  if (!xpathObject) {
+  if (count < 0) {
     printMsg(MESSAGETYPE_ERROR, "Error: unable to evaluate xpath expression \"%s\"\n", elementPath);
     return INVALID_XPATH;
   }
 
-  if (xmlXPathNodeSetIsEmpty(xpathObject->nodesetval)) {
+  if (count == 0) {
     printMsg(MESSAGETYPE_ERROR, "Error: No element found at XPath expression \"%s\"\n", elementPath);
-    xmlXPathFreeObject(xpathObject);
     return ELEMENT_NOT_FOUND;
   }
 
-  nodes = xpathObject->nodesetval;
-
-  assert(nodes);
-
-  if (nodes->nodeNr > 1) {
+  if (count > 1) {
     printMsg(MESSAGETYPE_ERROR,
              "Error: Element chosen by XPath \"%s\" expression is not unique. \n", elementPath);
-    xmlXPathFreeObject(xpathObject);
     return ELEMENT_PATH_NOT_UNIQUE;
   }
 
-  *pNodePrt = nodes->nodeTab[0];
-  xmlXPathFreeObject(xpathObject);
-
   return SUCCESS;
 }
 
@@ -1145,13 +1561,21 @@ int copyDocument(const TixiDocumentHandle oldTixiDocumentHandle, TixiDocumentHan
   dstDocument->currentNode = rootNode;
   dstDocument->isValid = srcDocument->isValid;
   dstDocument->status = srcDocument->status;
-  dstDocument->memoryListHead = NULL;
-  dstDocument->memoryListTail = NULL;
-  dstDocument->uidListHead = NULL;
+  dstDocument->memoryArena = NULL;
+  dstDocument->memoryScopes = NULL;
+  dstDocument->uidDict = NULL;
+  dstDocument->uidIndex = NULL;
+  dstDocument->linkIndex = NULL;
+  dstDocument->uidDuplicates = 0;
+  dstDocument->enforceUniqueUIDs = srcDocument->enforceUniqueUIDs;
+  dstDocument->uidCheckThreads = srcDocument->uidCheckThreads;
   dstDocument->hasIncludedExternalFiles = srcDocument->hasIncludedExternalFiles;
   dstDocument->usePrettyPrint = srcDocument->usePrettyPrint;
   dstDocument->xpathContext = xmlXPathNewContext(xmlDocument);
   dstDocument->xpathCache = XPathNewCache();
+  dstDocument->generation = 0;
+  dstDocument->pathMemo = NULL;
+  dstDocument->threadSafety = NULL;
 
   if (addDocumentToList(dstDocument, &(dstDocument->handle)) != SUCESS) {
     printMsg(MESSAGETYPE_ERROR, "Error in TIXI::copyDocument => Failed  adding document to document list.");
@@ -1294,54 +1718,161 @@ ReturnCode validateSchema(const TixiDocumentHandle handle, xmlDocPtr* schema_doc
   }
 }
 
+/* length of the path segment of an element, i.e. /name or /name[@uID="value"] */
+static size_t pathSegmentLength(xmlNodePtr element)
+{
+  xmlChar* buffer = NULL;
+  const char* uID = (const char*) uid_getElementUID(element, &buffer);
+  size_t length = 1 + strlen((char*) element->name);
+
+  if (uID) {
+    length += strlen(uID) + strlen("[@uID=\"\"]");
+  }
+  xmlFree(buffer);
+  return length;
+}
+
+/* writes the path segment of an element, the buffer must be large enough */
+static void writePathSegment(xmlNodePtr element, char* path)
+{
+  xmlChar* buffer = NULL;
+  const char* uID = (const char*) uid_getElementUID(element, &buffer);
+
+  if (uID) {
+    sprintf(path, "/%s[@uID=\"%s\"]", element->name, uID);
+  }
+  else {
+    sprintf(path, "/%s", element->name);
+  }
+  xmlFree(buffer);
+}
+
+void freePathMemo(TixiDocument* document)
+{
+  if (document->pathMemo) {
+    free(document->pathMemo->nodes);
+    free(document->pathMemo->ends);
+    free(document->pathMemo->path);
+    free(document->pathMemo);
+    document->pathMemo = NULL;
+  }
+}
+
+/* generates the path into the buffer of the memo, reusing the prefix of the common ancestors */
+static ReturnCode generatePathInMemo(TixiDocument* document, xmlNodePtr aNodePtr)
+{
+  TixiPathMemo* memo = document->pathMemo;
+  xmlNodePtr nodePtr = NULL;
+  int depth = 0;
+  int common = 0;
+  int i = 0;
+
+  if (!memo) {
+    memo = (TixiPathMemo*) calloc(1, sizeof(TixiPathMemo));
+    if (!memo) {
+      return MEMORY_ALLOCATION_FAILED;
+    }
+    document->pathMemo = memo;
+  }
+  if (memo->generation != document->generation) {
+    /* nodes of the memo may have been changed or freed */
+    memo->depth = 0;
+    memo->generation = document->generation;
+  }
+
+  for (nodePtr = aNodePtr; nodePtr && nodePtr->parent; nodePtr = nodePtr->parent) {
+    if (nodePtr->type == XML_ELEMENT_NODE) {
+      depth++;
+    }
+  }
+
+  if (depth > memo->capacity) {
+    xmlNodePtr* nodes = (xmlNodePtr*) realloc(memo->nodes, depth * sizeof(xmlNodePtr));
+    size_t* ends = NULL;
+    if (nodes) {
+      memo->nodes = nodes;
+    }
+    ends = (size_t*) realloc(memo->ends, depth * sizeof(size_t));
+    if (ends) {
+      memo->ends = ends;
+    }
+    if (!nodes || !ends) {
+      memo->depth = 0;
+      return MEMORY_ALLOCATION_FAILED;
+    }
+    memo->capacity = depth;
+  }
+
+  /* walk up to the first element of the last path. Its prefix and the prefixes of
+   * its ancestors are still valid, the other elements are replaced. */
+  i = depth;
+  for (nodePtr = aNodePtr; i > 0; nodePtr = nodePtr->parent) {
+    if (nodePtr->type != XML_ELEMENT_NODE) {
+      continue;
+    }
+    i--;
+    if (i < memo->depth && memo->nodes[i] == nodePtr) {
+      common = i + 1;
+      break;
+    }
+    memo->nodes[i] = nodePtr;
+    memo->ends[i] = pathSegmentLength(nodePtr);
+  }
+  for (i = common; i < depth; i++) {
+    memo->ends[i] += i > 0 ? memo->ends[i - 1] : 0;
+  }
+  memo->depth = common;
+
+  if (depth > 0 && memo->ends[depth - 1] + 1 > memo->pathCapacity) {
+    char* path = (char*) realloc(memo->path, memo->ends[depth - 1] + 1);
+    if (!path) {
+      return MEMORY_ALLOCATION_FAILED;
+    }
+    memo->path = path;
+    memo->pathCapacity = memo->ends[depth - 1] + 1;
+  }
+
+  for (i = common; i < depth; i++) {
+    writePathSegment(memo->nodes[i], memo->path + (i > 0 ? memo->ends[i - 1] : 0));
+  }
+  memo->depth = depth;
+  return SUCCESS;
+}
+
 char* generateXPathFromNodePtr(TixiDocumentHandle handle, xmlNodePtr aNodePtr)
 {
-  xmlNodePtr nodePtr = aNodePtr;
   TixiDocument* document = getDocument(handle);
-  char* generatedXPath = NULL;
   char* textPtr = NULL;
-  char* tmpText = NULL;
-  char* nodeName = NULL;
-  size_t size = 0;
-  generatedXPath = malloc(1 * sizeof(char));
-  generatedXPath[0] = '\0';
+  size_t length = 0;
 
   if (!document) {
     printMsg(MESSAGETYPE_ERROR, "Error: Invalid document handle.\n");
-    free(generatedXPath);
     return NULL;
   }
 
-  while ((nodePtr != NULL) && (nodePtr->parent != NULL)) {
-    if (nodePtr->type == XML_ELEMENT_NODE) {
-
-      /* handle uIDs */
-      textPtr = (char*) xmlGetProp(nodePtr, (xmlChar*) "uID");
-      if (textPtr) {
-        // do something with the attribute...
-        size = strlen((char*) nodePtr->name) + strlen(textPtr) + strlen("[@uID=\"\"]") + 1;
-        nodeName = (char*) malloc(size * sizeof(char));
-        sprintf(nodeName, "%s[@uID=\"%s\"]", nodePtr->name, textPtr);
-        xmlFree(textPtr);
-      }
-      else {
-        nodeName = (char*) malloc((strlen((char*) nodePtr->name) + 1) * sizeof(char));
-        strcpy(nodeName, (char*) nodePtr->name);
-      }
+  /* readers share the memo */
+  if (document->threadSafety) {
+    tixiMutexLock(&document->threadSafety->mutex);
+  }
 
-      tmpText = (char*) malloc((strlen(generatedXPath) + 1) * sizeof(char));
-      strcpy(tmpText, generatedXPath);
-      free(generatedXPath);
-      generatedXPath = (char*) malloc((strlen(tmpText) + strlen(nodeName) + 2) * sizeof(char));     // + slash + null
-      sprintf(generatedXPath, "/%s%s", nodeName, tmpText);
-      free(tmpText);
-      free(nodeName);
+  if (generatePathInMemo(document, aNodePtr) == SUCCESS) {
+    TixiPathMemo* memo = document->pathMemo;
+    length = memo->depth > 0 ? memo->ends[memo->depth - 1] : 0;
+    textPtr = (char*) allocateFromMemoryArenaUnlocked(document, length + 1);
+    if (textPtr) {
+      memcpy(textPtr, memo->path, length);
+      textPtr[length] = '\0';
     }
-    nodePtr = nodePtr->parent;
   }
 
-  addToMemoryList(document, (void*) generatedXPath);
-  return generatedXPath;
+  if (document->threadSafety) {
+    tixiMutexUnlock(&document->threadSafety->mutex);
+  }
+
+  if (!textPtr) {
+    printMsg(MESSAGETYPE_ERROR, "Error: Could not allocate memory for the result.\n");
+  }
+  return textPtr;
 }
 
 int isParent(xmlNodePtr possibleParent, xmlNodePtr n)
@@ -58,23 +58,37 @@ typedef enum {
   MEMORY_ALLOCATION_FAILED
 } InternalReturnCode;
 
+typedef enum {
+  LOCK_SHARED,    /**< for functions reading the document */
+  LOCK_EXCLUSIVE  /**< for functions modifying the document */
+} DocumentLockMode;
+
 /**
- * @brief Adds documents to list of managed documents.
+ * @brief Adds documents to the table of managed documents.
  *
+ * The returned handle encodes the slot of the document and the generation
+ * of the slot. Both are checked by getDocument in constant time.
  *
- * @param document pointer to the document to be added to the list of managed documents
+ * @param document pointer to the document to be added to the table of managed documents
+ * @param handle (out) handle to the document
  *
- * @return handle to the document
+ * @return
+ *   - SUCESS
+ *   - MEMORY_ALLOCATION_FAILED if the table could not be enlarged
  */
 TIXI_INTERNAL_EXPORT InternalReturnCode addDocumentToList(TixiDocument* document, TixiDocumentHandle* handle);
 
 /**
- * @brief Removes document from the list of managed documents.
+ * @brief Removes document from the table of managed documents.
  *
+ * The handle and all its copies become invalid, even if the slot
+ * is reused for another document later.
  *
- * @param document pointer to the document to be added to the list of managed documents
+ * @param handle handle of the document to be removed
  *
- * @return error code
+ * @return
+ *   - SUCCESS
+ *   - FAILED if the handle is invalid
  */
 TIXI_INTERNAL_EXPORT ReturnCode removeDocumentFromList(TixiDocumentHandle handle);
 
@@ -84,24 +98,144 @@ TIXI_INTERNAL_EXPORT ReturnCode removeDocumentFromList(TixiDocumentHandle handle
  *
  * @param (in) handle
  *
- * @return handle to the document or NULL if handle not in the list
+ * @return the document or NULL if the handle is invalid or stale
+ *
+ * The lookup does not lock and may run concurrently to adding and
+ * removing other documents.
  */
 TIXI_INTERNAL_EXPORT TixiDocument* getDocument(TixiDocumentHandle handle);
 
 /**
- @brief Adds pointer to memory allcoated by libxml to list of managed memory.
+ * @brief Returns the number of slots of the document table, that have been used so far.
+ */
+TIXI_INTERNAL_EXPORT int getDocumentSlotCount();
 
- @param (in) memory pointer to the memory location
+/**
+ * @brief Returns the document stored in the slot or NULL, if the slot is free.
+ *
+ * @param index (in) slot index, 0 <= index < getDocumentSlotCount()
  */
-TIXI_INTERNAL_EXPORT InternalReturnCode addToMemoryList(TixiDocument* document, void* memory);
+TIXI_INTERNAL_EXPORT TixiDocument* getDocumentInSlot(int index);
 
 /**
-  @brief Frees all memory locations pointed to by the pointers in the list
-         and removes all list entries.
+ * @brief Switches the document into thread safe mode.
+ *
+ * Must not be called while other threads use the document.
+ */
+TIXI_INTERNAL_EXPORT InternalReturnCode enableThreadSafety(TixiDocument* document);
+
+/**
+ * @brief Leaves the thread safe mode and frees the contexts of all threads.
+ *
+ * Must not be called while other threads use the document.
+ */
+TIXI_INTERNAL_EXPORT void disableThreadSafety(TixiDocument* document);
+
+/**
+ * @brief Locks a thread safe document. Does nothing, if document is NULL or not thread safe.
+ *
+ * The lock is recursive, but a thread holding the lock shared must not lock it exclusively.
+ */
+TIXI_INTERNAL_EXPORT void lockDocument(TixiDocument* document, DocumentLockMode mode);
+
+/**
+ * @brief Releases a lock acquired by lockDocument with the same mode.
+ */
+TIXI_INTERNAL_EXPORT void unlockDocument(TixiDocument* document, DocumentLockMode mode);
+
+/**
+ * @brief Returns the XPath context to be used by the calling thread.
+ *
+ * In thread safe mode, each thread evaluates expressions in its own context.
+ * The context is created on first use, which may fail with NULL.
+ */
+TIXI_INTERNAL_EXPORT xmlXPathContextPtr getXPathContext(TixiDocument* document);
+
+/**
+ * @brief Returns the XPath cache to be used by the calling thread.
+ */
+TIXI_INTERNAL_EXPORT XPathCache* getXPathCache(TixiDocument* document);
+
+/**
+ * @brief Increments the generation of the document, which invalidates all results cached for it.
+ *
+ * Has to be called by every function modifying the document tree or the registered namespaces.
+ */
+TIXI_INTERNAL_EXPORT void markDocumentModified(TixiDocument* document);
+
+/**
+ * @brief Enables or disables the XPath caches of all threads.
+ */
+TIXI_INTERNAL_EXPORT void setXPathCachesEnabled(TixiDocument* document, int enabled);
+
+/**
+ * @brief Registers the namespaces of the document XPath context in the contexts of all threads.
+ */
+TIXI_INTERNAL_EXPORT void updateThreadNamespaces(TixiDocument* document);
+
+/**
+ @brief Allocates memory, that is returned to the user and owned by the document.
+
+ The memory is taken from the arena of the document and stays valid until the
+ document is closed or the arena is cleared.
+
+ @param document (in) a pointer to a TixiDocument structure
+ @param size (in) number of bytes to allocate
+ @return pointer to the memory or NULL, if the allocation failed
+ */
+TIXI_INTERNAL_EXPORT void* allocateFromMemoryArena(TixiDocument* document, size_t size);
+
+/**
+ @brief Copies a string into the arena of the document.
+
+ @param document (in) a pointer to a TixiDocument structure
+ @param string (in) the string to copy
+ @return pointer to the copy or NULL, if the allocation failed
+ */
+TIXI_INTERNAL_EXPORT char* copyToMemoryArena(TixiDocument* document, const char* string);
+
+/**
+ @brief Copies a string into a buffer provided by the user.
+
+ If the buffer is too small, the string is truncated. Unless bufferSize is zero,
+ the buffer is always null terminated.
+
+ @param string (in) the string to copy
+ @param buffer (out) the buffer of the user, may be NULL if bufferSize is zero
+ @param bufferSize (in) size of the buffer in bytes
+ @param neededSize (out) size of the complete string including the terminating null character, may be NULL
+ @return
+   - SUCCESS if the complete string has been copied
+   - STRING_TRUNCATED if the buffer is too small
+   - FAILED if the buffer is NULL or bufferSize is negative
+ */
+TIXI_INTERNAL_EXPORT ReturnCode copyToBuffer(const char* string, char* buffer, int bufferSize, int* neededSize);
+
+/**
+  @brief Frees all memory handed out by the arena of the document and discards all memory scopes.
+
+  @param document (in) a pointer to a TixiDocument structure
+ */
+TIXI_INTERNAL_EXPORT void clearMemoryArena(TixiDocument* document);
+
+/**
+  @brief Opens a memory scope, that records the current fill state of the arena.
 
   @param document (in) a pointer to a TixiDocument structure
+  @return
+    - SUCESS
+    - MEMORY_ALLOCATION_FAILED
  */
-TIXI_INTERNAL_EXPORT InternalReturnCode clearMemoryList(TixiDocument* document);
+TIXI_INTERNAL_EXPORT InternalReturnCode pushMemoryScope(TixiDocument* document);
+
+/**
+  @brief Closes the innermost memory scope and frees all memory handed out by
+         the arena since the scope was opened.
+
+  @param document (in) a pointer to a TixiDocument structure
+  @return 1 if a scope was closed, 0 if no scope was open
+ */
+TIXI_INTERNAL_EXPORT int popMemoryScope(TixiDocument* document);
 
 /**
   @brief Frees the memory used by the document
@@ -114,7 +248,7 @@ TIXI_INTERNAL_EXPORT void freeTixiDocument(TixiDocument* document);
 /**
   @brief Checks if the given element path is valid
 
-  @param xpathContext (in) pointer to an libxml2 xpath context
+  @param document (in) pointer to the TiXI document
   @param elementPath (in) path to the element to be check
   @param element (out) pointer to the XML-node pointed to be element path
   @return
@@ -124,13 +258,21 @@ TIXI_INTERNAL_EXPORT void freeTixiDocument(TixiDocument* document);
     - ELEMENT_NOT_FOUND
     - NOT_AN_ELEMENT
  */
-TIXI_INTERNAL_EXPORT ReturnCode checkElement(const xmlXPathContextPtr xpathContext, const char* elementPath, xmlNodePtr* element);
+TIXI_INTERNAL_EXPORT ReturnCode checkElement(TixiDocument* document, const char* elementPath, xmlNodePtr* element);
+
+/**
+  @brief Same as checkElement, but a relative element path is resolved starting from contextNode.
+
+  An empty element path refers to contextNode itself. If contextNode is NULL, this is equal to checkElement.
+ */
+TIXI_INTERNAL_EXPORT ReturnCode checkElementAt(TixiDocument* document, xmlNodePtr contextNode, const char* elementPath,
+                                               xmlNodePtr* element);
 
 
 /**
   @brief Checks if the given element or attribute path exists
 
-  @param xpathContext (in) pointer to an xpath context
+  @param document (in) pointer to the TiXI document
   @param nodePath (in) path to the element or attribute to be check
   @param node (out) pointer to the node pointed to by nodePath
   @param xpathObject (out) libxml2 internal object pointer. Has to be freed by the caller.
@@ -140,7 +282,7 @@ TIXI_INTERNAL_EXPORT ReturnCode checkElement(const xmlXPathContextPtr xpathConte
     - INVALID_XPATH
     - ELEMENT_NOT_FOUND
  */
-TIXI_INTERNAL_EXPORT ReturnCode checkExistence(const xmlXPathContextPtr xpathContext, const char* nodePath, xmlXPathObjectPtr* xpathObject);
+TIXI_INTERNAL_EXPORT ReturnCode checkExistence(TixiDocument* document, const char* nodePath, xmlXPathObjectPtr* xpathObject);
 
 
 /* TODO: header! */
@@ -316,7 +458,7 @@ TIXI_INTERNAL_EXPORT xmlNodePtr getParentNodeToXPath(TixiDocumentHandle handle,
   to an element specified by the elementPath expression. If the
   attribute already exists its previous value is replaced by text.
 
-  @param xpathContext (in) libxml2 pointer to the xpath context.
+  @param document (in) pointer to the TiXI document.
   @param elementPath (in) a xpath to a xml element.
   @param attributeName (in) the name of the attribute to set.
   @param attributeValue (in) the value of the attribute to set.
@@ -325,7 +467,7 @@ TIXI_INTERNAL_EXPORT xmlNodePtr getParentNodeToXPath(TixiDocumentHandle handle,
     - INVALID_XML_NAME
     - SUCCESS
  */
-TIXI_INTERNAL_EXPORT ReturnCode genericAddTextAttribute(xmlXPathContextPtr xpathContext, const char* elementPath,
+TIXI_INTERNAL_EXPORT ReturnCode genericAddTextAttribute(TixiDocument* document, const char* elementPath,
                                                         const char* attributeName, const char* attributeValue);
 
 
@@ -399,6 +541,9 @@ TIXI_INTERNAL_EXPORT ReturnCode validateSchema(const TixiDocumentHandle handle,
          The memory used for the string is allocated by tixi and is must not be removed
          from the user.
 
+         The path of the last node is memoized, such that the paths of nodes sharing
+         its ancestors only generate the segments below the common ancestor.
+
   @param TixiDocument TixiDocumentHandle (in) The TIXIDocument
   @param xmlNodePtr *aNodePrt (in) NodePrt of the node to generate the XPath from
   @return ReturnCode
@@ -407,6 +552,13 @@ TIXI_INTERNAL_EXPORT ReturnCode validateSchema(const TixiDocumentHandle handle,
  */
 TIXI_INTERNAL_EXPORT char* generateXPathFromNodePtr(TixiDocumentHandle handle, xmlNodePtr aNodePrt);
 
+/**
+  @brief Frees the memo of generateXPathFromNodePtr.
+
+  @param document (in) a pointer to a TixiDocument structure
+ */
+TIXI_INTERNAL_EXPORT void freePathMemo(TixiDocument* document);
+
 
 /**
   @brief Reorders nodes of a nodeSet. The node at the position fromIndex will be put in the position toIndex.
@@ -0,0 +1,340 @@
+/*
+* Copyright (C) 2026 German Aerospace Center (DLR/SC)
+*
+* Created: 2026-10-16
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*   http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+#include "tixiThreads.h"
+
+#include <stdlib.h>
+
+/* function and argument of a thread, passed to the platform specific start routine */
+typedef struct
+{
+  TixiThreadFunction function;
+  void* argument;
+} ThreadStart;
+
+static ThreadStart* newThreadStart(TixiThreadFunction function, void* argument)
+{
+  ThreadStart* start = (ThreadStart*) malloc(sizeof(ThreadStart));
+
+  if (start) {
+    start->function = function;
+    start->argument = argument;
+  }
+  return start;
+}
+
+static void runThreadStart(ThreadStart* start)
+{
+  ThreadStart copy = *start;
+
+  free(start);
+  copy.function(copy.argument);
+}
+
+#ifdef _WIN32
+
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+
+void tixiMutexInit(TixiMutex* mutex)
+{
+  InitializeSRWLock((PSRWLOCK) mutex);
+}
+
+void tixiMutexDestroy(TixiMutex* mutex)
+{
+  /* slim reader/writer locks don't hold any resources */
+  (void) mutex;
+}
+
+void tixiMutexLock(TixiMutex* mutex)
+{
+  AcquireSRWLockExclusive((PSRWLOCK) mutex);
+}
+
+void tixiMutexUnlock(TixiMutex* mutex)
+{
+  ReleaseSRWLockExclusive((PSRWLOCK) mutex);
+}
+
+static void conditionInit(TixiCondition* condition)
+{
+  InitializeConditionVariable((PCONDITION_VARIABLE) condition);
+}
+
+static void conditionDestroy(TixiCondition* condition)
+{
+  (void) condition;
+}
+
+static void conditionWait(TixiCondition* condition, TixiMutex* mutex)
+{
+  SleepConditionVariableSRW((PCONDITION_VARIABLE) condition, (PSRWLOCK) mutex, INFINITE, 0);
+}
+
+static void conditionBroadcast(TixiCondition* condition)
+{
+  WakeAllConditionVariable((PCONDITION_VARIABLE) condition);
+}
+
+static DWORD WINAPI threadMain(LPVOID start)
+{
+  runThreadStart((ThreadStart*) start);
+  return 0;
+}
+
+int tixiThreadCreate(TixiThread* thread, TixiThreadFunction function, void* argument)
+{
+  ThreadStart* start = newThreadStart(function, argument);
+
+  if (!start) {
+    return -1;
+  }
+  *thread = CreateThread(NULL, 0, threadMain, start, 0, NULL);
+  if (!*thread) {
+    free(start);
+    return -1;
+  }
+  return 0;
+}
+
+void tixiThreadJoin(TixiThread thread)
+{
+  WaitForSingleObject((HANDLE) thread, INFINITE);
+  CloseHandle((HANDLE) thread);
+}
+
+TixiThreadId tixiCurrentThread()
+{
+  return GetCurrentThreadId();
+}
+
+int tixiIsCurrentThread(TixiThreadId thread)
+{
+  return thread == GetCurrentThreadId();
+}
+
+/* aligned loads and stores are atomic on windows, the barriers
+ * prevent reordering by the compiler and the cpu */
+void* tixiAtomicLoadPtr(void* const* ptr)
+{
+  void* value = *(void* const volatile*) ptr;
+  MemoryBarrier();
+  return value;
+}
+
+void tixiAtomicStorePtr(void** ptr, void* value)
+{
+  MemoryBarrier();
+  *(void* volatile*) ptr = value;
+}
+
+int tixiAtomicLoadInt(const int* ptr)
+{
+  int value = *(const volatile int*) ptr;
+  MemoryBarrier();
+  return value;
+}
+
+void tixiAtomicStoreInt(int* ptr, int value)
+{
+  MemoryBarrier();
+  *(volatile int*) ptr = value;
+}
+
+#else
+
+void tixiMutexInit(TixiMutex* mutex)
+{
+  pthread_mutex_init(mutex, NULL);
+}
+
+void tixiMutexDestroy(TixiMutex* mutex)
+{
+  pthread_mutex_destroy(mutex);
+}
+
+void tixiMutexLock(TixiMutex* mutex)
+{
+  pthread_mutex_lock(mutex);
+}
+
+void tixiMutexUnlock(TixiMutex* mutex)
+{
+  pthread_mutex_unlock(mutex);
+}
+
+static void conditionInit(TixiCondition* condition)
+{
+  pthread_cond_init(condition, NULL);
+}
+
+static void conditionDestroy(TixiCondition* condition)
+{
+  pthread_cond_destroy(condition);
+}
+
+static void conditionWait(TixiCondition* condition, TixiMutex* mutex)
+{
+  pthread_cond_wait(condition, mutex);
+}
+
+static void conditionBroadcast(TixiCondition* condition)
+{
+  pthread_cond_broadcast(condition);
+}
+
+static void* threadMain(void* start)
+{
+  runThreadStart((ThreadStart*) start);
+  return NULL;
+}
+
+int tixiThreadCreate(TixiThread* thread, TixiThreadFunction function, void* argument)
+{
+  ThreadStart* start = newThreadStart(function, argument);
+
+  if (!start) {
+    return -1;
+  }
+  if (pthread_create(thread, NULL, threadMain, start) != 0) {
+    free(start);
+    return -1;
+  }
+  return 0;
+}
+
+void tixiThreadJoin(TixiThread thread)
+{
+  pthread_join(thread, NULL);
+}
+
+TixiThreadId tixiCurrentThread()
+{
+  return pthread_self();
+}
+
+int tixiIsCurrentThread(TixiThreadId thread)
+{
+  return pthread_equal(thread, pthread_self()) != 0;
+}
+
+void* tixiAtomicLoadPtr(void* const* ptr)
+{
+  return __atomic_load_n(ptr, __ATOMIC_ACQUIRE);
+}
+
+void tixiAtomicStorePtr(void** ptr, void* value)
+{
+  __atomic_store_n(ptr, value, __ATOMIC_RELEASE);
+}
+
+int tixiAtomicLoadInt(const int* ptr)
+{
+  return __atomic_load_n(ptr, __ATOMIC_ACQUIRE);
+}
+
+void tixiAtomicStoreInt(int* ptr, int value)
+{
+  __atomic_store_n(ptr, value, __ATOMIC_RELEASE);
+}
+
+#endif
+
+
+void tixiRWLockInit(TixiRWLock* lock)
+{
+  tixiMutexInit(&lock->mutex);
+  conditionInit(&lock->released);
+  lock->readers = 0;
+  lock->writersWaiting = 0;
+  lock->writerDepth = 0;
+}
+
+void tixiRWLockDestroy(TixiRWLock* lock)
+{
+  conditionDestroy(&lock->released);
+  tixiMutexDestroy(&lock->mutex);
+}
+
+/* returns 1, if the calling thread holds the exclusive lock. The mutex must be locked. */
+static int ownsExclusiveLock(const TixiRWLock* lock)
+{
+  return lock->writerDepth > 0 && tixiIsCurrentThread(lock->writer);
+}
+
+void tixiRWLockShared(TixiRWLock* lock)
+{
+  tixiMutexLock(&lock->mutex);
+  if (ownsExclusiveLock(lock)) {
+    /* nested in an exclusive lock of this thread */
+    lock->writerDepth++;
+  }
+  else {
+    while (lock->writerDepth > 0 || lock->writersWaiting > 0) {
+      conditionWait(&lock->released, &lock->mutex);
+    }
+    lock->readers++;
+  }
+  tixiMutexUnlock(&lock->mutex);
+}
+
+void tixiRWUnlockShared(TixiRWLock* lock)
+{
+  tixiMutexLock(&lock->mutex);
+  if (ownsExclusiveLock(lock)) {
+    lock->writerDepth--;
+  }
+  else {
+    lock->readers--;
+    if (lock->readers == 0) {
+      conditionBroadcast(&lock->released);
+    }
+  }
+  tixiMutexUnlock(&lock->mutex);
+}
+
+void tixiRWLockExclusive(TixiRWLock* lock)
+{
+  tixiMutexLock(&lock->mutex);
+  if (ownsExclusiveLock(lock)) {
+    lock->writerDepth++;
+  }
+  else {
+    lock->writersWaiting++;
+    while (lock->readers > 0 || lock->writerDepth > 0) {
+      conditionWait(&lock->released, &lock->mutex);
+    }
+    lock->writersWaiting--;
+    lock->writer = tixiCurrentThread();
+    lock->writerDepth = 1;
+  }
+  tixiMutexUnlock(&lock->mutex);
+}
+
+void tixiRWUnlockExclusive(TixiRWLock* lock)
+{
+  tixiMutexLock(&lock->mutex);
+  lock->writerDepth--;
+  if (lock->writerDepth == 0) {
+    conditionBroadcast(&lock->released);
+  }
+  tixiMutexUnlock(&lock->mutex);
+}
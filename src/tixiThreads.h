@@ -0,0 +1,188 @@
+/*
+* Copyright (C) 2026 German Aerospace Center (DLR/SC)
+*
+* Created: 2026-10-16
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*   http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+#ifndef TIXI_THREADS_H
+#define TIXI_THREADS_H
+
+#ifndef _WIN32
+  #include <pthread.h>
+#endif
+
+#ifndef TIXI_INTERNAL_EXPORT
+#if defined(WIN32)
+#if defined (tixi3_EXPORTS)
+#define TIXI_INTERNAL_EXPORT __declspec (dllexport)
+#else
+#define TIXI_INTERNAL_EXPORT
+#endif
+#else
+#define TIXI_INTERNAL_EXPORT
+#endif
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @file   tixiThreads.h
+ * @brief  Thin portability layer for the synchronization primitives used by TiXI.
+ *
+ * Windows uses slim reader/writer locks, all other platforms use pthreads.
+ * To keep windows.h out of the headers, the windows lock is stored in a
+ * pointer sized struct that is layout compatible with SRWLOCK.
+ */
+
+#ifdef _WIN32
+typedef struct { void* ptr; } TixiMutex;
+#define TIXI_MUTEX_INITIALIZER {0}
+typedef struct { void* ptr; } TixiCondition;
+typedef unsigned long TixiThreadId;
+#else
+typedef pthread_mutex_t TixiMutex;
+#define TIXI_MUTEX_INITIALIZER PTHREAD_MUTEX_INITIALIZER
+typedef pthread_cond_t TixiCondition;
+typedef pthread_t TixiThreadId;
+#endif
+
+#ifdef _WIN32
+typedef void* TixiThread;
+#else
+typedef pthread_t TixiThread;
+#endif
+
+/**
+ * @brief Function run by a thread started with tixiThreadCreate.
+ */
+typedef void (*TixiThreadFunction)(void* argument);
+
+/**
+ * @brief Reader/writer lock, that may be acquired recursively.
+ *
+ * A thread holding the exclusive lock may acquire the lock again, either shared
+ * or exclusive. Waiting writers block new readers, so that writers are not starved.
+ * Hence, a thread holding the shared lock must neither acquire it again nor
+ * acquire it exclusively. Callers have to track nested shared locking themselves.
+ */
+typedef struct
+{
+  TixiMutex mutex;          /**< Guards the members of the lock */
+  TixiCondition released;   /**< Signaled when the lock has been released */
+  int readers;              /**< Number of shared locks held */
+  int writersWaiting;       /**< Number of threads waiting for the exclusive lock */
+  int writerDepth;          /**< Recursion depth of the exclusive lock, 0 if not locked exclusively */
+  TixiThreadId writer;      /**< Thread holding the exclusive lock, only valid if writerDepth > 0 */
+} TixiRWLock;
+
+/**
+  @brief Initializes a mutex, that is not statically initialized by TIXI_MUTEX_INITIALIZER.
+ */
+TIXI_INTERNAL_EXPORT void tixiMutexInit(TixiMutex* mutex);
+
+/**
+  @brief Frees the resources of a mutex initialized by tixiMutexInit.
+ */
+TIXI_INTERNAL_EXPORT void tixiMutexDestroy(TixiMutex* mutex);
+
+/**
+  @brief Locks the mutex. Mutexes are not recursive.
+ */
+TIXI_INTERNAL_EXPORT void tixiMutexLock(TixiMutex* mutex);
+
+/**
+  @brief Unlocks a mutex, that has been locked by the calling thread.
+ */
+TIXI_INTERNAL_EXPORT void tixiMutexUnlock(TixiMutex* mutex);
+
+/**
+  @brief Starts a thread running function(argument).
+
+  @return 0 if the thread has been started, -1 otherwise
+ */
+TIXI_INTERNAL_EXPORT int tixiThreadCreate(TixiThread* thread, TixiThreadFunction function, void* argument);
+
+/**
+  @brief Waits for a thread started by tixiThreadCreate to finish and frees its resources.
+ */
+TIXI_INTERNAL_EXPORT void tixiThreadJoin(TixiThread thread);
+
+/**
+  @brief Initializes a reader/writer lock.
+ */
+TIXI_INTERNAL_EXPORT void tixiRWLockInit(TixiRWLock* lock);
+
+/**
+  @brief Frees the resources of a reader/writer lock. The lock must not be held.
+ */
+TIXI_INTERNAL_EXPORT void tixiRWLockDestroy(TixiRWLock* lock);
+
+/**
+  @brief Acquires the lock for reading.
+ */
+TIXI_INTERNAL_EXPORT void tixiRWLockShared(TixiRWLock* lock);
+
+/**
+  @brief Releases a lock acquired by tixiRWLockShared.
+ */
+TIXI_INTERNAL_EXPORT void tixiRWUnlockShared(TixiRWLock* lock);
+
+/**
+  @brief Acquires the lock for writing.
+ */
+TIXI_INTERNAL_EXPORT void tixiRWLockExclusive(TixiRWLock* lock);
+
+/**
+  @brief Releases a lock acquired by tixiRWLockExclusive.
+ */
+TIXI_INTERNAL_EXPORT void tixiRWUnlockExclusive(TixiRWLock* lock);
+
+/**
+  @brief Returns the identifier of the calling thread.
+ */
+TIXI_INTERNAL_EXPORT TixiThreadId tixiCurrentThread();
+
+/**
+  @brief Returns 1, if the identifier belongs to the calling thread, 0 otherwise.
+ */
+TIXI_INTERNAL_EXPORT int tixiIsCurrentThread(TixiThreadId thread);
+
+/**
+  @brief Loads a pointer with acquire semantics.
+ */
+TIXI_INTERNAL_EXPORT void* tixiAtomicLoadPtr(void* const* ptr);
+
+/**
+  @brief Stores a pointer with release semantics.
+ */
+TIXI_INTERNAL_EXPORT void tixiAtomicStorePtr(void** ptr, void* value);
+
+/**
+  @brief Loads an integer with acquire semantics.
+ */
+TIXI_INTERNAL_EXPORT int tixiAtomicLoadInt(const int* ptr);
+
+/**
+  @brief Stores an integer with release semantics.
+ */
+TIXI_INTERNAL_EXPORT void tixiAtomicStoreInt(int* ptr, int value);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TIXI_THREADS_H */
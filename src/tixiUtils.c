@@ -434,3 +434,26 @@ void trim_trailing_whitespace(char *str)
         str[i+1]= '\0';
     }
 }
+
+char* string_tokenize(char* str, const char* delimiters, char** saveptr)
+{
+  char* token = NULL;
+
+  if (str == NULL) {
+    str = *saveptr;
+  }
+
+  str += strspn(str, delimiters);
+  if (*str == '\0') {
+    *saveptr = str;
+    return NULL;
+  }
+
+  token = str;
+  str += strcspn(str, delimiters);
+  if (*str != '\0') {
+    *str++ = '\0';
+  }
+  *saveptr = str;
+  return token;
+}
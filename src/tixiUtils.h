@@ -188,6 +188,17 @@ TIXI_INTERNAL_EXPORT int isNumeric (const char * s);
  */
 TIXI_INTERNAL_EXPORT void trim_trailing_whitespace(char * str);
 
+/**
+  @brief Reentrant replacement of strtok, that keeps its position in <[saveptr]>
+  instead of a static variable.
+  @param char str (in)         The string to split, NULL to continue with the last string
+  @param char delimiters (in)  The separating characters
+  @param char saveptr (inout)  Position of the next token
+  @return
+    the next token or NULL, if there are no more tokens
+ */
+TIXI_INTERNAL_EXPORT char* string_tokenize(char* str, const char* delimiters, char** saveptr);
+
 /**
   @brief Strips the first len bytes of the string.
   @param char string (in)  The source string
@@ -17,195 +17,913 @@
 */
 #include "uidHelper.h"
 #include "tixiInternal.h"
+#include "libxml/xpathInternals.h"
 #include <stdlib.h>
+#include <string.h>
 
 extern void printMsg(MessageType type, const char* message, ...);
 
-int uid_readDocumentUIDs(TixiDocument* tixiDocument)
+
+/* returns the attribute without namespace of an element, NULL if the element has no such attribute */
+static xmlAttrPtr getAttribute(xmlNodePtr element, const char* name)
 {
-  xmlXPathObjectPtr xpathObj;
+  xmlAttrPtr attribute;
 
-  /* Evaluate xpath expression */
-  xpathObj = xmlXPathEvalExpression((xmlChar*) CPACS_UID_XPATH, tixiDocument->xpathContext);
-  if (xpathObj == NULL) {
-    printMsg(MESSAGETYPE_ERROR,"Error: unable to evaluate xpath expression \"%s\"\n", CPACS_UID_XPATH);
-    return(FAILED);
+  if (element->type != XML_ELEMENT_NODE) {
+    return NULL;
   }
 
-  /* Build List of results */
-  if (uid_buildUIDNodeList(tixiDocument, xpathObj->nodesetval) != SUCCESS) {
-    return FAILED;
+  for (attribute = element->properties; attribute; attribute = attribute->next) {
+    if (attribute->ns == NULL && xmlStrEqual(attribute->name, (xmlChar*) name)) {
+      return attribute;
+    }
   }
+  return NULL;
+}
 
-  /* Cleanup */
-  xmlXPathFreeObject(xpathObj);
+/* returns the value of an attribute. The value is only copied, if it
+ * consists of several nodes. In this case, *buffer must be freed by xmlFree. */
+static const xmlChar* getAttributeValue(xmlAttrPtr attribute, xmlChar** buffer)
+{
+  xmlNodePtr text = attribute->children;
 
-  return(SUCCESS);
+  *buffer = NULL;
+  if (text == NULL) {
+    return (xmlChar*) "";
+  }
+  if (text->next == NULL && text->type == XML_TEXT_NODE && text->content) {
+    return text->content;
+  }
+  *buffer = xmlNodeListGetString(attribute->doc, text, 1);
+  return *buffer ? *buffer : (xmlChar*) "";
 }
 
+static void freeUIDEntries(void* payload, const xmlChar* uID)
+{
+  TixiUIDEntry* entry = (TixiUIDEntry*) payload;
+  (void) uID;
 
+  while (entry) {
+    TixiUIDEntry* next = entry->next;
+    free(entry);
+    entry = next;
+  }
+}
 
-int uid_buildUIDNodeList(TixiDocument* tixiDocument, xmlNodeSetPtr nodes)
+/* returns the entries of a uID or link. As the keys are interned, strings
+ * not used in the document are rejected by the dictionary. */
+static TixiUIDEntry* lookupEntries(TixiDocument* document, xmlHashTablePtr table, const xmlChar* key)
 {
-  xmlNodePtr cur;
-  int size;
-  int i;
-  TixiUIDListEntry* currentEntry;
-  size = (nodes) ? nodes->nodeNr : 0;
+  const xmlChar* interned = xmlDictExists(document->uidDict, key, -1);
 
-  tixiDocument->uidListHead = (TixiUIDListEntry *) malloc(sizeof(TixiUIDListEntry));
-  currentEntry = tixiDocument->uidListHead;
+  return interned ? (TixiUIDEntry*) xmlHashLookup(table, interned) : NULL;
+}
 
-  if (nodes->nodeNr == 0) {
-    free(tixiDocument->uidListHead);
-    tixiDocument->uidListHead = NULL;
-    return SUCCESS;
+/* appends the element to the chain of the key. Returns the length of the chain, or -1 on failure */
+static int addToChain(xmlHashTablePtr table, const xmlChar* key, xmlNodePtr element)
+{
+  TixiUIDEntry* entry = (TixiUIDEntry*) malloc(sizeof(TixiUIDEntry));
+  TixiUIDEntry* first = NULL;
+  int length = 1;
+
+  if (!entry) {
+    return -1;
+  }
+  entry->nodePtr = element;
+  entry->next = NULL;
+
+  first = (TixiUIDEntry*) xmlHashLookup(table, key);
+  if (first) {
+    /* keep the elements in the order they were added */
+    TixiUIDEntry* last = first;
+    for (length = 2; last->next; length++) {
+      last = last->next;
+    }
+    last->next = entry;
+  }
+  else if (xmlHashAddEntry(table, key, entry) != 0) {
+    free(entry);
+    return -1;
   }
+  return length;
+}
+
+/* removes the element from the chain of the key. Returns the remaining length of the chain,
+ * or -1 if the element is not in the chain */
+static int removeFromChain(xmlHashTablePtr table, const xmlChar* key, xmlNodePtr element)
+{
+  TixiUIDEntry* first = (TixiUIDEntry*) xmlHashLookup(table, key);
+  TixiUIDEntry* previous = NULL;
+  TixiUIDEntry* entry = NULL;
+  int length = 0;
+
+  for (entry = first; entry && entry->nodePtr != element; entry = entry->next) {
+    previous = entry;
+  }
+  if (!entry) {
+    return -1;
+  }
+
+  if (previous) {
+    previous->next = entry->next;
+  }
+  else if (entry->next) {
+    xmlHashUpdateEntry(table, key, entry->next, NULL);
+    first = entry->next;
+  }
+  else {
+    xmlHashRemoveEntry(table, key, NULL);
+    first = NULL;
+  }
+  free(entry);
 
-  cur = nodes->nodeTab[0];
-  currentEntry->nodePtr = cur->parent;
-  currentEntry->uIDName = (char *) xmlGetProp(cur->parent, (xmlChar *) CPACS_UID_ATTRIBUTE_STRING);
-  currentEntry->next = NULL;
+  for (entry = first; entry; entry = entry->next) {
+    length++;
+  }
+  return length;
+}
 
-  for (i = 1; i < size; ++i) {
-    cur = nodes->nodeTab[i];
+/* adds the uID and the link of the element to the tables, counting new duplicated uIDs */
+static int addElementToTables(xmlHashTablePtr uidIndex, xmlHashTablePtr linkIndex, int* uidDuplicates,
+                              xmlNodePtr element)
+{
+  xmlAttrPtr attribute = getAttribute(element, CPACS_UID_ATTRIBUTE_STRING);
+  xmlChar* buffer = NULL;
+  int length = 0;
+
+  if (attribute) {
+    const xmlChar* uID = getAttributeValue(attribute, &buffer);
+    length = addToChain(uidIndex, uID, element);
+    if (length == 2 && uID[0] != '\0') {
+      (*uidDuplicates)++;
+    }
+    xmlFree(buffer);
+    if (length < 0) {
+      return MEMORY_ALLOCATION_FAILED;
+    }
+  }
 
-    // add new uid entry
-    currentEntry->next = malloc(sizeof(TixiUIDListEntry));
-    if (!currentEntry) {
-      printMsg(MESSAGETYPE_ERROR, "Error: Memory allocation failed in uidHelper::buildUIDNodeList");
+  attribute = getAttribute(element, CPACS_UID_LINK_ATTRIBUTE_STRING);
+  if (attribute) {
+    length = addToChain(linkIndex, getAttributeValue(attribute, &buffer), element);
+    xmlFree(buffer);
+    if (length < 0) {
       return MEMORY_ALLOCATION_FAILED;
     }
-    currentEntry = (TixiUIDListEntry *) currentEntry->next;
-    currentEntry->nodePtr = cur->parent;
-    currentEntry->uIDName = (char *) xmlGetProp(cur->parent, (xmlChar *) CPACS_UID_ATTRIBUTE_STRING);
-    currentEntry->next = NULL;
   }
 
   return SUCCESS;
 }
 
-int uid_checkForDuplicates(TixiDocument *document)
+/* adds the uID and the link of the element to the indices */
+static int addElementToIndex(TixiDocument* document, xmlNodePtr element)
 {
-  int alreadyDisplayed = -1;
-  TixiUIDListEntry* currentEntry;
-  TixiUIDListEntry* compareElement;
-
-  currentEntry = document->uidListHead;
-  while (currentEntry) {
-    if (currentEntry->next) {
-      compareElement = document->uidListHead;
-      while (compareElement) {
-        if (compareElement == currentEntry) {
-          compareElement = (TixiUIDListEntry *) compareElement->next;
-          continue;
+  return addElementToTables(document->uidIndex, document->linkIndex, &document->uidDuplicates, element);
+}
+
+/* removes the uID and the link of the element from the indices */
+static void removeElementFromIndex(TixiDocument* document, xmlNodePtr element)
+{
+  xmlAttrPtr attribute = getAttribute(element, CPACS_UID_ATTRIBUTE_STRING);
+  xmlChar* buffer = NULL;
+
+  if (attribute) {
+    const xmlChar* uID = getAttributeValue(attribute, &buffer);
+    if (removeFromChain(document->uidIndex, uID, element) == 1 && uID[0] != '\0') {
+      document->uidDuplicates--;
+    }
+    xmlFree(buffer);
+  }
+
+  attribute = getAttribute(element, CPACS_UID_LINK_ATTRIBUTE_STRING);
+  if (attribute) {
+    removeFromChain(document->linkIndex, getAttributeValue(attribute, &buffer), element);
+    xmlFree(buffer);
+  }
+}
+
+static int addSubtreeToTables(xmlHashTablePtr uidIndex, xmlHashTablePtr linkIndex, int* uidDuplicates,
+                              xmlNodePtr node)
+{
+  for (; node; node = node->next) {
+    if (node->type != XML_ELEMENT_NODE) {
+      continue;
+    }
+    if (addElementToTables(uidIndex, linkIndex, uidDuplicates, node) != SUCCESS ||
+        addSubtreeToTables(uidIndex, linkIndex, uidDuplicates, node->children) != SUCCESS) {
+      return MEMORY_ALLOCATION_FAILED;
+    }
+  }
+  return SUCCESS;
+}
+
+static int addSubtreeToIndex(TixiDocument* document, xmlNodePtr node)
+{
+  return addSubtreeToTables(document->uidIndex, document->linkIndex, &document->uidDuplicates, node);
+}
+
+static void removeSubtreeFromIndex(TixiDocument* document, xmlNodePtr node)
+{
+  for (; node; node = node->next) {
+    if (node->type != XML_ELEMENT_NODE) {
+      continue;
+    }
+    removeElementFromIndex(document, node);
+    removeSubtreeFromIndex(document, node->children);
+  }
+}
+
+
+/* a subtree, or only the element itself, whose uIDs and links are indexed in parallel */
+typedef struct
+{
+  xmlNodePtr node;
+  int withDescendants;
+} IndexTask;
+
+/* contiguous range of tasks indexed by one thread into tables of its own */
+typedef struct
+{
+  int begin;
+  int end;
+  xmlHashTablePtr uidIndex;
+  xmlHashTablePtr linkIndex;
+  int error;
+} IndexGroup;
+
+/* state shared by the threads building the index */
+typedef struct
+{
+  IndexTask* tasks;
+  IndexGroup* groups;
+  int nGroups;
+  int nextGroup;       /* next group to be indexed, guarded by mutex */
+  TixiMutex mutex;
+} IndexWork;
+
+/* splits the document into at least minTasks tasks in document order, if possible,
+ * by replacing subtrees with their root element followed by the subtrees of its children */
+static int splitIntoTasks(xmlDocPtr doc, int minTasks, IndexTask** tasks, int* nTasks)
+{
+  IndexTask* current = NULL;
+  int nCurrent = 0;
+  xmlNodePtr node = NULL;
+
+  for (node = doc->children; node; node = node->next) {
+    nCurrent += node->type == XML_ELEMENT_NODE;
+  }
+  current = (IndexTask*) malloc((nCurrent > 0 ? nCurrent : 1) * sizeof(IndexTask));
+  if (!current) {
+    return MEMORY_ALLOCATION_FAILED;
+  }
+  nCurrent = 0;
+  for (node = doc->children; node; node = node->next) {
+    if (node->type == XML_ELEMENT_NODE) {
+      current[nCurrent].node = node;
+      current[nCurrent].withDescendants = 1;
+      nCurrent++;
+    }
+  }
+
+  while (nCurrent < minTasks) {
+    IndexTask* next = NULL;
+    int nNext = 0;
+    int i = 0;
+
+    for (i = 0; i < nCurrent; i++) {
+      nNext++;
+      if (current[i].withDescendants) {
+        for (node = current[i].node->children; node; node = node->next) {
+          nNext += node->type == XML_ELEMENT_NODE;
         }
-        if (!strcmp("", currentEntry->uIDName)) {
-          // if we found an emtpy uid, we only warn about that.
-          if (alreadyDisplayed) {
-            printMsg(MESSAGETYPE_WARNING, "Warning: Empty uID found! This might lead to unknown errors!\n");
+      }
+    }
+    if (nNext == nCurrent) {
+      /* only leaves left */
+      break;
+    }
+
+    next = (IndexTask*) malloc(nNext * sizeof(IndexTask));
+    if (!next) {
+      free(current);
+      return MEMORY_ALLOCATION_FAILED;
+    }
+    nNext = 0;
+    for (i = 0; i < nCurrent; i++) {
+      next[nNext].node = current[i].node;
+      next[nNext].withDescendants = 0;
+      nNext++;
+      if (current[i].withDescendants) {
+        for (node = current[i].node->children; node; node = node->next) {
+          if (node->type == XML_ELEMENT_NODE) {
+            next[nNext].node = node;
+            next[nNext].withDescendants = 1;
+            nNext++;
           }
-          alreadyDisplayed=0;
         }
-        else if (!strcmp(compareElement->uIDName, currentEntry->uIDName)) {
-          printMsg(MESSAGETYPE_ERROR, "Error: duplicated uID '%s' found!\n", currentEntry->uIDName);
-          return FAILED;
-        }
-        compareElement = (TixiUIDListEntry *) compareElement->next;
       }
     }
-    currentEntry = (TixiUIDListEntry *) currentEntry->next;
+    free(current);
+    current = next;
+    nCurrent = nNext;
+  }
+
+  *tasks = current;
+  *nTasks = nCurrent;
+  return SUCCESS;
+}
+
+static void indexGroup(const IndexWork* work, IndexGroup* group)
+{
+  int duplicates = 0;
+  int i = 0;
+
+  group->uidIndex = xmlHashCreate(0);
+  group->linkIndex = xmlHashCreate(0);
+  if (!group->uidIndex || !group->linkIndex) {
+    group->error = MEMORY_ALLOCATION_FAILED;
+    return;
+  }
+
+  for (i = group->begin; i < group->end && group->error == SUCCESS; i++) {
+    IndexTask* task = &work->tasks[i];
+    group->error = addElementToTables(group->uidIndex, group->linkIndex, &duplicates, task->node);
+    if (group->error == SUCCESS && task->withDescendants) {
+      group->error = addSubtreeToTables(group->uidIndex, group->linkIndex, &duplicates, task->node->children);
+    }
+  }
+}
+
+static void indexGroups(void* argument)
+{
+  IndexWork* work = (IndexWork*) argument;
+
+  for (;;) {
+    int group = 0;
+
+    tixiMutexLock(&work->mutex);
+    group = work->nextGroup++;
+    tixiMutexUnlock(&work->mutex);
+
+    if (group >= work->nGroups) {
+      return;
+    }
+    indexGroup(work, &work->groups[group]);
+  }
+}
+
+/* target of merging the tables of a group into the index of the document */
+typedef struct
+{
+  xmlHashTablePtr table;
+  int* uidDuplicates;  /* counts new duplicated uIDs, NULL for the links */
+  int error;
+} IndexMerge;
+
+/* appends a chain of a group to the chain of the same key in the document */
+static void mergeChain(void* payload, void* data, const xmlChar* key)
+{
+  TixiUIDEntry* chain = (TixiUIDEntry*) payload;
+  IndexMerge* merge = (IndexMerge*) data;
+  TixiUIDEntry* first = (TixiUIDEntry*) xmlHashLookup(merge->table, key);
+  TixiUIDEntry* last = first;
+  int length = 0;
+
+  if (!first) {
+    if (xmlHashAddEntry(merge->table, key, chain) != 0) {
+      freeUIDEntries(chain, key);
+      merge->error = MEMORY_ALLOCATION_FAILED;
+      return;
+    }
+  }
+  else {
+    /* the groups are merged in document order */
+    for (length = 1; last->next; length++) {
+      last = last->next;
+    }
+    last->next = chain;
+  }
+
+  if (merge->uidDuplicates && key[0] != '\0' && length < 2) {
+    for (; chain && length < 2; chain = chain->next) {
+      length++;
+    }
+    if (length >= 2) {
+      (*merge->uidDuplicates)++;
+    }
+  }
+}
+
+/* moves the entries of the group tables into the document and frees the tables */
+static int mergeGroup(TixiDocument* document, IndexGroup* group)
+{
+  IndexMerge uids = {NULL, NULL, SUCCESS};
+  IndexMerge links = {NULL, NULL, SUCCESS};
+
+  uids.table = document->uidIndex;
+  uids.uidDuplicates = &document->uidDuplicates;
+  links.table = document->linkIndex;
+
+  if (group->error == SUCCESS) {
+    xmlHashScan(group->uidIndex, mergeChain, &uids);
+    xmlHashScan(group->linkIndex, mergeChain, &links);
+    xmlHashFree(group->uidIndex, NULL);
+    xmlHashFree(group->linkIndex, NULL);
+  }
+  else {
+    xmlHashFree(group->uidIndex, freeUIDEntries);
+    xmlHashFree(group->linkIndex, freeUIDEntries);
+  }
+  group->uidIndex = NULL;
+  group->linkIndex = NULL;
+
+  if (group->error != SUCCESS) {
+    return group->error;
+  }
+  return uids.error != SUCCESS ? uids.error : links.error;
+}
+
+/* builds the index of the document with the given number of threads, including the calling thread */
+static int buildIndexInParallel(TixiDocument* document, int nThreads)
+{
+  IndexWork work;
+  TixiThread* threads = NULL;
+  int nTasks = 0;
+  int nStarted = 0;
+  int error = SUCCESS;
+  int i = 0;
+
+  /* the task and group counts below must not overflow */
+  if (nThreads > UID_MAX_CHECK_THREADS) {
+    nThreads = UID_MAX_CHECK_THREADS;
+  }
+
+  /* several groups per thread balance subtrees of different size */
+  error = splitIntoTasks(document->docPtr, 8 * nThreads, &work.tasks, &nTasks);
+  if (error != SUCCESS) {
+    return error;
+  }
+  work.nGroups = nTasks < 4 * nThreads ? nTasks : 4 * nThreads;
+  work.nextGroup = 0;
+  work.groups = (IndexGroup*) calloc(work.nGroups > 0 ? work.nGroups : 1, sizeof(IndexGroup));
+  threads = (TixiThread*) malloc((size_t) nThreads * sizeof(TixiThread));
+  if (!work.groups || !threads) {
+    free(work.tasks);
+    free(work.groups);
+    free(threads);
+    return MEMORY_ALLOCATION_FAILED;
+  }
+  for (i = 0; i < work.nGroups; i++) {
+    work.groups[i].begin = (int) ((long long) nTasks * i / work.nGroups);
+    work.groups[i].end = (int) ((long long) nTasks * (i + 1) / work.nGroups);
+    work.groups[i].error = SUCCESS;
+  }
+  tixiMutexInit(&work.mutex);
+
+  /* if a thread can't be started, the others do its work */
+  for (nStarted = 0; nStarted < nThreads - 1 && nStarted < work.nGroups - 1; nStarted++) {
+    if (tixiThreadCreate(&threads[nStarted], indexGroups, &work) != 0) {
+      break;
+    }
+  }
+  indexGroups(&work);
+  for (i = 0; i < nStarted; i++) {
+    tixiThreadJoin(threads[i]);
+  }
+  tixiMutexDestroy(&work.mutex);
+
+  for (i = 0; i < work.nGroups; i++) {
+    int groupError = mergeGroup(document, &work.groups[i]);
+    if (error == SUCCESS) {
+      error = groupError;
+    }
+  }
+
+  free(work.tasks);
+  free(work.groups);
+  free(threads);
+  return error;
+}
+
+
+int uid_readDocumentUIDs(TixiDocument* tixiDocument)
+{
+  int error = SUCCESS;
+
+  if (tixiDocument->uidIndex) {
+    return SUCCESS;
+  }
+
+  /* uIDs and links share the interned strings */
+  tixiDocument->uidDict = xmlDictCreate();
+  tixiDocument->uidIndex = tixiDocument->uidDict ? xmlHashCreateDict(0, tixiDocument->uidDict) : NULL;
+  tixiDocument->linkIndex = tixiDocument->uidDict ? xmlHashCreateDict(0, tixiDocument->uidDict) : NULL;
+  tixiDocument->uidDuplicates = 0;
+  if (!tixiDocument->uidIndex || !tixiDocument->linkIndex) {
+    printMsg(MESSAGETYPE_ERROR, "Error: Memory allocation failed in uidHelper::readDocumentUIDs");
+    uid_clearIndex(tixiDocument);
+    return MEMORY_ALLOCATION_FAILED;
   }
+
+  if (tixiDocument->uidCheckThreads > 1) {
+    error = buildIndexInParallel(tixiDocument, tixiDocument->uidCheckThreads);
+  }
+  else {
+    error = addSubtreeToIndex(tixiDocument, tixiDocument->docPtr->children);
+  }
+  if (error != SUCCESS) {
+    printMsg(MESSAGETYPE_ERROR, "Error: Memory allocation failed in uidHelper::readDocumentUIDs");
+    uid_clearIndex(tixiDocument);
+    return MEMORY_ALLOCATION_FAILED;
+  }
+
   return SUCCESS;
 }
 
 
+/* prints the paths of all elements using the uID */
+static void reportDuplicate(TixiDocument* document, const xmlChar* uID)
+{
+  TixiUIDEntry* entry = lookupEntries(document, document->uidIndex, uID);
+  int count = 0;
+  TixiUIDEntry* current = NULL;
+
+  for (current = entry; current; current = current->next) {
+    count++;
+  }
+
+  printMsg(MESSAGETYPE_ERROR, "Error: duplicated uID '%s' found %d times:\n", uID, count);
+  for (current = entry; current; current = current->next) {
+    xmlChar* path = xmlGetNodePath(current->nodePtr);
+    printMsg(MESSAGETYPE_ERROR, "  %s\n", path ? (char*) path : "");
+    xmlFree(path);
+  }
+}
+
+/* reports the duplicated uIDs in the order of their first occurrence in the document */
+static void reportDuplicates(TixiDocument* document, xmlNodePtr node, xmlHashTablePtr reported)
+{
+  for (; node; node = node->next) {
+    xmlAttrPtr attribute = getAttribute(node, CPACS_UID_ATTRIBUTE_STRING);
+    if (attribute) {
+      xmlChar* buffer = NULL;
+      const xmlChar* uID = getAttributeValue(attribute, &buffer);
+      TixiUIDEntry* entry = lookupEntries(document, document->uidIndex, uID);
+
+      if (uID[0] != '\0' && entry && entry->next && !xmlHashLookup(reported, uID)) {
+        xmlHashAddEntry(reported, uID, entry);
+        reportDuplicate(document, uID);
+      }
+      xmlFree(buffer);
+    }
+
+    if (node->type == XML_ELEMENT_NODE) {
+      reportDuplicates(document, node->children, reported);
+    }
+  }
+}
+
+int uid_checkForDuplicates(TixiDocument *document)
+{
+  xmlHashTablePtr reported = NULL;
+
+  if (lookupEntries(document, document->uidIndex, (xmlChar*) "")) {
+    // if we found an emtpy uid, we only warn about that.
+    printMsg(MESSAGETYPE_WARNING, "Warning: Empty uID found! This might lead to unknown errors!\n");
+  }
+
+  if (document->uidDuplicates == 0) {
+    return SUCCESS;
+  }
+
+  reported = xmlHashCreate(document->uidDuplicates);
+  if (reported) {
+    reportDuplicates(document, document->docPtr->children, reported);
+    xmlHashFree(reported, NULL);
+  }
+  else {
+    printMsg(MESSAGETYPE_ERROR, "Error: %d duplicated uIDs found!\n", document->uidDuplicates);
+  }
+  return FAILED;
+}
+
+
+
+/* state of the search for broken links */
+typedef struct
+{
+  int report;          /* print an error for each broken link */
+  char** linkPaths;    /* receives the paths of the broken links, may be NULL */
+  int maxLinks;        /* number of paths fitting into linkPaths */
+  int count;           /* number of broken links found */
+  int error;           /* SUCCESS or the first error copying a path */
+} BrokenLinkSearch;
+
+static void findBrokenLinks(TixiDocument* document, xmlNodePtr node, BrokenLinkSearch* search)
+{
+  for (; node; node = node->next) {
+    xmlAttrPtr attribute = getAttribute(node, CPACS_UID_LINK_ATTRIBUTE_STRING);
+    if (attribute) {
+      xmlChar* buffer = NULL;
+      const xmlChar* linkName = getAttributeValue(attribute, &buffer);
+
+      // now check if a corresponding uid exists
+      if (!lookupEntries(document, document->uidIndex, linkName)) {
+        if (search->report) {
+          printMsg(MESSAGETYPE_ERROR, "Error: Broken link, UID '%s' not found!\n", linkName);
+        }
+        if (search->linkPaths && search->count < search->maxLinks) {
+          xmlChar* path = xmlGetNodePath(node);
+          search->linkPaths[search->count] = path ? copyToMemoryArena(document, (char*) path) : NULL;
+          if (!search->linkPaths[search->count]) {
+            search->error = MEMORY_ALLOCATION_FAILED;
+          }
+          xmlFree(path);
+        }
+        search->count++;
+      }
+      xmlFree(buffer);
+    }
+
+    if (node->type == XML_ELEMENT_NODE) {
+      findBrokenLinks(document, node->children, search);
+    }
+  }
+}
+
+/* state of counting the broken links in the link index */
+typedef struct
+{
+  xmlHashTablePtr uidIndex;
+  int count;
+} BrokenLinkCount;
+
+static void countBrokenLinks(void* payload, void* data, const xmlChar* linkName)
+{
+  BrokenLinkCount* brokenLinks = (BrokenLinkCount*) data;
+  TixiUIDEntry* entry = NULL;
+
+  if (!xmlHashLookup(brokenLinks->uidIndex, linkName)) {
+    for (entry = (TixiUIDEntry*) payload; entry; entry = entry->next) {
+      brokenLinks->count++;
+    }
+  }
+}
+
+/* counts the broken links using the index, i.e. without walking the document */
+static int getBrokenLinksCount(TixiDocument* document)
+{
+  BrokenLinkCount brokenLinks = {NULL, 0};
+
+  brokenLinks.uidIndex = document->uidIndex;
+  xmlHashScan(document->linkIndex, countBrokenLinks, &brokenLinks);
+  return brokenLinks.count;
+}
 
 int uid_checkForBrokenLinks(TixiDocument *document)
 {
-  TixiUIDListEntry* currentEntry;
-  xmlXPathObjectPtr xpathObj;
-  xmlNodePtr cur;
-  int size;
-  int i;
-  char *linkName;
-  xmlNodeSetPtr nodes;
-  ReturnCode foundUID = FAILED;
+  BrokenLinkSearch search = {1, NULL, 0, 0, SUCCESS};
 
-  /* Evaluate xpath expression */
-  xpathObj = xmlXPathEvalExpression((xmlChar*) CPACS_UID_LINK_XPATH, document->xpathContext);
-  if (xpathObj == NULL) {
-    printMsg(MESSAGETYPE_ERROR,"Error: unable to evaluate xpath expression \"%s\"\n", CPACS_UID_LINK_XPATH);
-    return(FAILED);
+  /* the document is only walked to report the broken links in document order */
+  if (getBrokenLinksCount(document) == 0) {
+    return SUCCESS;
   }
+  findBrokenLinks(document, document->docPtr->children, &search);
+  return search.count > 0 ? UID_LINK_BROKEN : SUCCESS;
+}
 
-  /* Build List of results */
-  nodes = xpathObj->nodesetval;
-  size = (nodes) ? nodes->nodeNr : 0;
 
-  if (size == 0) {
-    xmlXPathFreeObject(xpathObj);
+int uid_getBrokenLinks(TixiDocument *document, char** linkPaths, int maxLinks, int* nBrokenLinks)
+{
+  BrokenLinkSearch search = {0, NULL, 0, 0, SUCCESS};
+
+  *nBrokenLinks = getBrokenLinksCount(document);
+  if (!linkPaths || *nBrokenLinks == 0) {
     return SUCCESS;
   }
 
-  // iterate through all links
-  for (i = 0; i < size; ++i) {
-    cur = nodes->nodeTab[i];
-    linkName = (char*) xmlGetProp(cur->parent, (xmlChar*) CPACS_UID_LINK_ATTRIBUTE_STRING);
+  search.linkPaths = linkPaths;
+  search.maxLinks = maxLinks;
+  findBrokenLinks(document, document->docPtr->children, &search);
+  *nBrokenLinks = search.count;
+  return search.error;
+}
+
 
-    // now check if a corresponding uid exists
-    currentEntry = document->uidListHead;
-    foundUID = FAILED;
-    while (currentEntry) {
-      if (!strcmp(linkName, currentEntry->uIDName)) {
-        foundUID = SUCCESS;
+int uid_getReferencingXPaths(TixiDocument *document, const char *uID, char** xPaths, int maxPaths, int* count)
+{
+  TixiUIDEntry* entry = lookupEntries(document, document->linkIndex, (xmlChar*) uID);
+  xmlNodeSetPtr nodes = NULL;
+  int error = SUCCESS;
+  int i = 0;
+
+  *count = 0;
+  for (; entry; entry = entry->next) {
+    if (xPaths && *count < maxPaths) {
+      if (!nodes) {
+        nodes = xmlXPathNodeSetCreate(NULL);
+      }
+      if (!nodes || xmlXPathNodeSetAdd(nodes, entry->nodePtr) != 0) {
+        error = MEMORY_ALLOCATION_FAILED;
         break;
       }
-      currentEntry = (TixiUIDListEntry *) currentEntry->next;
     }
-    if (foundUID == FAILED) {
-      printMsg(MESSAGETYPE_ERROR, "Error: Broken link, UID '%s' not found!", linkName);
-      xmlXPathFreeObject(xpathObj);
-      xmlFree(linkName);
-      return UID_LINK_BROKEN;
+    (*count)++;
+  }
+
+  if (nodes && error == SUCCESS) {
+    /* the chain is in insertion order, the results are in document order */
+    xmlXPathNodeSetSort(nodes);
+    for (i = 0; i < nodes->nodeNr; i++) {
+      xmlChar* path = xmlGetNodePath(nodes->nodeTab[i]);
+      xPaths[i] = path ? copyToMemoryArena(document, (char*) path) : NULL;
+      xmlFree(path);
+      if (!xPaths[i]) {
+        error = MEMORY_ALLOCATION_FAILED;
+        break;
+      }
     }
-    xmlFree(linkName);
   }
+  xmlXPathFreeNodeSet(nodes);
+  return error;
+}
 
-  /* Cleanup */
-  xmlXPathFreeObject(xpathObj);
 
+int uid_clearIndex(TixiDocument *document)
+{
+  if (document->uidIndex) {
+    xmlHashFree(document->uidIndex, freeUIDEntries);
+    document->uidIndex = NULL;
+  }
+  if (document->linkIndex) {
+    xmlHashFree(document->linkIndex, freeUIDEntries);
+    document->linkIndex = NULL;
+  }
+  if (document->uidDict) {
+    xmlDictFree(document->uidDict);
+    document->uidDict = NULL;
+  }
+  document->uidDuplicates = 0;
   return SUCCESS;
 }
 
 
+/* returns UID_NOT_UNIQUE for the first non empty uID of the node or its descendants, that is used by several elements */
+static int checkSubtreeUnique(TixiDocument* document, xmlNodePtr node)
+{
+  xmlAttrPtr attribute = getAttribute(node, CPACS_UID_ATTRIBUTE_STRING);
+  xmlNodePtr child = NULL;
+  int error = SUCCESS;
+
+  if (attribute) {
+    xmlChar* buffer = NULL;
+    const xmlChar* uID = getAttributeValue(attribute, &buffer);
+    TixiUIDEntry* entry = lookupEntries(document, document->uidIndex, uID);
+    if (uID[0] != '\0' && entry && entry->next) {
+      printMsg(MESSAGETYPE_ERROR, "Error: uID '%s' is not unique!\n", uID);
+      error = UID_NOT_UNIQUE;
+    }
+    xmlFree(buffer);
+  }
+
+  if (node->type == XML_ELEMENT_NODE) {
+    for (child = node->children; child && error == SUCCESS; child = child->next) {
+      error = checkSubtreeUnique(document, child);
+    }
+  }
+  return error;
+}
 
-int uid_clearUIDList(TixiDocument *document)
+int uid_checkAssignable(TixiDocument *document, xmlNodePtr element, const char *uID)
 {
-  TixiUIDListEntry *current = document->uidListHead;
-  while (current) {
-    TixiUIDListEntry *next = (TixiUIDListEntry *) current->next;
-    if (current->uIDName) {
-      xmlFree(current->uIDName);
-      current->uIDName = NULL;
+  TixiUIDEntry* entry = NULL;
+
+  if (!document->enforceUniqueUIDs || !uID || uID[0] == '\0') {
+    return SUCCESS;
+  }
+  if (uid_readDocumentUIDs(document) != SUCCESS) {
+    return FAILED;
+  }
+
+  /* the element may keep its own uID */
+  for (entry = lookupEntries(document, document->uidIndex, (xmlChar*) uID); entry; entry = entry->next) {
+    if (entry->nodePtr != element) {
+      printMsg(MESSAGETYPE_ERROR, "Error: uID '%s' is not unique!\n", uID);
+      return UID_NOT_UNIQUE;
     }
-    free(current);
-    current = next;
   }
-  document->uidListHead = NULL;
+  return SUCCESS;
+}
+
+int uid_addSubtreeUnique(TixiDocument *document, xmlNodePtr node)
+{
+  if (!document->enforceUniqueUIDs) {
+    uid_addSubtree(document, node);
+    return SUCCESS;
+  }
+
+  if (document->uidIndex) {
+    uid_addSubtree(document, node);
+  }
+  /* builds the index including the node, if it has been cleared */
+  if (uid_readDocumentUIDs(document) != SUCCESS) {
+    return FAILED;
+  }
+  if (checkSubtreeUnique(document, node) != SUCCESS) {
+    uid_removeSubtree(document, node);
+    return UID_NOT_UNIQUE;
+  }
+  return SUCCESS;
+}
+
+
+int uid_isIndexedAttribute(const char *attributeName)
+{
+  return !strcmp(attributeName, CPACS_UID_ATTRIBUTE_STRING) ||
+         !strcmp(attributeName, CPACS_UID_LINK_ATTRIBUTE_STRING);
+}
+
+
+const xmlChar* uid_getElementUID(xmlNodePtr element, xmlChar** buffer)
+{
+  xmlAttrPtr attribute = getAttribute(element, CPACS_UID_ATTRIBUTE_STRING);
+
+  *buffer = NULL;
+  if (!attribute) {
+    return NULL;
+  }
+  return getAttributeValue(attribute, buffer);
+}
+
+
+void uid_addSubtree(TixiDocument *document, xmlNodePtr node)
+{
+  if (!document->uidIndex || !node) {
+    return;
+  }
+
+  if (addElementToIndex(document, node) != SUCCESS ||
+      addSubtreeToIndex(document, node->children) != SUCCESS) {
+    /* the index is rebuilt on its next use */
+    uid_clearIndex(document);
+  }
+}
+
+
+void uid_removeSubtree(TixiDocument *document, xmlNodePtr node)
+{
+  if (!document->uidIndex || !node) {
+    return;
+  }
+
+  removeElementFromIndex(document, node);
+  removeSubtreeFromIndex(document, node->children);
+}
+
+
+void uid_addElement(TixiDocument *document, xmlNodePtr element)
+{
+  if (!document->uidIndex || !element) {
+    return;
+  }
+
+  if (addElementToIndex(document, element) != SUCCESS) {
+    uid_clearIndex(document);
+  }
+}
+
+
+void uid_removeElement(TixiDocument *document, xmlNodePtr element)
+{
+  if (!document->uidIndex || !element) {
+    return;
+  }
+
+  removeElementFromIndex(document, element);
+}
+
+
+int uid_getNode(TixiDocument *document, const char *uID, xmlNodePtr *node)
+{
+  TixiUIDEntry* entry = lookupEntries(document, document->uidIndex, (xmlChar*) uID);
+
+  if (!entry) {
+    return UID_DONT_EXISTS;
+  }
+  if (entry->next) {
+    return UID_NOT_UNIQUE;
+  }
+  *node = entry->nodePtr;
   return SUCCESS;
 }
 
 
 char* uid_getXpath(TixiDocument *document, const char *uID)
 {
-  TixiUIDListEntry *current = document->uidListHead;
+  TixiUIDEntry* entry = lookupEntries(document, document->uidIndex, (xmlChar*) uID);
 
-  while (current) {
-    if (!strcmp(current->uIDName, uID)) {
-      return (char*) xmlGetNodePath(current->nodePtr);
-    }
-    current = (TixiUIDListEntry *) current->next;
+  if (entry) {
+    return (char*) xmlGetNodePath(entry->nodePtr);
   }
   return NULL;
 }
@@ -213,14 +931,8 @@ char* uid_getXpath(TixiDocument *document, const char *uID)
 
 int uid_checkExists(TixiDocument *document, const char *uID)
 {
-  TixiUIDListEntry *current = document->uidListHead;
-
-  while (current) {
-    if (!strcmp(current->uIDName, uID)) {
-      return 0;
-    }
-    current = (TixiUIDListEntry *) current->next;
+  if (lookupEntries(document, document->uidIndex, (xmlChar*) uID)) {
+    return 0;
   }
   return -1;
 }
-
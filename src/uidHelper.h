@@ -30,29 +30,87 @@
 #include "tixiData.h"
 
 /**
- * Builds an internal structure of all uids.
+ * Builds the uid index of the document, if it does not exist yet.
  */
 int uid_readDocumentUIDs(TixiDocument* tixiDocument);
 
 /**
- * Builds an internal structure of all uids. Memory allocation etc.
+ * Checks for not-unique uIDs. All duplicated uIDs are reported together with the paths of their elements.
  */
-int uid_buildUIDNodeList(TixiDocument* tixiDocument, xmlNodeSetPtr nodes);
+int uid_checkForDuplicates(TixiDocument *document);
 
 /**
- * Checks for not-unique uIDs.
+ * Checks for broken links (all links without a corrsponding UID). Each broken link is reported.
  */
-int uid_checkForDuplicates(TixiDocument *document);
+int uid_checkForBrokenLinks(TixiDocument *document);
 
 /**
- * Checks for broken links (all links without a corrsponding UID).
+ * Counts the broken links in document order. The paths of the first maxLinks
+ * broken links are copied to the memory arena and stored in linkPaths, if it is not NULL.
  */
-int uid_checkForBrokenLinks(TixiDocument *document);
+int uid_getBrokenLinks(TixiDocument *document, char** linkPaths, int maxLinks, int* nBrokenLinks);
+
+/**
+ * Cleans up memory and removes the uid index from the document.
+ */
+int uid_clearIndex(TixiDocument *document);
+
+/**
+ * Adds the uids and links of a node and all its descendants to the index.
+ * Must be called after the node has been inserted into the document.
+ */
+void uid_addSubtree(TixiDocument *document, xmlNodePtr node);
 
 /**
- * Cleans up memory and removed the uid-list from the document.
+ * Removes the uids and links of a node and all its descendants from the index.
+ * Must be called before the node is removed from the document.
  */
-int uid_clearUIDList(TixiDocument *document);
+void uid_removeSubtree(TixiDocument *document, xmlNodePtr node);
+
+/**
+ * Checks, if the uID may be assigned to the element. If unique uIDs are enforced, it fails
+ * with UID_NOT_UNIQUE, if another element already uses the uID. Empty uIDs are not checked.
+ */
+int uid_checkAssignable(TixiDocument *document, xmlNodePtr element, const char *uID);
+
+/**
+ * Adds the uids and links of a node and all its descendants to the index, like uid_addSubtree.
+ * If unique uIDs are enforced, the node is removed from the index again and UID_NOT_UNIQUE is
+ * returned, if one of its uIDs is not unique. The caller has to remove the node from the document then.
+ */
+int uid_addSubtreeUnique(TixiDocument *document, xmlNodePtr node);
+
+/**
+ * Returns 1, if the attribute is kept in the index (uID or isLink), 0 otherwise.
+ */
+int uid_isIndexedAttribute(const char *attributeName);
+
+/**
+ * Returns the uID of an element as used by the index, NULL if it has no uID attribute without namespace.
+ * The value is only copied, if it consists of several nodes. In this case, *buffer must be freed by xmlFree.
+ */
+const xmlChar* uid_getElementUID(xmlNodePtr element, xmlChar** buffer);
+
+/**
+ * Adds the uid and link of a single element to the index, e.g. after setting its uid attribute.
+ */
+void uid_addElement(TixiDocument *document, xmlNodePtr element);
+
+/**
+ * Removes the uid and link of a single element from the index, e.g. before changing its uid attribute.
+ */
+void uid_removeElement(TixiDocument *document, xmlNodePtr element);
+
+/**
+ * Returns the element with the given uID. Returns UID_DONT_EXISTS or UID_NOT_UNIQUE, if there is not exactly one.
+ */
+int uid_getNode(TixiDocument *document, const char *uID, xmlNodePtr *node);
+
+/**
+ * Counts the elements linking to the uID in document order. The paths of the first maxPaths
+ * elements are copied to the memory arena and stored in xPaths, if it is not NULL.
+ */
+int uid_getReferencingXPaths(TixiDocument *document, const char *uID, char** xPaths, int maxPaths, int* count);
 
 /**
  * Returns a XPath to a given uID.
@@ -63,4 +121,3 @@ char* uid_getXpath(TixiDocument *document, const char *uID);
  * Checks if a UID exists.
  */
 int uid_checkExists(TixiDocument *document, const char *uID);
-
@@ -21,37 +21,288 @@
 #include "libxml/xpathInternals.h"
 
 #include <assert.h>
+#include <limits.h>
 #include <stdlib.h>
+#include <string.h>
 
 extern void printMsg(MessageType type, const char* message, ...);
 
 xmlXPathObjectPtr XPathEvaluateExpression(TixiDocument* doc, const char* xPathExpression)
 {
   xmlXPathObjectPtr xpathObject;
+  xmlXPathContextPtr xpathContext = NULL;
+  XPathCache* xpathCache = NULL;
 
-  if (!doc || !doc->xpathContext) {
+  if (!doc) {
     return NULL;
   }
-  
-  xpathObject = XPathCacheGet(doc->xpathCache,(const xmlChar*) xPathExpression);
+
+  xpathContext = getXPathContext(doc);
+  xpathCache = getXPathCache(doc);
+  if (!xpathContext || !xpathCache) {
+    return NULL;
+  }
+
+  /* drop results of previous versions of the document */
+  if (xpathCache->generation != doc->generation) {
+    XPathClearCache(xpathCache);
+    xpathCache->generation = doc->generation;
+  }
+
+  xpathObject = XPathCacheGet(xpathCache,(const xmlChar*) xPathExpression);
   if (xpathObject) {
     return xpathObject;
   }
 
   /* Evaluate Expression */
-  xpathObject = xmlXPathEvalExpression((const xmlChar*) xPathExpression, doc->xpathContext);
+  xpathObject = XPathEvaluateCompiled(doc, xPathExpression, strlen(xPathExpression));
   if (!(xpathObject)) {
     printMsg(MESSAGETYPE_ERROR, "Error: Invalid XPath expression \"%s\"\n", xPathExpression);
     return NULL;
   }
 
-  XPathCacheInsert(doc->xpathCache, (const xmlChar*) xPathExpression, xpathObject);
+  if (XPathCacheInsert(xpathCache, (const xmlChar*) xPathExpression, xpathObject) != 0) {
+    return NULL;
+  }
 
   return xpathObject;
 }
 
 
 
+xmlXPathObjectPtr XPathEvaluateCompiled(TixiDocument* doc, const char* xPathExpression, size_t length)
+{
+  return XPathEvaluateCompiledAt(doc, NULL, xPathExpression, length);
+}
+
+xmlXPathObjectPtr XPathEvaluateCompiledAt(TixiDocument* doc, xmlNodePtr contextNode, const char* xPathExpression, size_t length)
+{
+  xmlXPathContextPtr xpathContext = NULL;
+  xmlXPathCompExprPtr compiled = NULL;
+  xmlXPathObjectPtr result = NULL;
+  xmlNodePtr previousNode = NULL;
+
+  if (!doc || !xPathExpression) {
+    return NULL;
+  }
+
+  xpathContext = getXPathContext(doc);
+  if (!xpathContext) {
+    return NULL;
+  }
+
+  compiled = XPathCacheGetCompiled(getXPathCache(doc), (const xmlChar*) xPathExpression, length, xpathContext);
+  if (!compiled) {
+    return NULL;
+  }
+
+  if (!contextNode) {
+    return xmlXPathCompiledEval(compiled, xpathContext);
+  }
+
+  /* the context belongs to the calling thread, restore it for the next expressions */
+  previousNode = xpathContext->node;
+  xpathContext->node = contextNode;
+  result = xmlXPathCompiledEval(compiled, xpathContext);
+  xpathContext->node = previousNode;
+  return result;
+}
+
+size_t XPathElementPathLength(const char* elementPath)
+{
+  size_t length = strlen(elementPath);
+
+  /* remove trailing slash */
+  if (length > 1 && elementPath[length - 1] == '/') {
+    length--;
+  }
+  return length;
+}
+
+/* longest position predicate handled by the simple path resolver */
+#define SIMPLE_PATH_MAX_DIGITS 9
+/* longest namespace prefix handled by the simple path resolver */
+#define SIMPLE_PATH_MAX_PREFIX 64
+
+typedef struct
+{
+  const char* name;        /* local name of the element, not null terminated */
+  size_t nameLength;
+  const xmlChar* href;     /* namespace of the element, NULL if the name is not prefixed */
+  int position;            /* position predicate, 0 if the step has none */
+} SimplePathStep;
+
+static int isSimpleNameStartChar(char c)
+{
+  return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_';
+}
+
+static int isSimpleNameChar(char c)
+{
+  return isSimpleNameStartChar(c) || (c >= '0' && c <= '9') || c == '-' || c == '.';
+}
+
+/* parses a step of a simple path, returns the position behind it or NULL if the step is not supported */
+static const char* parseSimplePathStep(xmlXPathContextPtr xpathContext, const char* path, const char* end, SimplePathStep* step)
+{
+  const char* p = path;
+
+  if (p == end || !isSimpleNameStartChar(*p)) {
+    return NULL;
+  }
+  while (p != end && isSimpleNameChar(*p)) {
+    p++;
+  }
+
+  step->href = NULL;
+  if (p != end && *p == ':') {
+    char prefix[SIMPLE_PATH_MAX_PREFIX];
+    size_t prefixLength = (size_t) (p - path);
+
+    if (prefixLength >= SIMPLE_PATH_MAX_PREFIX || p + 1 == end || !isSimpleNameStartChar(p[1])) {
+      return NULL;
+    }
+    memcpy(prefix, path, prefixLength);
+    prefix[prefixLength] = '\0';
+
+    /* undefined prefixes are reported by the xpath engine */
+    step->href = xmlXPathNsLookup(xpathContext, (const xmlChar*) prefix);
+    if (!step->href) {
+      return NULL;
+    }
+
+    path = ++p;
+    while (p != end && isSimpleNameChar(*p)) {
+      p++;
+    }
+  }
+  step->name = path;
+  step->nameLength = (size_t) (p - path);
+
+  step->position = 0;
+  if (p != end && *p == '[') {
+    int nDigits = 0;
+    for (p++; p != end && *p >= '0' && *p <= '9'; p++, nDigits++) {
+      step->position = 10 * step->position + (*p - '0');
+    }
+    if (nDigits == 0 || nDigits > SIMPLE_PATH_MAX_DIGITS || step->position == 0 || p == end || *p != ']') {
+      return NULL;
+    }
+    p++;
+  }
+
+  return p;
+}
+
+static int matchesSimplePathStep(xmlNodePtr node, const SimplePathStep* step)
+{
+  if (node->type != XML_ELEMENT_NODE) {
+    return 0;
+  }
+
+  /* unprefixed names only match elements without namespace, as in xpath */
+  if (step->href) {
+    if (!node->ns || !xmlStrEqual(node->ns->href, step->href)) {
+      return 0;
+    }
+  }
+  else if (node->ns) {
+    return 0;
+  }
+
+  return strncmp((const char*) node->name, step->name, step->nameLength) == 0
+      && node->name[step->nameLength] == '\0';
+}
+
+/* walks the remaining path along the siblings in document order, until two matches are found */
+static void walkSimplePath(xmlXPathContextPtr xpathContext, xmlNodePtr child, const char* path, const char* end,
+                           xmlNodePtr* element, int* count)
+{
+  SimplePathStep step;
+  const char* next = parseSimplePathStep(xpathContext, path, end, &step);
+  int position = 0;
+
+  for (; child && *count < 2; child = child->next) {
+    if (!matchesSimplePathStep(child, &step)) {
+      continue;
+    }
+
+    position++;
+    if (step.position > 0 && position != step.position) {
+      continue;
+    }
+
+    if (next == end) {
+      if (*count == 0) {
+        *element = child;
+      }
+      (*count)++;
+    }
+    else {
+      walkSimplePath(xpathContext, child->children, next + 1, end, element, count);
+    }
+
+    if (step.position > 0) {
+      break;
+    }
+  }
+}
+
+/* resolves the steps of path, starting with the children of parent */
+static int resolveSimplePath(TixiDocument* doc, xmlNodePtr parent, const char* path, const char* end, xmlNodePtr* element)
+{
+  xmlXPathContextPtr xpathContext = getXPathContext(doc);
+  SimplePathStep step;
+  const char* p = NULL;
+  int count = 0;
+
+  if (!xpathContext) {
+    return -1;
+  }
+
+  /* check the complete path first, such that unsupported paths are not reported as missing */
+  for (p = path; ; p++) {
+    p = parseSimplePathStep(xpathContext, p, end, &step);
+    if (!p) {
+      return -1;
+    }
+    if (p == end) {
+      break;
+    }
+    if (*p != '/') {
+      return -1;
+    }
+  }
+
+  *element = NULL;
+  walkSimplePath(xpathContext, parent->children, path, end, element, &count);
+  return count;
+}
+
+int XPathResolveSimplePath(TixiDocument* doc, const char* xPathExpression, size_t length, xmlNodePtr* element)
+{
+  if (!doc || !xPathExpression || length == 0 || xPathExpression[0] != '/') {
+    return -1;
+  }
+
+  return resolveSimplePath(doc, (xmlNodePtr) doc->docPtr, xPathExpression + 1, xPathExpression + length, element);
+}
+
+int XPathResolveRelativeSimplePath(TixiDocument* doc, xmlNodePtr contextNode, const char* xPathExpression, size_t length,
+                                   xmlNodePtr* element)
+{
+  if (!doc || !contextNode || !xPathExpression || xPathExpression[0] == '/') {
+    return -1;
+  }
+
+  if (length == 0) {
+    *element = contextNode;
+    return 1;
+  }
+
+  return resolveSimplePath(doc, contextNode, xPathExpression, xPathExpression + length, element);
+}
+
 int XPathGetNodeNumber(TixiDocument* tixiDocument, const char* xPathExpression)
 {
   xmlXPathObjectPtr xpathObject;
@@ -75,7 +326,7 @@ int XPathGetNodeNumber(TixiDocument* tixiDocument, const char* xPathExpression)
 
 
 
-char* XPathExpressionGetText(TixiDocument* tixiDocument, const char* xPathExpression, int index)
+const char* XPathExpressionGetText(TixiDocument* tixiDocument, const char* xPathExpression, int index, char** allocated)
 {
 
   xmlXPathObjectPtr xpathObject;
@@ -84,6 +335,8 @@ char* XPathExpressionGetText(TixiDocument* tixiDocument, const char* xPathExpres
   char* text = NULL;
   int size = 0;
 
+  *allocated = NULL;
+
   xpathObject = XPathEvaluateExpression(tixiDocument, xPathExpression);
   if (xpathObject == NULL) {
     return NULL;
@@ -112,6 +365,7 @@ char* XPathExpressionGetText(TixiDocument* tixiDocument, const char* xPathExpres
   if (cur->type == XML_ELEMENT_NODE) {
     xmlNodePtr children = cur->children;
     text = (char*) xmlNodeListGetString(tixiDocument->docPtr, children, 0);
+    *allocated = text;
   }
   else if (cur->type == XML_ATTRIBUTE_NODE) {
     if (cur->children) {
@@ -258,54 +512,210 @@ int XPathRegisterDocumentNamespaces(xmlXPathContextPtr xpathContext)
   return error;
 }
 
+/* number of results kept by an enabled cache */
+#define XPATH_CACHE_CAPACITY 64
+/* number of compiled expressions, after which all of them are dropped */
+#define XPATH_COMPILED_CAPACITY 1024
+
 XPathCache *XPathNewCache()
 {
     XPathCache* cache = (XPathCache*) malloc(sizeof(XPathCache));
 
-    cache->result = 0;
-    cache->xpath = 0;
-    cache->enabled = 0;
+    if (!cache) {
+        return NULL;
+    }
+
+    cache->expressions = xmlDictCreate();
+    cache->compiled = xmlHashCreateDict(XPATH_COMPILED_CAPACITY, cache->expressions);
+    cache->entries = xmlHashCreate(XPATH_CACHE_CAPACITY);
+    if (!cache->expressions || !cache->compiled || !cache->entries) {
+        xmlHashFree(cache->compiled, NULL);
+        xmlHashFree(cache->entries, NULL);
+        xmlDictFree(cache->expressions);
+        free(cache);
+        return NULL;
+    }
+
+    cache->newest = NULL;
+    cache->oldest = NULL;
+    cache->size = 0;
+    cache->generation = 0;
+    cache->enabled = 1;
 
     return cache;
 }
 
+static void unlinkCacheEntry(XPathCache* cache, XPathCacheEntry* entry)
+{
+    if (entry->newer) {
+        entry->newer->older = entry->older;
+    }
+    else {
+        cache->newest = entry->older;
+    }
+
+    if (entry->older) {
+        entry->older->newer = entry->newer;
+    }
+    else {
+        cache->oldest = entry->newer;
+    }
+
+    entry->newer = NULL;
+    entry->older = NULL;
+}
+
+static void linkCacheEntryAsNewest(XPathCache* cache, XPathCacheEntry* entry)
+{
+    entry->older = cache->newest;
+    entry->newer = NULL;
+
+    if (cache->newest) {
+        cache->newest->newer = entry;
+    }
+    else {
+        cache->oldest = entry;
+    }
+    cache->newest = entry;
+}
+
+static void removeCacheEntry(XPathCache* cache, XPathCacheEntry* entry)
+{
+    unlinkCacheEntry(cache, entry);
+    xmlHashRemoveEntry(cache->entries, entry->xpath, NULL);
+    cache->size--;
+
+    xmlXPathFreeObject(entry->result);
+    xmlFree(entry->xpath);
+    free(entry);
+}
+
 void XPathClearCache(XPathCache * cache)
 {
-    if(cache->result) xmlXPathFreeObject(cache->result);
-    if(cache->xpath) xmlFree(cache->xpath);
+    while (cache->oldest) {
+        removeCacheEntry(cache, cache->oldest);
+    }
+}
 
-    cache->result = 0;
-    cache->xpath = 0;
+static void freeCompiledExpression(void* compiled, const xmlChar* xpath)
+{
+    (void) xpath;
+    xmlXPathFreeCompExpr((xmlXPathCompExprPtr) compiled);
 }
 
 void XPathFreeCache(XPathCache * cache)
 {
     XPathClearCache(cache);
+    xmlHashFree(cache->compiled, freeCompiledExpression);
+    xmlHashFree(cache->entries, NULL);
+    xmlDictFree(cache->expressions);
     free(cache);
 }
 
-xmlXPathObjectPtr XPathCacheGet(XPathCache const * cache, xmlChar const * xpath)
+xmlXPathCompExprPtr XPathCacheGetCompiled(XPathCache* cache, const xmlChar* xpath, size_t length, xmlXPathContextPtr xpathContext)
+{
+    xmlXPathCompExprPtr compiled = NULL;
+    const xmlChar* key = NULL;
+
+    if (!cache || !xpath || !cache->compiled || length > INT_MAX) {
+        return NULL;
+    }
+
+    /* looking up the interned expression does not copy it */
+    key = xmlDictExists(cache->expressions, xpath, (int) length);
+    if (key) {
+        compiled = (xmlXPathCompExprPtr) xmlHashLookup(cache->compiled, key);
+        if (compiled) {
+            return compiled;
+        }
+    }
+
+    /* generated expressions may be unique, start over instead of growing without bounds */
+    if (xmlHashSize(cache->compiled) >= XPATH_COMPILED_CAPACITY) {
+        xmlHashFree(cache->compiled, freeCompiledExpression);
+        xmlDictFree(cache->expressions);
+        cache->expressions = xmlDictCreate();
+        cache->compiled = cache->expressions ? xmlHashCreateDict(XPATH_COMPILED_CAPACITY, cache->expressions) : NULL;
+    }
+
+    /* the interned copy is null terminated, as required by the compiler */
+    key = cache->compiled ? xmlDictLookup(cache->expressions, xpath, (int) length) : NULL;
+    if (!key) {
+        printMsg(MESSAGETYPE_ERROR, "Internal Error: Failed to allocate memory in XPathCacheGetCompiled.\n");
+        return NULL;
+    }
+
+    compiled = xmlXPathCtxtCompile(xpathContext, key);
+    if (!compiled) {
+        return NULL;
+    }
+
+    if (xmlHashAddEntry(cache->compiled, key, compiled) != 0) {
+        printMsg(MESSAGETYPE_ERROR, "Internal Error: Failed to allocate memory in XPathCacheGetCompiled.\n");
+        xmlXPathFreeCompExpr(compiled);
+        return NULL;
+    }
+
+    return compiled;
+}
+
+xmlXPathObjectPtr XPathCacheGet(XPathCache * cache, xmlChar const * xpath)
 {
-    if (!cache || cache->enabled != 1) {
+    XPathCacheEntry* entry = NULL;
+
+    if (!cache || cache->enabled != 1 || !xpath) {
         return NULL;
     }
 
-    if (!xpath || !cache->xpath || xmlStrcmp(cache->xpath, xpath) != 0) {
+    entry = (XPathCacheEntry*) xmlHashLookup(cache->entries, xpath);
+    if (!entry) {
         return NULL;
     }
 
-    return cache->result;
+    if (entry != cache->newest) {
+        unlinkCacheEntry(cache, entry);
+        linkCacheEntryAsNewest(cache, entry);
+    }
+
+    return entry->result;
 }
 
-void XPathCacheInsert(XPathCache *cache, const xmlChar *xpath, const xmlXPathObjectPtr result)
+int XPathCacheInsert(XPathCache *cache, const xmlChar *xpath, const xmlXPathObjectPtr result)
 {
+    XPathCacheEntry* entry = NULL;
+    int capacity = 0;
+
     if (!cache || !xpath || !result) {
-        return;
+        return -1;
     }
 
-    XPathClearCache(cache);
+    entry = (XPathCacheEntry*) xmlHashLookup(cache->entries, xpath);
+    if (entry) {
+        removeCacheEntry(cache, entry);
+    }
+
+    /* a disabled cache still owns the last result */
+    capacity = cache->enabled == 1 ? XPATH_CACHE_CAPACITY : 1;
+    while (cache->size >= capacity) {
+        removeCacheEntry(cache, cache->oldest);
+    }
+
+    entry = (XPathCacheEntry*) malloc(sizeof(XPathCacheEntry));
+    if (entry) {
+        entry->xpath = xmlStrdup(xpath);
+    }
+    if (!entry || !entry->xpath || xmlHashAddEntry(cache->entries, entry->xpath, entry) != 0) {
+        printMsg(MESSAGETYPE_ERROR, "Internal Error: Failed to allocate memory in XPathCacheInsert.\n");
+        if (entry) {
+            xmlFree(entry->xpath);
+            free(entry);
+        }
+        xmlXPathFreeObject(result);
+        return -1;
+    }
 
-    cache->result = result;
-    cache->xpath = (xmlChar*) malloc((strlen((const char*)xpath) + 3) * sizeof (xmlChar*));
-    strcpy((char*) cache->xpath, (const char*) xpath);
+    entry->result = result;
+    linkCacheEntryAsNewest(cache, entry);
+    cache->size++;
+    return 0;
 }
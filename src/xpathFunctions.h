@@ -42,17 +42,82 @@ TIXI_INTERNAL_EXPORT void XPathFreeCache(XPathCache*);
 TIXI_INTERNAL_EXPORT void XPathClearCache(XPathCache*);
 
 /**
- * @brief Searches for cached xpath
- * @return NULL; if not cached
+ * @brief Searches for cached xpath and marks it as most recently used
+ * @return NULL; if not cached or if the cache is disabled
  */
-TIXI_INTERNAL_EXPORT xmlXPathObjectPtr XPathCacheGet(const XPathCache* cache, const xmlChar* xpath);
-TIXI_INTERNAL_EXPORT void XPathCacheInsert(XPathCache* cache, const xmlChar* xpath, const xmlXPathObjectPtr result);
+TIXI_INTERNAL_EXPORT xmlXPathObjectPtr XPathCacheGet(XPathCache* cache, const xmlChar* xpath);
+
+/**
+ * @brief Returns the compiled expression, which is compiled on first use and owned by the cache
+ *
+ * The expression is given by its first length characters, it does not need to be null terminated.
+ * @return NULL; if the expression is invalid
+ */
+TIXI_INTERNAL_EXPORT xmlXPathCompExprPtr XPathCacheGetCompiled(XPathCache* cache, const xmlChar* xpath, size_t length, xmlXPathContextPtr xpathContext);
+
+/**
+ * @brief Transfers the ownership of the result to the cache, evicting the least recently used results if the cache is full
+ * @return 0 on success, -1 if the result could not be stored. In this case, the result has been freed.
+ */
+TIXI_INTERNAL_EXPORT int XPathCacheInsert(XPathCache* cache, const xmlChar* xpath, const xmlXPathObjectPtr result);
 
 TIXI_INTERNAL_EXPORT xmlXPathObjectPtr XPathEvaluateExpression(TixiDocument *tixiDocument, const char *xPathExpression);
 
+/**
+ * @brief Evaluates the first length characters of the expression, using the compiled expressions cached for the calling thread
+ *
+ * In contrast to XPathEvaluateExpression, the result is not cached and has to be freed by the caller.
+ * @return NULL; if the expression is invalid
+ */
+TIXI_INTERNAL_EXPORT xmlXPathObjectPtr XPathEvaluateCompiled(TixiDocument *tixiDocument, const char *xPathExpression, size_t length);
+
+/**
+ * @brief Same as XPathEvaluateCompiled, but relative expressions are evaluated from the given context node
+ *
+ * If contextNode is NULL, the context node of the xpath context is used.
+ */
+TIXI_INTERNAL_EXPORT xmlXPathObjectPtr XPathEvaluateCompiledAt(TixiDocument *tixiDocument, xmlNodePtr contextNode,
+                                                               const char *xPathExpression, size_t length);
+
+/**
+ * @brief Returns the length of the element path without a trailing slash
+ *
+ * Element paths are normalized without copying them. Functions taking an element path
+ * only evaluate this number of characters of the path.
+ */
+TIXI_INTERNAL_EXPORT size_t XPathElementPathLength(const char *elementPath);
+
+/**
+ * @brief Resolves simple absolute element paths like /a/b[2]/c without the xpath engine
+ *
+ * Only paths consisting of child steps with a (prefixed) element name and an optional
+ * position predicate are supported. All other expressions have to be evaluated by
+ * the xpath engine. Only the first length characters of the path are resolved.
+ * @return The number of matching elements, limited to 2, or -1 if the path is not supported.
+ *         The first match is returned in element.
+ */
+TIXI_INTERNAL_EXPORT int XPathResolveSimplePath(TixiDocument *tixiDocument, const char *xPathExpression, size_t length, xmlNodePtr *element);
+
+/**
+ * @brief Resolves simple relative element paths like b[2]/c starting from contextNode
+ *
+ * The same restrictions as for XPathResolveSimplePath apply. An empty path resolves to the context node.
+ */
+TIXI_INTERNAL_EXPORT int XPathResolveRelativeSimplePath(TixiDocument *tixiDocument, xmlNodePtr contextNode,
+                                                        const char *xPathExpression, size_t length, xmlNodePtr *element);
+
 TIXI_INTERNAL_EXPORT int XPathGetNodeNumber(TixiDocument *tixiDocument, const char *xPathExpression);
 
-TIXI_INTERNAL_EXPORT char* XPathExpressionGetText(TixiDocument *tixiDocument, const char *xPathExpression, int index);
+/**
+  @brief XPathExpressionGetText Returns the text of the i-th node matching the xPathExpression
+
+  The text of attributes, text and comment nodes is returned without copying. The text
+  of elements is assembled and also returned in allocated, which has to be freed by the caller.
+
+  @return
+    The text or NULL, if the node does not exist.
+*/
+TIXI_INTERNAL_EXPORT const char* XPathExpressionGetText(TixiDocument *tixiDocument, const char *xPathExpression, int index, char** allocated);
 
 /**
   @brief XPathExpressionGetElementPath Returns the name of the i-th element matching the xPathExpression
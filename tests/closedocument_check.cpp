@@ -52,3 +52,45 @@ TEST(closedocument_checks, close_multiple)
   ASSERT_TRUE( tixiCloseDocument( documentHandle3 ) == SUCCESS );
   ASSERT_TRUE( tixiCloseDocument( documentHandle2 ) == SUCCESS );
 }
+
+
+TEST(closedocument_checks, stale_handle)
+{
+  TixiDocumentHandle documentHandle1 = -1;
+  TixiDocumentHandle documentHandle2 = -1;
+  const char* xmlFilename = "TestData/in.xml";
+
+  ASSERT_TRUE( tixiOpenDocument( xmlFilename, &documentHandle1 ) == SUCCESS );
+  ASSERT_TRUE( tixiCloseDocument( documentHandle1 ) == SUCCESS );
+
+  // a new document must never be reachable by the handle of a closed one
+  ASSERT_TRUE( tixiOpenDocument( xmlFilename, &documentHandle2 ) == SUCCESS );
+  ASSERT_TRUE( documentHandle1 != documentHandle2 );
+  ASSERT_TRUE( tixiCloseDocument( documentHandle1 ) == INVALID_HANDLE );
+  ASSERT_TRUE( tixiCheckElement( documentHandle1, "/plane" ) == INVALID_HANDLE );
+  ASSERT_TRUE( tixiCheckElement( documentHandle2, "/plane" ) == SUCCESS );
+  ASSERT_TRUE( tixiCloseDocument( documentHandle2 ) == SUCCESS );
+}
+
+TEST(closedocument_checks, many_documents)
+{
+  const int nDocuments = 100;
+  TixiDocumentHandle handles[nDocuments];
+
+  for (int i = 0; i < nDocuments; ++i) {
+    ASSERT_TRUE( tixiCreateDocument( "root", &handles[i] ) == SUCCESS );
+    for (int j = 0; j < i; ++j) {
+      ASSERT_TRUE( handles[i] != handles[j] );
+    }
+  }
+  for (int i = 0; i < nDocuments; i += 2) {
+    ASSERT_TRUE( tixiCloseDocument( handles[i] ) == SUCCESS );
+  }
+  for (int i = 1; i < nDocuments; i += 2) {
+    ASSERT_TRUE( tixiCheckElement( handles[i], "/root" ) == SUCCESS );
+    ASSERT_TRUE( tixiCloseDocument( handles[i] ) == SUCCESS );
+  }
+  for (int i = 0; i < nDocuments; ++i) {
+    ASSERT_TRUE( tixiCloseDocument( handles[i] ) == INVALID_HANDLE );
+  }
+}
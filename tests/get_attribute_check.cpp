@@ -171,3 +171,22 @@ TEST_F(GetAttributeTests, checkAttribute_notFound)
 
   ASSERT_EQ(ELEMENT_NOT_FOUND, tixiCheckAttribute(documentHandle, "/plane/wings/elementdoesnotexist", "top"));
 }
+
+TEST_F(GetAttributeTests, getTextAttributeInto)
+{
+  char buffer[32];
+  int needed = 0;
+
+  ASSERT_EQ(SUCCESS, tixiGetTextAttributeInto(documentHandle, "/plane/wings/wing[1]", "position", buffer, sizeof(buffer), &needed));
+  ASSERT_STREQ("left", buffer);
+  ASSERT_EQ(5, needed);
+
+  ASSERT_EQ(STRING_TRUNCATED, tixiGetTextAttributeInto(documentHandle, "/plane/wings/wing[1]", "position", buffer, 3, &needed));
+  ASSERT_STREQ("le", buffer);
+  ASSERT_EQ(5, needed);
+
+  ASSERT_EQ(ATTRIBUTE_NOT_FOUND, tixiGetTextAttributeInto(documentHandle, "/plane/wings/wing[1]", "non_existing_attribute", buffer, sizeof(buffer), &needed));
+  ASSERT_EQ(INVALID_NAMESPACE_PREFIX, tixiGetTextAttributeInto(documentHandle, "/plane/wings/wing[1]", "xyz:position", buffer, sizeof(buffer), &needed));
+  ASSERT_EQ(ELEMENT_PATH_NOT_UNIQUE, tixiGetTextAttributeInto(documentHandle, "/plane/wings/wing", "position", buffer, sizeof(buffer), &needed));
+  ASSERT_EQ(INVALID_HANDLE, tixiGetTextAttributeInto(-1, "/plane/wings/wing[1]", "position", buffer, sizeof(buffer), &needed));
+}
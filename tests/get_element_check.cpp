@@ -256,3 +256,30 @@ TEST_F(GetElementTests, GetChildElements)
   ASSERT_STREQ("#comment", string);
 }
 
+
+TEST_F(GetElementTests, getElementTextInto)
+{
+  char buffer[32];
+  int needed = 0;
+
+  ASSERT_EQ(SUCCESS, tixiGetTextElementInto(documentHandle, "/plane/name", buffer, sizeof(buffer), &needed));
+  ASSERT_STREQ("Junkers JU 52", buffer);
+  ASSERT_EQ(14, needed);
+
+  ASSERT_EQ(SUCCESS, tixiGetTextElementInto(documentHandle, "/plane/empty", buffer, sizeof(buffer), NULL));
+  ASSERT_STREQ("", buffer);
+
+  // query the size only
+  ASSERT_EQ(STRING_TRUNCATED, tixiGetTextElementInto(documentHandle, "/plane/name", NULL, 0, &needed));
+  ASSERT_EQ(14, needed);
+
+  // truncated, but null terminated
+  ASSERT_EQ(STRING_TRUNCATED, tixiGetTextElementInto(documentHandle, "/plane/name", buffer, 8, &needed));
+  ASSERT_STREQ("Junkers", buffer);
+  ASSERT_EQ(14, needed);
+
+  ASSERT_EQ(FAILED, tixiGetTextElementInto(documentHandle, "/plane/name", NULL, 8, &needed));
+  ASSERT_EQ(ELEMENT_NOT_FOUND, tixiGetTextElementInto(documentHandle, "/plane/nope", buffer, sizeof(buffer), &needed));
+  ASSERT_EQ(ELEMENT_PATH_NOT_UNIQUE, tixiGetTextElementInto(documentHandle, "/plane/wings/wing", buffer, sizeof(buffer), &needed));
+  ASSERT_EQ(INVALID_HANDLE, tixiGetTextElementInto(-1, "/plane/name", buffer, sizeof(buffer), &needed));
+}
@@ -28,20 +28,57 @@ TEST(InternalCheck, getChildNodeCount)
     TixiDocument *document = getDocument(handle);
 
     xmlNodePtr element = NULL;
-    ASSERT_EQ(SUCCESS, checkElement(document->xpathContext, "/root", &element));
+    ASSERT_EQ(SUCCESS, checkElement(document, "/root", &element));
     EXPECT_EQ(3, getChildNodeCount(element));
 
-    ASSERT_EQ(SUCCESS, checkElement(document->xpathContext, "/root/a", &element));
+    ASSERT_EQ(SUCCESS, checkElement(document, "/root/a", &element));
     EXPECT_EQ(1, getChildNodeCount(element));
 
-    ASSERT_EQ(SUCCESS, checkElement(document->xpathContext, "/root/a/text()", &element));
+    ASSERT_EQ(SUCCESS, checkElement(document, "/root/a/text()", &element));
     EXPECT_EQ(0, getChildNodeCount(element));
 
-    ASSERT_EQ(SUCCESS, checkElement(document->xpathContext, "/root/b", &element));
+    ASSERT_EQ(SUCCESS, checkElement(document, "/root/b", &element));
     EXPECT_EQ(3, getChildNodeCount(element));
 
-    ASSERT_EQ(SUCCESS, checkElement(document->xpathContext, "/root/b/c", &element));
+    ASSERT_EQ(SUCCESS, checkElement(document, "/root/b/c", &element));
     EXPECT_EQ(1, getChildNodeCount(element));
 
     tixiCloseDocument(handle);
 }
+
+TEST(InternalCheck, memoryArena)
+{
+    TixiDocumentHandle handle = 0;
+    ASSERT_EQ(SUCCESS, tixiOpenDocument("TestData/textelements.xml", &handle));
+    TixiDocument *document = getDocument(handle);
+
+    // small results share chunks and are aligned for doubles
+    char* first = copyToMemoryArena(document, "a");
+    char* second = copyToMemoryArena(document, "b");
+    ASSERT_TRUE(first != NULL && second != NULL);
+    EXPECT_STREQ("a", first);
+    EXPECT_STREQ("b", second);
+    EXPECT_TRUE(document->memoryArena->next == NULL);
+    EXPECT_EQ(0u, ((size_t) second) % sizeof(double));
+
+    // large results get a chunk of their own
+    double* large = (double*) allocateFromMemoryArena(document, 1000000 * sizeof(double));
+    ASSERT_TRUE(large != NULL);
+    large[999999] = 1.;
+    EXPECT_TRUE(document->memoryArena->next != NULL);
+
+    char* text = NULL;
+    for (int i = 0; i < 10000; ++i) {
+        ASSERT_EQ(SUCCESS, tixiGetTextElement(handle, "/root/a", &text));
+    }
+    int nChunks = 0;
+    for (TixiMemoryChunk* chunk = document->memoryArena; chunk; chunk = chunk->next) {
+        nChunks++;
+    }
+    EXPECT_LT(nChunks, 10);
+
+    ASSERT_EQ(SUCCESS, tixiReleaseReturnedMemory(handle));
+    EXPECT_TRUE(document->memoryArena == NULL);
+
+    tixiCloseDocument(handle);
+}
@@ -263,3 +263,63 @@ TEST(OtherTests2, cleanup)
   ASSERT_EQ(SUCCESS, tixiCleanup());
 }
 
+
+TEST_F(OtherTests, releaseReturnedMemory)
+{
+  char* text = NULL;
+  double* vector = NULL;
+  double values[] = {1., 2., 3.};
+
+  ASSERT_EQ(SUCCESS, tixiGetTextElement(inDocumentHandle, "/plane/name", &text));
+  ASSERT_EQ(SUCCESS, tixiReleaseReturnedMemory(inDocumentHandle));
+
+  // the document stays usable
+  ASSERT_EQ(SUCCESS, tixiGetTextElement(inDocumentHandle, "/plane/name", &text));
+  ASSERT_STREQ("Junkers JU 52", text);
+  ASSERT_EQ(SUCCESS, tixiAddFloatVector(outDocumentHandle, "/root", "vec", values, 3, "%g"));
+  ASSERT_EQ(SUCCESS, tixiGetFloatVector(outDocumentHandle, "/root/vec", &vector, 3));
+  ASSERT_EQ(3., vector[2]);
+  ASSERT_EQ(SUCCESS, tixiReleaseReturnedMemory(outDocumentHandle));
+
+  ASSERT_EQ(INVALID_HANDLE, tixiReleaseReturnedMemory(-1));
+}
+
+TEST_F(OtherTests, memoryScopes)
+{
+  char* outer = NULL;
+  char* text = NULL;
+  char* firstInLoop = NULL;
+
+  ASSERT_EQ(SUCCESS, tixiGetTextElement(inDocumentHandle, "/plane/name", &outer));
+
+  for (int i = 0; i < 1000; ++i) {
+    ASSERT_EQ(SUCCESS, tixiPushMemoryScope(inDocumentHandle));
+    ASSERT_EQ(SUCCESS, tixiGetTextElement(inDocumentHandle, "/plane/numberOfPassengers", &text));
+    ASSERT_STREQ("57", text);
+
+    // nested scopes
+    ASSERT_EQ(SUCCESS, tixiPushMemoryScope(inDocumentHandle));
+    ASSERT_EQ(SUCCESS, tixiExportDocumentAsString(inDocumentHandle, &text));
+    ASSERT_EQ(SUCCESS, tixiPopMemoryScope(inDocumentHandle));
+
+    ASSERT_EQ(SUCCESS, tixiGetTextElement(inDocumentHandle, "/plane/name", &text));
+    ASSERT_EQ(SUCCESS, tixiPopMemoryScope(inDocumentHandle));
+
+    // each iteration reuses the memory of the previous one
+    if (i == 0) {
+      firstInLoop = text;
+    }
+    ASSERT_EQ(firstInLoop, text);
+  }
+
+  // results of the enclosing scope stay valid
+  ASSERT_STREQ("Junkers JU 52", outer);
+
+  ASSERT_EQ(FAILED, tixiPopMemoryScope(inDocumentHandle));
+  ASSERT_EQ(SUCCESS, tixiPushMemoryScope(inDocumentHandle));
+  ASSERT_EQ(SUCCESS, tixiReleaseReturnedMemory(inDocumentHandle));
+  ASSERT_EQ(FAILED, tixiPopMemoryScope(inDocumentHandle));
+
+  ASSERT_EQ(INVALID_HANDLE, tixiPushMemoryScope(-1));
+  ASSERT_EQ(INVALID_HANDLE, tixiPopMemoryScope(-1));
+}
@@ -0,0 +1,291 @@
+/*
+* Copyright (C) 2026 German Aerospace Center (DLR/SC)
+*
+* Created: 2026-10-16
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+#include "test.h" // Brings in the GTest framework
+#include "tixi.h"
+
+#include <atomic>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+  const int nThreads = 8;
+  const int nIterations = 200;
+
+  // each thread works on its own documents and counts all unexpected results
+  void openQueryClose(int threadId, std::atomic<int>& nErrors)
+  {
+    std::string name = "thread" + std::to_string(threadId);
+
+    for (int i = 0; i < nIterations; ++i) {
+      TixiDocumentHandle created = -1;
+      TixiDocumentHandle opened = -1;
+      char* text = NULL;
+
+      if (tixiCreateDocument(name.c_str(), &created) != SUCCESS ||
+          tixiOpenDocument("TestData/in.xml", &opened) != SUCCESS) {
+        nErrors++;
+        continue;
+      }
+
+      if (tixiAddTextElement(created, ("/" + name).c_str(), "value", std::to_string(i).c_str()) != SUCCESS ||
+          tixiGetTextElement(created, ("/" + name + "/value").c_str(), &text) != SUCCESS ||
+          std::to_string(i) != text) {
+        nErrors++;
+      }
+
+      if (tixiGetTextElement(opened, "/plane/name", &text) != SUCCESS ||
+          std::string("Junkers JU 52") != text) {
+        nErrors++;
+      }
+
+      if (tixiCloseDocument(opened) != SUCCESS ||
+          tixiCloseDocument(created) != SUCCESS) {
+        nErrors++;
+      }
+
+      // the handles must stay invalid, although other threads reuse the slots
+      if (tixiCheckElement(created, ("/" + name).c_str()) != INVALID_HANDLE ||
+          tixiCloseDocument(opened) != INVALID_HANDLE) {
+        nErrors++;
+      }
+    }
+  }
+}
+
+TEST(threads_checks, open_query_close_concurrently)
+{
+  std::atomic<int> nErrors(0);
+  std::vector<std::thread> threads;
+
+  for (int i = 0; i < nThreads; ++i) {
+    threads.push_back(std::thread(openQueryClose, i, std::ref(nErrors)));
+  }
+  for (size_t i = 0; i < threads.size(); ++i) {
+    threads[i].join();
+  }
+
+  ASSERT_EQ(0, nErrors.load());
+}
+
+TEST(threads_checks, lookup_while_registering)
+{
+  std::atomic<int> nErrors(0);
+  std::atomic<bool> stop(false);
+  std::vector<TixiDocumentHandle> handles(nThreads, -1);
+  std::vector<std::thread> threads;
+
+  for (int i = 0; i < nThreads; ++i) {
+    ASSERT_EQ(SUCCESS, tixiCreateDocument("root", &handles[i]));
+  }
+
+  // readers query long living documents, while the table is constantly changing
+  for (int i = 0; i < nThreads; ++i) {
+    threads.push_back(std::thread([&, i]() {
+      while (!stop) {
+        if (tixiCheckElement(handles[i], "/root") != SUCCESS) {
+          nErrors++;
+        }
+      }
+    }));
+  }
+
+  // failures are only counted, the readers have to be joined before asserting
+  int nWriteErrors = 0;
+  for (int i = 0; i < 20 * nIterations; ++i) {
+    TixiDocumentHandle handle = -1;
+    if (tixiCreateDocument("tmp", &handle) != SUCCESS ||
+        tixiCloseDocument(handle) != SUCCESS) {
+      nWriteErrors++;
+    }
+  }
+  stop = true;
+
+  for (size_t i = 0; i < threads.size(); ++i) {
+    threads[i].join();
+  }
+  for (int i = 0; i < nThreads; ++i) {
+    ASSERT_EQ(SUCCESS, tixiCloseDocument(handles[i]));
+  }
+
+  ASSERT_EQ(0, nWriteErrors);
+  ASSERT_EQ(0, nErrors.load());
+}
+
+TEST(threads_checks, parallel_queries_on_shared_document)
+{
+  std::atomic<int> nErrors(0);
+  std::atomic<bool> stop(false);
+  std::vector<std::thread> threads;
+  TixiDocumentHandle handle = -1;
+
+  ASSERT_EQ(SUCCESS, tixiOpenDocument("TestData/in.xml", &handle));
+  ASSERT_EQ(SUCCESS, tixiSetThreadSafe(handle, 1));
+  ASSERT_EQ(SUCCESS, tixiRegisterNamespace(handle, "http://www.w3.org/2001/XMLSchema", "xsd"));
+
+  for (int i = 0; i < nThreads; ++i) {
+    threads.push_back(std::thread([&]() {
+      while (!stop) {
+        char* text = NULL;
+        char* xpath = NULL;
+        int count = -1;
+        double x = 0., y = 0., z = 0.;
+
+        if (tixiGetTextElement(handle, "/plane/name", &text) != SUCCESS ||
+            std::string("Junkers JU 52") != text) {
+          nErrors++;
+        }
+        if (tixiXPathEvaluateNodeNumber(handle, "//wing", &count) != SUCCESS || count != 2 ||
+            tixiXPathExpressionGetXPath(handle, "//wing", 2, &xpath) != SUCCESS ||
+            std::string("/plane/wings/wing[2]") != xpath) {
+          nErrors++;
+        }
+        if (tixiGetPoint(handle, "/plane/wings/wing[1]/centerOfGravity", &x, &y, &z) != SUCCESS ||
+            x != 30. || y != 10. || z != 5.) {
+          nErrors++;
+        }
+        // the writer toggles this element, it either exists once or not at all
+        if (tixiXPathEvaluateNodeNumber(handle, "/plane/log/entry", &count) != SUCCESS || count > 1) {
+          nErrors++;
+        }
+      }
+    }));
+  }
+
+  // failures are only counted, the readers have to be joined before asserting
+  int nWriteErrors = 0;
+  for (int i = 0; i < 10 * nIterations; ++i) {
+    if (tixiCreateElement(handle, "/plane", "log") != SUCCESS ||
+        tixiAddTextElement(handle, "/plane/log", "entry", std::to_string(i).c_str()) != SUCCESS ||
+        tixiRemoveElement(handle, "/plane/log") != SUCCESS) {
+      nWriteErrors++;
+    }
+  }
+  stop = true;
+
+  for (size_t i = 0; i < threads.size(); ++i) {
+    threads[i].join();
+  }
+
+  ASSERT_EQ(0, nWriteErrors);
+  ASSERT_EQ(0, nErrors.load());
+  ASSERT_EQ(SUCCESS, tixiSetThreadSafe(handle, 0));
+  ASSERT_EQ(ELEMENT_NOT_FOUND, tixiCheckElement(handle, "/plane/log"));
+  ASSERT_EQ(SUCCESS, tixiCloseDocument(handle));
+  ASSERT_EQ(INVALID_HANDLE, tixiSetThreadSafe(handle, 1));
+}
+
+TEST(threads_checks, save_and_remove_while_reading)
+{
+  std::atomic<int> nErrors(0);
+  std::atomic<bool> stop(false);
+  std::vector<std::thread> threads;
+  TixiDocumentHandle handle = -1;
+
+  ASSERT_EQ(SUCCESS, tixiOpenDocument("TestData/in.xml", &handle));
+  ASSERT_EQ(SUCCESS, tixiSetThreadSafe(handle, 1));
+
+  for (int i = 0; i < nThreads; ++i) {
+    threads.push_back(std::thread([&]() {
+      while (!stop) {
+        char* text = NULL;
+        int count = -1;
+
+        if (tixiGetTextElement(handle, "/plane/name", &text) != SUCCESS ||
+            std::string("Junkers JU 52") != text ||
+            tixiXPathEvaluateNodeNumber(handle, "//wing", &count) != SUCCESS || count != 2) {
+          nErrors++;
+        }
+      }
+    }));
+  }
+
+  // two writers replace the file name of the document concurrently
+  std::thread writer([&]() {
+    for (int i = 0; i < nIterations / 4; ++i) {
+      if (tixiSaveAndRemoveDocument(handle, "threads_saved_1.xml") != SUCCESS) {
+        nErrors++;
+      }
+    }
+  });
+  for (int i = 0; i < nIterations / 4; ++i) {
+    if (tixiSaveDocument(handle, "threads_saved_2.xml") != SUCCESS) {
+      nErrors++;
+    }
+  }
+  writer.join();
+  stop = true;
+
+  for (size_t i = 0; i < threads.size(); ++i) {
+    threads[i].join();
+  }
+
+  ASSERT_EQ(0, nErrors.load());
+  ASSERT_EQ(SUCCESS, tixiCloseDocument(handle));
+  std::remove("threads_saved_1.xml");
+  std::remove("threads_saved_2.xml");
+}
+
+TEST(threads_checks, parallel_uid_lookups)
+{
+  std::atomic<int> nErrors(0);
+  std::vector<std::thread> threads;
+  TixiDocumentHandle handle = -1;
+
+  ASSERT_EQ(SUCCESS, tixiCreateDocument("model", &handle));
+  for (int i = 0; i < 100; ++i) {
+    std::string path = "/model/wing[" + std::to_string(i + 1) + "]";
+    ASSERT_EQ(SUCCESS, tixiCreateElement(handle, "/model", "wing"));
+    ASSERT_EQ(SUCCESS, tixiAddTextAttribute(handle, path.c_str(), "uID", ("wing" + std::to_string(i)).c_str()));
+    ASSERT_EQ(SUCCESS, tixiAddIntegerElement(handle, path.c_str(), "index", i, NULL));
+  }
+  ASSERT_EQ(SUCCESS, tixiSetThreadSafe(handle, 1));
+
+  // the first readers build the uid index concurrently
+  for (int i = 0; i < nThreads; ++i) {
+    threads.push_back(std::thread([&, i]() {
+      for (int j = 0; j < nIterations; ++j) {
+        int wing = (i * 7 + j) % 100;
+        int index = -1;
+        if (tixiGetIntegerElementByUID(handle, ("wing" + std::to_string(wing)).c_str(), "index", &index) != SUCCESS ||
+            index != wing) {
+          nErrors++;
+        }
+        std::string uID = "wing" + std::to_string(wing);
+        const char* uIDs[2] = {uID.c_str(), "missing"};
+        char* xPaths[2] = {NULL, NULL};
+        char* xPath = NULL;
+        std::string expected = "/model/wing[" + std::to_string(wing + 1) + "]";
+        if (tixiUIDGetXPath(handle, uID.c_str(), &xPath) != SUCCESS || expected != xPath ||
+            tixiUIDGetXPaths(handle, uIDs, 2, xPaths) != SUCCESS || expected != xPaths[0] ||
+            tixiUIDCheckExists(handle, uID.c_str()) != SUCCESS) {
+          nErrors++;
+        }
+      }
+    }));
+  }
+  for (size_t i = 0; i < threads.size(); ++i) {
+    threads[i].join();
+  }
+
+  ASSERT_EQ(0, nErrors.load());
+  ASSERT_EQ(SUCCESS, tixiCloseDocument(handle));
+}
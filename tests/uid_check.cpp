@@ -19,6 +19,9 @@
 #include "test.h" // Brings in the GTest framework
 #include "tixi.h"
 
+#include <climits>
+#include <string>
+#include <vector>
 
 static const char* filename_uid_correct = "TestData/uid_correct.xml";
 static const char* filename_uid_duplicated = "TestData/uid_duplicated.xml";
@@ -27,6 +30,15 @@ static const char* filename_links_broken = "TestData/uid_broken_link.xml";
 static const char* filename_links = "TestData/uid_link.xml";
 static const char* xmlFilename = "TestData/xpaths.xml";
 
+static std::vector<std::string> messages;
+
+static void collectMessage(MessageType type, const char* message)
+{
+  if (type == MESSAGETYPE_ERROR || type == MESSAGETYPE_WARNING) {
+    messages.push_back(message);
+  }
+}
+
 
 
 TEST(xpath_checks, xpath_generation)
@@ -124,3 +136,410 @@ TEST(uid_checks, tixiUIDCheck_checkLink)
   ASSERT_TRUE( tixiUIDCheckLinks(documentHandle) == SUCCESS );
   ASSERT_TRUE( tixiCloseDocument( documentHandle ) == SUCCESS );
 }
+
+TEST(uid_checks, tixiUIDIndex_updatedOnModification)
+{
+  TixiDocumentHandle documentHandle = -1;
+  char* xpath = NULL;
+
+  ASSERT_TRUE( tixiOpenDocument( filename_uid_correct, &documentHandle ) == SUCCESS );
+  ASSERT_TRUE( tixiUIDCheckExists( documentHandle, "b" ) == SUCCESS );
+
+  /* changing and removing uID attributes */
+  ASSERT_TRUE( tixiAddTextAttribute( documentHandle, "/root/a[1]/b[2]", "uID", "b_renamed" ) == SUCCESS );
+  ASSERT_TRUE( tixiUIDCheckExists( documentHandle, "b" ) == UID_DONT_EXISTS );
+  ASSERT_TRUE( tixiUIDGetXPath( documentHandle, "b_renamed", &xpath ) == SUCCESS );
+  ASSERT_TRUE( !strcmp(xpath, "/root/a[1]/b[2]") );
+  ASSERT_TRUE( tixiRemoveAttribute( documentHandle, "/root/a[1]/b[2]", "uID" ) == SUCCESS );
+  ASSERT_TRUE( tixiUIDCheckExists( documentHandle, "b_renamed" ) == UID_DONT_EXISTS );
+
+  /* removing an element removes the uIDs of all its children */
+  ASSERT_TRUE( tixiRemoveElement( documentHandle, "/root/a[1]" ) == SUCCESS );
+  ASSERT_TRUE( tixiUIDCheckExists( documentHandle, "test" ) == UID_DONT_EXISTS );
+  ASSERT_TRUE( tixiUIDCheckExists( documentHandle, "a" ) == UID_DONT_EXISTS );
+  ASSERT_TRUE( tixiUIDCheckExists( documentHandle, "schlumpf" ) == SUCCESS );
+
+  /* imported elements */
+  ASSERT_TRUE( tixiImportElementFromString( documentHandle, "/root", "<d uID=\"imported\"><e uID=\"nested\"/></d>" ) == SUCCESS );
+  ASSERT_TRUE( tixiUIDGetXPath( documentHandle, "nested", &xpath ) == SUCCESS );
+  ASSERT_TRUE( !strcmp(xpath, "/root/d/e") );
+  ASSERT_TRUE( tixiUIDCheckDuplicates( documentHandle ) == SUCCESS );
+
+  /* the other elements moved, but their uIDs still resolve to them */
+  ASSERT_TRUE( tixiUIDGetXPath( documentHandle, "empty_element", &xpath ) == SUCCESS );
+  ASSERT_TRUE( !strcmp(xpath, "/root/a/b[2]") );
+  ASSERT_TRUE( tixiCloseDocument( documentHandle ) == SUCCESS );
+}
+
+TEST(uid_checks, tixiUIDIndex_duplicatesResolved)
+{
+  TixiDocumentHandle documentHandle = -1;
+  char* xpath = NULL;
+
+  ASSERT_TRUE( tixiOpenDocument( filename_uid_duplicated, &documentHandle ) == SUCCESS );
+  ASSERT_TRUE( tixiUIDCheckDuplicates( documentHandle ) == UID_NOT_UNIQUE );
+
+  /* the remaining element with the uID is found after removing the duplicate */
+  ASSERT_TRUE( tixiRemoveElement( documentHandle, "/root/a[1]/b[1]" ) == SUCCESS );
+  ASSERT_TRUE( tixiUIDCheckDuplicates( documentHandle ) == SUCCESS );
+  ASSERT_TRUE( tixiUIDGetXPath( documentHandle, "a", &xpath ) == SUCCESS );
+  ASSERT_TRUE( !strcmp(xpath, "/root/b/c") );
+
+  /* setting an existing uID creates a duplicate again */
+  ASSERT_TRUE( tixiAddTextAttribute( documentHandle, "/root/a[2]/b[1]", "uID", "a" ) == SUCCESS );
+  ASSERT_TRUE( tixiUIDCheckDuplicates( documentHandle ) == UID_NOT_UNIQUE );
+  ASSERT_TRUE( tixiAddTextAttribute( documentHandle, "/root/a[2]/b[1]", "uID", "unique" ) == SUCCESS );
+  ASSERT_TRUE( tixiUIDCheckDuplicates( documentHandle ) == SUCCESS );
+  ASSERT_TRUE( tixiCloseDocument( documentHandle ) == SUCCESS );
+}
+
+TEST(uid_checks, tixiUIDCheck_reportAllDuplicates)
+{
+  TixiDocumentHandle documentHandle = -1;
+
+  ASSERT_TRUE( tixiOpenDocument( filename_uid_duplicated, &documentHandle ) == SUCCESS );
+  ASSERT_TRUE( tixiAddTextAttribute( documentHandle, "/root/a[2]/b[1]", "uID", "test" ) == SUCCESS );
+
+  messages.clear();
+  TixiPrintMsgFnc previous = tixiGetPrintMsgFunc();
+  tixiSetPrintMsgFunc(collectMessage);
+  ReturnCode result = tixiUIDCheckDuplicates( documentHandle );
+  tixiSetPrintMsgFunc(previous);
+  ASSERT_TRUE( result == UID_NOT_UNIQUE );
+
+  /* both duplicates are reported in document order, together with their paths */
+  ASSERT_EQ(6u, messages.size());
+  ASSERT_STREQ("Error: duplicated uID 'test' found 2 times:\n", messages[0].c_str());
+  ASSERT_STREQ("  /root/a[1]\n", messages[1].c_str());
+  ASSERT_STREQ("  /root/a[2]/b[1]\n", messages[2].c_str());
+  ASSERT_STREQ("Error: duplicated uID 'a' found 2 times:\n", messages[3].c_str());
+  ASSERT_STREQ("  /root/a[1]/b[1]\n", messages[4].c_str());
+  ASSERT_STREQ("  /root/b/c\n", messages[5].c_str());
+
+  ASSERT_TRUE( tixiCloseDocument( documentHandle ) == SUCCESS );
+}
+
+TEST(uid_checks, tixiUIDGetXPath_singleWarning)
+{
+  TixiDocumentHandle documentHandle = -1;
+  char* xPath = NULL;
+
+  ASSERT_TRUE( tixiOpenDocument( filename_uid_duplicated, &documentHandle ) == SUCCESS );
+
+  /* lookups only warn once each, the duplicates are listed by tixiUIDCheckDuplicates */
+  messages.clear();
+  TixiPrintMsgFnc previous = tixiGetPrintMsgFunc();
+  tixiSetPrintMsgFunc(collectMessage);
+  ReturnCode result = tixiUIDGetXPath( documentHandle, "schlumpf", &xPath );
+  ReturnCode result2 = tixiUIDGetXPath( documentHandle, "b", &xPath );
+  tixiSetPrintMsgFunc(previous);
+  ASSERT_TRUE( result == SUCCESS );
+  ASSERT_TRUE( result2 == SUCCESS );
+  ASSERT_STREQ("/root/a[1]/b[2]", xPath);
+  ASSERT_EQ(2u, messages.size());
+  ASSERT_STREQ("Warning: There are duplicated UID's in the data set!", messages[0].c_str());
+
+  ASSERT_TRUE( tixiCloseDocument( documentHandle ) == SUCCESS );
+}
+
+TEST(uid_checks, tixiUIDGetBrokenLinks)
+{
+  TixiDocumentHandle documentHandle = -1;
+  int nBrokenLinks = -1;
+  char* linkPaths[3] = {NULL, NULL, NULL};
+
+  ASSERT_TRUE( tixiOpenDocument( filename_links, &documentHandle ) == SUCCESS );
+  ASSERT_TRUE( tixiUIDGetBrokenLinksCount( documentHandle, &nBrokenLinks ) == SUCCESS );
+  ASSERT_EQ(0, nBrokenLinks);
+
+  /* break the existing link and add two more */
+  ASSERT_TRUE( tixiAddTextAttribute( documentHandle, "/root/a[1]", "uID", "renamed" ) == SUCCESS );
+  ASSERT_TRUE( tixiAddTextAttribute( documentHandle, "/root/a[1]/b[2]", "isLink", "missing" ) == SUCCESS );
+  ASSERT_TRUE( tixiAddTextAttribute( documentHandle, "/root/a[2]/b[1]", "isLink", "renamed" ) == SUCCESS );
+  ASSERT_TRUE( tixiAddTextAttribute( documentHandle, "/root/a[2]/b[2]", "isLink", "" ) == SUCCESS );
+  ASSERT_TRUE( tixiUIDCheckLinks( documentHandle ) == UID_LINK_BROKEN );
+
+  ASSERT_TRUE( tixiUIDGetBrokenLinksCount( documentHandle, &nBrokenLinks ) == SUCCESS );
+  ASSERT_EQ(3, nBrokenLinks);
+  ASSERT_TRUE( tixiUIDGetBrokenLinks( documentHandle, linkPaths ) == SUCCESS );
+  ASSERT_STREQ("/root/a[1]/b[2]", linkPaths[0]);
+  ASSERT_STREQ("/root/a[2]/b[2]", linkPaths[1]);
+  ASSERT_STREQ("/root/b/c", linkPaths[2]);
+
+  ASSERT_TRUE( tixiUIDGetBrokenLinksCount( -1, &nBrokenLinks ) == INVALID_HANDLE );
+  ASSERT_TRUE( tixiCloseDocument( documentHandle ) == SUCCESS );
+}
+
+TEST(uid_checks, tixiUIDGetReferencingXPaths)
+{
+  TixiDocumentHandle documentHandle = -1;
+  int count = -1;
+  char* xpaths[3] = {NULL, NULL, NULL};
+
+  ASSERT_TRUE( tixiOpenDocument( filename_links, &documentHandle ) == SUCCESS );
+  ASSERT_TRUE( tixiUIDGetReferencingXPathsCount( documentHandle, "test", &count ) == SUCCESS );
+  ASSERT_EQ(1, count);
+  ASSERT_TRUE( tixiUIDGetReferencingXPaths( documentHandle, "test", xpaths ) == SUCCESS );
+  ASSERT_STREQ("/root/b/c", xpaths[0]);
+  ASSERT_TRUE( tixiUIDGetReferencingXPathsCount( documentHandle, "a", &count ) == SUCCESS );
+  ASSERT_EQ(0, count);
+
+  /* the index follows modifications, the paths are in document order */
+  ASSERT_TRUE( tixiAddTextAttribute( documentHandle, "/root/a[2]/b[1]", "isLink", "test" ) == SUCCESS );
+  ASSERT_TRUE( tixiAddTextAttribute( documentHandle, "/root/a[1]/b[1]", "isLink", "test" ) == SUCCESS );
+  ASSERT_TRUE( tixiAddTextAttribute( documentHandle, "/root/a[1]/b[2]", "isLink", "a" ) == SUCCESS );
+  ASSERT_TRUE( tixiUIDGetReferencingXPathsCount( documentHandle, "test", &count ) == SUCCESS );
+  ASSERT_EQ(3, count);
+  ASSERT_TRUE( tixiUIDGetReferencingXPaths( documentHandle, "test", xpaths ) == SUCCESS );
+  ASSERT_STREQ("/root/a[1]/b[1]", xpaths[0]);
+  ASSERT_STREQ("/root/a[2]/b[1]", xpaths[1]);
+  ASSERT_STREQ("/root/b/c", xpaths[2]);
+
+  /* retargeting and removing links, removing the uID keeps the link of the element */
+  ASSERT_TRUE( tixiAddTextAttribute( documentHandle, "/root/a[1]/b[2]", "isLink", "test" ) == SUCCESS );
+  ASSERT_TRUE( tixiRemoveAttribute( documentHandle, "/root/a[1]/b[1]", "isLink" ) == SUCCESS );
+  ASSERT_TRUE( tixiRemoveAttribute( documentHandle, "/root/b/c", "uID" ) == SUCCESS );
+  ASSERT_TRUE( tixiRemoveElement( documentHandle, "/root/a[2]" ) == SUCCESS );
+  ASSERT_TRUE( tixiUIDGetReferencingXPathsCount( documentHandle, "a", &count ) == SUCCESS );
+  ASSERT_EQ(0, count);
+  ASSERT_TRUE( tixiUIDGetReferencingXPathsCount( documentHandle, "test", &count ) == SUCCESS );
+  ASSERT_EQ(2, count);
+  ASSERT_TRUE( tixiUIDGetReferencingXPaths( documentHandle, "test", xpaths ) == SUCCESS );
+  ASSERT_STREQ("/root/a/b[2]", xpaths[0]);
+  ASSERT_STREQ("/root/b/c", xpaths[1]);
+
+  ASSERT_TRUE( tixiUIDGetReferencingXPathsCount( documentHandle, NULL, &count ) == FAILED );
+  ASSERT_TRUE( tixiUIDGetReferencingXPaths( documentHandle, "test", NULL ) == FAILED );
+  ASSERT_TRUE( tixiUIDGetReferencingXPathsCount( -1, "test", &count ) == INVALID_HANDLE );
+  ASSERT_TRUE( tixiCloseDocument( documentHandle ) == SUCCESS );
+}
+
+TEST(uid_checks, tixiUIDSetEnforceUnique)
+{
+  TixiDocumentHandle documentHandle = -1;
+  char* xpath = NULL;
+  double values[2] = {1., 2.};
+  const char* uids[2] = {"list1", "list2"};
+  const char* duplicatedUids[2] = {"list3", "test"};
+
+  ASSERT_TRUE( tixiOpenDocument( filename_uid_duplicated, &documentHandle ) == SUCCESS );
+  ASSERT_TRUE( tixiUIDSetEnforceUnique( documentHandle, 1 ) == UID_NOT_UNIQUE );
+  ASSERT_TRUE( tixiCloseDocument( documentHandle ) == SUCCESS );
+
+  ASSERT_TRUE( tixiOpenDocument( filename_uid_correct, &documentHandle ) == SUCCESS );
+  ASSERT_TRUE( tixiUIDSetEnforceUnique( documentHandle, 1 ) == SUCCESS );
+
+  /* duplicates are rejected on write and the document stays unchanged */
+  ASSERT_TRUE( tixiUIDSetToXPath( documentHandle, "/root/a[2]", "test" ) == UID_NOT_UNIQUE );
+  ASSERT_TRUE( tixiAddTextAttribute( documentHandle, "/root/a[2]/b[1]", "uID", "b" ) == UID_NOT_UNIQUE );
+  ASSERT_TRUE( tixiCheckAttribute( documentHandle, "/root/a[2]/b[1]", "uID" ) == ATTRIBUTE_NOT_FOUND );
+  ASSERT_TRUE( tixiImportElementFromString( documentHandle, "/root", "<c><d uID=\"new\"/><d uID=\"a\"/></c>" ) == UID_NOT_UNIQUE );
+  ASSERT_TRUE( tixiCheckElement( documentHandle, "/root/c" ) == ELEMENT_NOT_FOUND );
+  ASSERT_TRUE( tixiImportElementFromString( documentHandle, "/root", "<c><d uID=\"new\"/><d uID=\"new\"/></c>" ) == UID_NOT_UNIQUE );
+  ASSERT_TRUE( tixiAddDoubleListWithAttributes( documentHandle, "/root", "list", "value", "uID", values, NULL, duplicatedUids, 2 ) == UID_NOT_UNIQUE );
+  ASSERT_TRUE( tixiCheckElement( documentHandle, "/root/list" ) == ELEMENT_NOT_FOUND );
+  ASSERT_TRUE( tixiUIDCheckExists( documentHandle, "new" ) == UID_DONT_EXISTS );
+  ASSERT_TRUE( tixiUIDCheckExists( documentHandle, "list3" ) == UID_DONT_EXISTS );
+
+  /* new and unchanged uIDs are accepted */
+  ASSERT_TRUE( tixiUIDSetToXPath( documentHandle, "/root/a[2]/b[1]", "new" ) == SUCCESS );
+  ASSERT_TRUE( tixiUIDSetToXPath( documentHandle, "/root/a[2]/b[1]", "new" ) == SUCCESS );
+  ASSERT_TRUE( tixiImportElementFromString( documentHandle, "/root", "<c><d uID=\"d1\"/><d uID=\"d2\"/></c>" ) == SUCCESS );
+  ASSERT_TRUE( tixiAddDoubleListWithAttributes( documentHandle, "/root", "list", "value", "uID", values, NULL, uids, 2 ) == SUCCESS );
+  ASSERT_TRUE( tixiUIDGetXPath( documentHandle, "d2", &xpath ) == SUCCESS );
+  ASSERT_STREQ("/root/c/d[2]", xpath);
+
+  /* a uID can be moved to another element after its removal */
+  ASSERT_TRUE( tixiRemoveAttribute( documentHandle, "/root/c/d[1]", "uID" ) == SUCCESS );
+  ASSERT_TRUE( tixiUIDSetToXPath( documentHandle, "/root/a[1]", "d1" ) == SUCCESS );
+  ASSERT_TRUE( tixiUIDCheckDuplicates( documentHandle ) == SUCCESS );
+
+  /* without enforcement, duplicates can be written again */
+  ASSERT_TRUE( tixiUIDSetEnforceUnique( documentHandle, 0 ) == SUCCESS );
+  ASSERT_TRUE( tixiAddTextAttribute( documentHandle, "/root/c/d[1]", "uID", "d2" ) == SUCCESS );
+  ASSERT_TRUE( tixiUIDCheckDuplicates( documentHandle ) == UID_NOT_UNIQUE );
+
+  ASSERT_TRUE( tixiUIDSetEnforceUnique( -1, 1 ) == INVALID_HANDLE );
+  ASSERT_TRUE( tixiCloseDocument( documentHandle ) == SUCCESS );
+}
+
+TEST(uid_checks, tixiUIDSetEnforceUnique_externalLink)
+{
+  TixiDocumentHandle documentHandle = -1;
+
+  ASSERT_TRUE( tixiOpenDocument( filename_uid_correct, &documentHandle ) == SUCCESS );
+  ASSERT_TRUE( tixiUIDSetEnforceUnique( documentHandle, 1 ) == SUCCESS );
+
+  /* unique uIDs of external files are accepted */
+  ASSERT_TRUE( tixiAddExternalLink( documentHandle, "/root/a[1]", ".", "uid_external.xml", ADDLINK_CREATE_AND_OPEN ) == SUCCESS );
+  ASSERT_TRUE( tixiUIDCheckExists( documentHandle, "external" ) == SUCCESS );
+  ASSERT_TRUE( tixiUIDSetToXPath( documentHandle, "/root/a[2]", "external" ) == UID_NOT_UNIQUE );
+
+  /* linked files with a uID in use are rejected and the document stays unchanged */
+  ASSERT_TRUE( tixiAddExternalLink( documentHandle, "/root/a[2]", ".", "uid_external_duplicated.xml", ADDLINK_CREATE_AND_OPEN ) == UID_NOT_UNIQUE );
+  ASSERT_TRUE( tixiCheckElement( documentHandle, "/root/a[2]/external" ) == ELEMENT_NOT_FOUND );
+  ASSERT_TRUE( tixiCheckElement( documentHandle, "/root/a[2]/externaldata" ) == ELEMENT_NOT_FOUND );
+  ASSERT_TRUE( tixiCheckElement( documentHandle, "/root/a[2]/b[2]" ) == SUCCESS );
+  ASSERT_TRUE( tixiCheckElement( documentHandle, "/root/a[2]/b[3]" ) == ELEMENT_NOT_FOUND );
+  ASSERT_TRUE( tixiUIDCheckDuplicates( documentHandle ) == SUCCESS );
+
+  /* the enforcement is still on */
+  ASSERT_TRUE( tixiAddTextAttribute( documentHandle, "/root/a[2]/b[1]", "uID", "b" ) == UID_NOT_UNIQUE );
+  ASSERT_TRUE( tixiAddExternalLink( documentHandle, "/root/a[2]", ".", "uid_external_duplicated.xml", ADDLINK_CREATE_AND_OPEN ) == UID_NOT_UNIQUE );
+  ASSERT_TRUE( tixiUIDSetEnforceUnique( documentHandle, 0 ) == SUCCESS );
+  ASSERT_TRUE( tixiAddExternalLink( documentHandle, "/root/a[2]", ".", "uid_external_duplicated.xml", ADDLINK_CREATE_AND_OPEN ) == SUCCESS );
+  ASSERT_TRUE( tixiUIDCheckDuplicates( documentHandle ) == UID_NOT_UNIQUE );
+
+  ASSERT_TRUE( tixiCloseDocument( documentHandle ) == SUCCESS );
+}
+
+namespace
+{
+  // collects all results of the uid checks of a document, that has been read with nThreads
+  std::vector<std::string> checkUIDs(const std::string& xml, int nThreads)
+  {
+    TixiDocumentHandle documentHandle = -1;
+    std::vector<std::string> results;
+    std::vector<const char*> uids;
+    std::vector<char*> paths;
+    std::vector<std::string> names;
+    int nBrokenLinks = 0;
+
+    EXPECT_EQ(SUCCESS, tixiImportFromString(xml.c_str(), &documentHandle));
+    EXPECT_EQ(SUCCESS, tixiUIDSetCheckThreads(documentHandle, nThreads));
+
+    messages.clear();
+    TixiPrintMsgFnc previous = tixiGetPrintMsgFunc();
+    tixiSetPrintMsgFunc(collectMessage);
+    results.push_back(std::to_string(tixiUIDCheckDuplicates(documentHandle)));
+    results.push_back(std::to_string(tixiUIDCheckLinks(documentHandle)));
+    tixiSetPrintMsgFunc(previous);
+    results.insert(results.end(), messages.begin(), messages.end());
+
+    EXPECT_EQ(SUCCESS, tixiUIDGetBrokenLinksCount(documentHandle, &nBrokenLinks));
+    paths.resize(nBrokenLinks);
+    EXPECT_EQ(SUCCESS, tixiUIDGetBrokenLinks(documentHandle, paths.data()));
+    results.insert(results.end(), paths.begin(), paths.end());
+
+    for (int i = 0; i < 300; ++i) {
+      names.push_back("section" + std::to_string(i));
+    }
+    for (size_t i = 0; i < names.size(); ++i) {
+      uids.push_back(names[i].c_str());
+    }
+    paths.resize(uids.size());
+    EXPECT_EQ(SUCCESS, tixiUIDGetXPaths(documentHandle, uids.data(), (int) uids.size(), paths.data()));
+    results.insert(results.end(), paths.begin(), paths.end());
+
+    EXPECT_EQ(SUCCESS, tixiCloseDocument(documentHandle));
+    return results;
+  }
+}
+
+TEST(uid_checks, tixiUIDSetCheckThreads)
+{
+  // wings of different size, with duplicated uids and broken links spread over the document
+  std::string xml = "<model uID=\"model\">";
+  for (int wing = 0; wing < 50; ++wing) {
+    xml += "<wing uID=\"wing" + std::to_string(wing) + "\"><sections>";
+    for (int section = 0; section < wing % 7 + 1; ++section) {
+      int number = (wing * 5 + section) % 250;
+      xml += "<section uID=\"section" + std::to_string(number) + "\">";
+      xml += "<parent isLink=\"wing" + std::to_string(wing + section) + "\"/></section>";
+    }
+    xml += "</sections></wing>";
+  }
+  xml += "</model>";
+
+  std::vector<std::string> sequential = checkUIDs(xml, 1);
+  ASSERT_EQ(std::to_string(UID_NOT_UNIQUE), sequential[0]);
+  ASSERT_EQ(std::to_string(UID_LINK_BROKEN), sequential[1]);
+
+  ASSERT_TRUE(sequential == checkUIDs(xml, 2));
+  ASSERT_TRUE(sequential == checkUIDs(xml, 8));
+  ASSERT_TRUE(sequential == checkUIDs(xml, 64));
+  // huge numbers are limited
+  ASSERT_TRUE(sequential == checkUIDs(xml, INT_MAX));
+
+  TixiDocumentHandle documentHandle = -1;
+  ASSERT_EQ(SUCCESS, tixiCreateDocument("root", &documentHandle));
+  ASSERT_EQ(FAILED, tixiUIDSetCheckThreads(documentHandle, -1));
+  ASSERT_EQ(SUCCESS, tixiUIDSetCheckThreads(documentHandle, 4));
+  ASSERT_EQ(SUCCESS, tixiUIDCheckDuplicates(documentHandle));
+  ASSERT_EQ(SUCCESS, tixiCloseDocument(documentHandle));
+  ASSERT_EQ(INVALID_HANDLE, tixiUIDSetCheckThreads(-1, 4));
+}
+
+TEST(uid_checks, tixiUIDGetXPaths)
+{
+  TixiDocumentHandle documentHandle = -1;
+  const char* uids[4] = {"b", "c_element", "i_do_not_exist", "test"};
+  char* xpaths[4] = {NULL, NULL, NULL, NULL};
+
+  ASSERT_TRUE( tixiOpenDocument( filename_uid_correct, &documentHandle ) == SUCCESS );
+  ASSERT_TRUE( tixiUIDGetXPaths( documentHandle, uids, 4, xpaths ) == SUCCESS );
+  ASSERT_STREQ("/root/a[1]/b[2]", xpaths[0]);
+  ASSERT_STREQ("/root/b/c", xpaths[1]);
+  ASSERT_STREQ("", xpaths[2]);
+  ASSERT_STREQ("/root/a[1]", xpaths[3]);
+
+  ASSERT_TRUE( tixiUIDGetXPaths( documentHandle, uids, 0, NULL ) == SUCCESS );
+  ASSERT_TRUE( tixiUIDGetXPaths( documentHandle, NULL, 4, xpaths ) == FAILED );
+  ASSERT_TRUE( tixiUIDGetXPaths( -1, uids, 4, xpaths ) == INVALID_HANDLE );
+  ASSERT_TRUE( tixiCloseDocument( documentHandle ) == SUCCESS );
+}
+
+TEST(uid_checks, tixiGetElementByUID)
+{
+  TixiDocumentHandle documentHandle = -1;
+  const char* xml =
+      "<model>"
+      "<wing uID=\"wing1\"><span>12.5</span><sections><section><count>3</count></section>"
+      "<section uID=\"section2\"><count>4</count><name>tip</name></section></sections></wing>"
+      "<wing uID=\"wing2\"><span>no number</span></wing>"
+      "<ns:part xmlns:ns=\"http://example.org\" uID=\"part\"><ns:x>1.5</ns:x></ns:part>"
+      "<label uID=\"label1\">front</label>"
+      "<dup uID=\"twice\"/><dup uID=\"twice\"/>"
+      "</model>";
+  char* text = NULL;
+  double value = 0.;
+  int number = 0;
+
+  ASSERT_TRUE( tixiImportFromString( xml, &documentHandle ) == SUCCESS );
+
+  ASSERT_TRUE( tixiGetDoubleElementByUID( documentHandle, "wing1", "span", &value ) == SUCCESS );
+  ASSERT_EQ(12.5, value);
+  ASSERT_TRUE( tixiGetIntegerElementByUID( documentHandle, "wing1", "sections/section[1]/count", &number ) == SUCCESS );
+  ASSERT_EQ(3, number);
+  ASSERT_TRUE( tixiGetTextElementByUID( documentHandle, "section2", "name/", &text ) == SUCCESS );
+  ASSERT_STREQ("tip", text);
+
+  /* the element with the uid itself and paths evaluated by the xpath engine */
+  ASSERT_TRUE( tixiGetTextElementByUID( documentHandle, "label1", "", &text ) == SUCCESS );
+  ASSERT_STREQ("front", text);
+  ASSERT_TRUE( tixiGetIntegerElementByUID( documentHandle, "section2", NULL, &number ) == NO_NUMBER );
+  ASSERT_TRUE( tixiGetIntegerElementByUID( documentHandle, "section2", "../section[1]/count", &number ) == SUCCESS );
+  ASSERT_EQ(3, number);
+  ASSERT_TRUE( tixiGetIntegerElementByUID( documentHandle, "wing1", ".//section[@uID='section2']/count", &number ) == SUCCESS );
+  ASSERT_EQ(4, number);
+  ASSERT_TRUE( tixiRegisterNamespace( documentHandle, "http://example.org", "ex" ) == SUCCESS );
+  ASSERT_TRUE( tixiGetDoubleElementByUID( documentHandle, "part", "ex:x", &value ) == SUCCESS );
+  ASSERT_EQ(1.5, value);
+
+  /* errors */
+  ASSERT_TRUE( tixiGetDoubleElementByUID( documentHandle, "wing2", "span", &value ) == NO_NUMBER );
+  ASSERT_TRUE( tixiGetDoubleElementByUID( documentHandle, "wing1", "sections/section", &value ) == ELEMENT_PATH_NOT_UNIQUE );
+  ASSERT_TRUE( tixiGetDoubleElementByUID( documentHandle, "wing1", "chord", &value ) == ELEMENT_NOT_FOUND );
+  ASSERT_TRUE( tixiGetDoubleElementByUID( documentHandle, "wing1", "span[", &value ) == INVALID_XPATH );
+  ASSERT_TRUE( tixiGetDoubleElementByUID( documentHandle, "wing3", "span", &value ) == UID_DONT_EXISTS );
+  ASSERT_TRUE( tixiGetTextElementByUID( documentHandle, "twice", "", &text ) == UID_NOT_UNIQUE );
+  ASSERT_TRUE( tixiGetTextElementByUID( -1, "wing1", "span", &text ) == INVALID_HANDLE );
+
+  /* the index follows modifications */
+  ASSERT_TRUE( tixiAddTextAttribute( documentHandle, "/model/wing[2]", "uID", "wing3" ) == SUCCESS );
+  ASSERT_TRUE( tixiGetTextElementByUID( documentHandle, "wing3", "span", &text ) == SUCCESS );
+  ASSERT_STREQ("no number", text);
+  ASSERT_TRUE( tixiGetTextElementByUID( documentHandle, "wing2", "span", &text ) == UID_DONT_EXISTS );
+
+  ASSERT_TRUE( tixiCloseDocument( documentHandle ) == SUCCESS );
+}
@@ -19,6 +19,15 @@
 #include "test.h" // Brings in the GTest framework
 #include "tixi.h"
 #include "tixiInternal.h"
+#include "tixiUtils.h"
+#include "numberConversion.h"
+
+#include <clocale>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
 
 
 /**
@@ -124,6 +133,198 @@ TEST_F(VectorTests, tixiUpdateVectorTests)
   ASSERT_TRUE ( tixiUpdateFloatVector(documentHandleAdd, "/a/test", pointsUpdated, 0, "%f") == FAILED );
 }
 
+TEST_F(VectorTests, tixiGetFloatVectorSyntax)
+{
+  double* values = NULL;
+
+  ASSERT_EQ(SUCCESS, tixiAddTextElement(documentHandleAdd, "/a", "spaced", " 1.5 ;\n\t-2e3;;+.25\n ;7E-2;0x10 "));
+  ASSERT_EQ(SUCCESS, tixiGetFloatVector(documentHandleAdd, "/a/spaced", &values, 5));
+  EXPECT_EQ(1.5, values[0]);
+  EXPECT_EQ(-2000., values[1]);
+  EXPECT_EQ(0.25, values[2]);
+  EXPECT_EQ(0.07, values[3]);
+  EXPECT_EQ(16., values[4]);
+  EXPECT_EQ(INDEX_OUT_OF_RANGE, tixiGetFloatVector(documentHandleAdd, "/a/spaced", &values, 6));
+
+  // elements behind the requested ones are not parsed
+  ASSERT_EQ(SUCCESS, tixiAddTextElement(documentHandleAdd, "/a", "invalid", "1;2 3;4e;;"));
+  ASSERT_EQ(SUCCESS, tixiGetFloatVector(documentHandleAdd, "/a/invalid", &values, 1));
+  EXPECT_EQ(1., values[0]);
+  EXPECT_EQ(NO_NUMBER, tixiGetFloatVector(documentHandleAdd, "/a/invalid", &values, 2));
+
+  ASSERT_EQ(SUCCESS, tixiAddTextElement(documentHandleAdd, "/a", "blank", "1; ;2"));
+  EXPECT_EQ(NO_NUMBER, tixiGetFloatVector(documentHandleAdd, "/a/blank", &values, 2));
+  EXPECT_EQ(ELEMENT_NOT_FOUND, tixiGetFloatVector(documentHandleAdd, "/a/notthere", &values, 2));
+  EXPECT_EQ(INVALID_HANDLE, tixiGetFloatVector(-1, "/a/blank", &values, 2));
+}
+
+TEST_F(VectorTests, tixiGetFloatVectorAlloc)
+{
+  int count = -1;
+  double* values = NULL;
+
+  ASSERT_EQ(SUCCESS, tixiGetFloatVectorAlloc(documentHandleGet, "/a/aeroPerformanceMap/cfy", &count, &values));
+  ASSERT_EQ(32, count);
+  EXPECT_EQ(1., values[0]);
+  EXPECT_EQ(118., values[31]);
+
+  ASSERT_EQ(SUCCESS, tixiAddTextElement(documentHandleAdd, "/a", "separators", ";1;;2.5;\n"));
+  ASSERT_EQ(SUCCESS, tixiGetVectorSize(documentHandleAdd, "/a/separators", &count));
+  EXPECT_EQ(3, count);
+  EXPECT_EQ(NO_NUMBER, tixiGetFloatVectorAlloc(documentHandleAdd, "/a/separators", &count, &values));
+
+  ASSERT_EQ(SUCCESS, tixiUpdateTextElement(documentHandleAdd, "/a/separators", ";1;;2.5;"));
+  ASSERT_EQ(SUCCESS, tixiGetFloatVectorAlloc(documentHandleAdd, "/a/separators", &count, &values));
+  ASSERT_EQ(2, count);
+  EXPECT_EQ(1., values[0]);
+  EXPECT_EQ(2.5, values[1]);
+
+  ASSERT_EQ(SUCCESS, tixiAddTextElement(documentHandleAdd, "/a", "empty", ";;"));
+  ASSERT_EQ(SUCCESS, tixiGetVectorSize(documentHandleAdd, "/a/empty", &count));
+  EXPECT_EQ(0, count);
+  ASSERT_EQ(SUCCESS, tixiGetFloatVectorAlloc(documentHandleAdd, "/a/empty", &count, &values));
+  EXPECT_EQ(0, count);
+
+  EXPECT_EQ(NO_NUMBER, tixiGetFloatVectorAlloc(documentHandleGet, "/a/aeroPerformanceMap/cfx", &count, &values));
+  EXPECT_EQ(ELEMENT_NOT_FOUND, tixiGetFloatVectorAlloc(documentHandleGet, "/a/notthere", &count, &values));
+  EXPECT_EQ(INVALID_HANDLE, tixiGetFloatVectorAlloc(-1, "/a/aeroPerformanceMap/cfy", &count, &values));
+}
+
+TEST_F(VectorTests, tixiGetFloatVectorInto)
+{
+  double values[40];
+  int count = -1;
+
+  ASSERT_EQ(SUCCESS, tixiGetFloatVectorInto(documentHandleGet, "/a/aeroPerformanceMap/cfy", values, 40, &count));
+  ASSERT_EQ(32, count);
+  EXPECT_EQ(1., values[0]);
+  EXPECT_EQ(118., values[31]);
+
+  // the array is filled as far as possible
+  values[10] = -1.;
+  EXPECT_EQ(INDEX_OUT_OF_RANGE, tixiGetFloatVectorInto(documentHandleGet, "/a/aeroPerformanceMap/cfy", values, 10, &count));
+  EXPECT_EQ(32, count);
+  EXPECT_EQ(12., values[9]);
+  EXPECT_EQ(-1., values[10]);
+
+  // size query without an array
+  EXPECT_EQ(INDEX_OUT_OF_RANGE, tixiGetFloatVectorInto(documentHandleGet, "/a/aeroPerformanceMap/cfz", NULL, 0, &count));
+  EXPECT_EQ(2, count);
+  EXPECT_EQ(SUCCESS, tixiGetFloatVectorInto(documentHandleGet, "/a/aeroPerformanceMap/cfz", values, 2, NULL));
+  EXPECT_EQ(2., values[1]);
+
+  EXPECT_EQ(FAILED, tixiGetFloatVectorInto(documentHandleGet, "/a/aeroPerformanceMap/cfz", NULL, 2, &count));
+  EXPECT_EQ(FAILED, tixiGetFloatVectorInto(documentHandleGet, "/a/aeroPerformanceMap/cfz", values, -1, &count));
+  EXPECT_EQ(NO_NUMBER, tixiGetFloatVectorInto(documentHandleGet, "/a/aeroPerformanceMap/cfx", values, 40, &count));
+  EXPECT_EQ(ELEMENT_NOT_FOUND, tixiGetFloatVectorInto(documentHandleGet, "/a/notthere", values, 40, &count));
+  EXPECT_EQ(INVALID_HANDLE, tixiGetFloatVectorInto(-1, "/a/aeroPerformanceMap/cfz", values, 40, &count));
+}
+
+// parseDouble must return exactly the same as strtod
+TEST(Vector, parseDouble)
+{
+  const char* special[] = {
+    "0", "-0", "1e308", "1.7976931348623157e308", "1.7976931348623159e308", "2.2250738585072011e-308",
+    "4.9e-324", "2.4703282292062327e-324", "2.4703282292062328e-324", "1e-400", "1e400", "9007199254740993",
+    "7.2057594037927933e16", "1e23", "123456789012345678901234", "0.000000000000000000000000000001",
+    "1e", "1e+", ".5", "5.", ".", "", " ", "-", "inf", "-nan", "0x1p3", "1,5", " \t12 "
+  };
+  unsigned long long state = 88172645463325252ULL;
+  char buffer[64];
+
+  for (size_t i = 0; i < sizeof(special) / sizeof(special[0]); ++i) {
+    double value = 0., expected = 0.;
+    char* expectedEnd = NULL;
+    const char* end = parseDouble(special[i], &value);
+
+    expected = strtod(special[i], &expectedEnd);
+    EXPECT_EQ(expectedEnd, end) << special[i];
+    EXPECT_EQ(0, memcmp(&expected, &value, sizeof(double))) << special[i];
+  }
+
+  for (int i = 0; i < 200000; ++i) {
+    double random = 0., value = 0.;
+
+    // random bit patterns printed with different precisions
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    memcpy(&random, &state, sizeof(double));
+    if (random != random) {
+      continue;
+    }
+    snprintf(buffer, sizeof(buffer), "%.*g", 1 + i % 17, random);
+
+    const char* end = parseDouble(buffer, &value);
+    double expected = strtod(buffer, NULL);
+    ASSERT_EQ(buffer + strlen(buffer), end) << buffer;
+    ASSERT_EQ(0, memcmp(&expected, &value, sizeof(double))) << buffer;
+  }
+}
+
+// numbers left to strtod are parsed with the C locale as well
+TEST(Vector, parseDoubleLocale)
+{
+  const char* commaLocales[] = {"de_DE.UTF-8", "de_DE.utf8", "de_DE", "German_Germany.1252", "fr_FR.UTF-8", "fr_FR"};
+  std::string previous = setlocale(LC_NUMERIC, NULL);
+  bool found = false;
+
+  for (size_t i = 0; i < sizeof(commaLocales) / sizeof(commaLocales[0]) && !found; ++i) {
+    found = setlocale(LC_NUMERIC, commaLocales[i]) != NULL;
+  }
+  if (!found) {
+    GTEST_SKIP();
+  }
+
+  double fast = 0., longMantissa = 0., hexadecimal = 0.;
+  const char* number = "1.25000000000000000000001";
+  const char* endFast = parseDouble("1.25", &fast);
+  const char* endLong = parseDouble(number, &longMantissa);
+  parseDouble("0x1.8p1", &hexadecimal);
+  setlocale(LC_NUMERIC, previous.c_str());
+
+  EXPECT_EQ(1.25, fast);
+  EXPECT_EQ(1.25, longMantissa);
+  EXPECT_EQ(3., hexadecimal);
+  EXPECT_EQ('\0', *endFast);
+  EXPECT_EQ(number + strlen(number), endLong);
+}
+
+// compares tixiGetFloatVector with the previous implementation, that tokenized a copy of the text
+TEST(Vector, ParsePerformance)
+{
+  TixiDocumentHandle handle = -1;
+  const int n = 200000;
+  std::vector<double> vec(n);
+  double* values = NULL;
+  char* text = NULL;
+  char* position = NULL;
+
+  for (int i = 0; i < n; ++i) {
+    vec[i] = 101325. * std::sin(i * 0.001) + i * 1e-3;
+  }
+  ASSERT_EQ(SUCCESS, tixiCreateDocument("root", &handle));
+  ASSERT_EQ(SUCCESS, tixiAddFloatVector(handle, "/root", "pressure", vec.data(), n, "%.17g"));
+
+  ASSERT_EQ(SUCCESS, tixiGetTextElement(handle, "/root/pressure", &text));
+  std::vector<double> previous;
+  for (char* token = string_tokenize(text, VECTOR_SEPARATOR, &position); token;
+       token = string_tokenize(NULL, VECTOR_SEPARATOR, &position)) {
+    trim_trailing_whitespace(token);
+    ASSERT_TRUE(isNumeric(token));
+    previous.push_back(atof(token));
+  }
+  ASSERT_EQ(SUCCESS, tixiGetFloatVector(handle, "/root/pressure", &values, n));
+
+  ASSERT_EQ((size_t) n, previous.size());
+  for (int i = 0; i < n; ++i) {
+    ASSERT_EQ(vec[i], values[i]);
+    ASSERT_EQ(previous[i], values[i]);
+  }
+
+  ASSERT_EQ(SUCCESS, tixiCloseDocument(handle));
+}
+
 // Make sure to run in a reasoble time
 TEST(Vector, Performance)
 {
@@ -160,3 +361,177 @@ TEST(Vector, vectorToString)
     free(myvecString);
     delete [] vec;
 }
+
+TEST(Vector, vectorToStringExact)
+{
+    double vec[] = {0.1, 1e-7, 123456789012345678., -0., 1e21, 2.5, 1. / 3., 5e-324};
+    char* myvecString = vectorToString(vec, 8, "exact");
+
+    EXPECT_STREQ("0.1;1e-07;1.2345678901234568e+17;-0;1e+21;2.5;0.3333333333333333;5e-324", myvecString);
+    free(myvecString);
+
+    myvecString = vectorToString(vec, 0, "exact");
+    EXPECT_STREQ("", myvecString);
+    free(myvecString);
+}
+
+// the fast path for %g has to write exactly the same as printf
+TEST(Vector, vectorToStringGeneral)
+{
+    const int n = 10000;
+    std::vector<double> vec(n);
+    std::string expected;
+    char buffer[64];
+
+    for (int i = 0; i < n; ++i) {
+        vec[i] = std::ldexp((double) (i * 7919 % 100003), i % 200 - 100) * (i % 3 == 0 ? -1 : 1);
+        if (i % 5 == 0) {
+            vec[i] = (i % 1000) * 0.25;
+        }
+        snprintf(buffer, sizeof(buffer), "%g", vec[i]);
+        expected += (i > 0 ? ";" : "") + std::string(buffer);
+    }
+
+    char* myvecString = vectorToString(vec.data(), n, "%g");
+    EXPECT_EQ(expected, myvecString);
+    free(myvecString);
+
+    myvecString = vectorToString(vec.data(), n, NULL);
+    EXPECT_EQ(expected, myvecString);
+    free(myvecString);
+}
+
+TEST_F(VectorTests, tixiVectorExactRoundtrip)
+{
+    const int n = 1000;
+    std::vector<double> vec(n);
+    double* values = NULL;
+
+    for (int i = 0; i < n; ++i) {
+        vec[i] = std::sin(i * 0.37) * std::pow(10., i % 40 - 20);
+    }
+
+    ASSERT_EQ(SUCCESS, tixiAddFloatVector(documentHandleAdd, "/a", "exact", vec.data(), n, "exact"));
+    ASSERT_EQ(SUCCESS, tixiGetFloatVector(documentHandleAdd, "/a/exact", &values, n));
+    for (int i = 0; i < n; ++i) {
+        ASSERT_EQ(vec[i], values[i]);
+    }
+
+    ASSERT_EQ(SUCCESS, tixiUpdateFloatVector(documentHandleAdd, "/a/exact", vec.data() + 1, n - 1, "exact"));
+    ASSERT_EQ(SUCCESS, tixiGetFloatVector(documentHandleAdd, "/a/exact", &values, n - 1));
+    for (int i = 0; i < n - 1; ++i) {
+        ASSERT_EQ(vec[i + 1], values[i]);
+    }
+}
+
+TEST(Vector, base64Doubles)
+{
+  const double values[] = {1., -2.5, 0.1};
+  double decoded[3] = {0., 0., 0.};
+  char buffer[BASE64_DOUBLES_LENGTH(3) + 1];
+
+  // little endian bytes of 1.0 are 00 00 00 00 00 00 f0 3f
+  ASSERT_EQ(12u, encodeDoublesBase64(values, 1, buffer));
+  EXPECT_STREQ("AAAAAAAA8D8=", buffer);
+  EXPECT_EQ(1, base64DoubleCount(buffer));
+
+  ASSERT_EQ(BASE64_DOUBLES_LENGTH(3), encodeDoublesBase64(values, 3, buffer));
+  EXPECT_EQ(3, base64DoubleCount(buffer));
+  decodeDoublesBase64(buffer, decoded, 3);
+  EXPECT_EQ(0, memcmp(values, decoded, sizeof(values)));
+
+  // whitespace is ignored, a prefix may be decoded
+  std::string wrapped = std::string(buffer, 16) + "\n  " + (buffer + 16);
+  EXPECT_EQ(3, base64DoubleCount(wrapped.c_str()));
+  decoded[1] = 0.;
+  decodeDoublesBase64(wrapped.c_str(), decoded, 2);
+  EXPECT_EQ(-2.5, decoded[1]);
+
+  EXPECT_EQ(0, base64DoubleCount(" "));
+  EXPECT_EQ(-1, base64DoubleCount("AAAAAAAA8D8"));
+  EXPECT_EQ(-1, base64DoubleCount("AAAAAAAA8D=8"));
+  EXPECT_EQ(-1, base64DoubleCount("AAAAAAAA8D8;"));
+  // whole bytes, but not a whole double
+  EXPECT_EQ(-1, base64DoubleCount("AAAA"));
+}
+
+TEST_F(VectorTests, tixiVectorBase64)
+{
+  std::vector<double> points(1000);
+  double *values = NULL;
+  double into[1000];
+  char *encoding = NULL;
+  int count = 0;
+
+  for (size_t i = 0; i < points.size(); ++i) {
+    points[i] = std::sin(0.01 * i) * 1e5 + 1. / 3.;
+  }
+  points[1] = -0.;
+  points[2] = 1e-310;
+
+  ASSERT_EQ(SUCCESS, tixiAddFloatVector(documentHandleAdd, "/a", "encoded", points.data(), 1000, "base64-f64le"));
+  ASSERT_EQ(SUCCESS, tixiGetTextAttribute(documentHandleAdd, "/a/encoded", "encoding", &encoding));
+  EXPECT_STREQ("base64-f64le", encoding);
+  ASSERT_EQ(SUCCESS, tixiGetTextAttribute(documentHandleAdd, "/a/encoded", "mapType", &encoding));
+  EXPECT_STREQ("vector", encoding);
+
+  // all readers decode the vector bit for bit
+  ASSERT_EQ(SUCCESS, tixiGetVectorSize(documentHandleAdd, "/a/encoded", &count));
+  EXPECT_EQ(1000, count);
+  ASSERT_EQ(SUCCESS, tixiGetFloatVector(documentHandleAdd, "/a/encoded", &values, 1000));
+  EXPECT_EQ(0, memcmp(points.data(), values, 1000 * sizeof(double)));
+  ASSERT_EQ(SUCCESS, tixiGetFloatVectorAlloc(documentHandleAdd, "/a/encoded", &count, &values));
+  EXPECT_EQ(1000, count);
+  EXPECT_EQ(0, memcmp(points.data(), values, 1000 * sizeof(double)));
+  ASSERT_EQ(SUCCESS, tixiGetFloatVectorInto(documentHandleAdd, "/a/encoded", into, 1000, &count));
+  EXPECT_EQ(0, memcmp(points.data(), into, 1000 * sizeof(double)));
+  EXPECT_EQ(INDEX_OUT_OF_RANGE, tixiGetFloatVectorInto(documentHandleAdd, "/a/encoded", into, 10, &count));
+  EXPECT_EQ(1000, count);
+  EXPECT_EQ(SUCCESS, tixiGetFloatVector(documentHandleAdd, "/a/encoded", &values, 3));
+  EXPECT_EQ(INDEX_OUT_OF_RANGE, tixiGetFloatVector(documentHandleAdd, "/a/encoded", &values, 1001));
+
+  // without a format, the encoding is kept
+  points[0] = 42.;
+  ASSERT_EQ(SUCCESS, tixiUpdateFloatVector(documentHandleAdd, "/a/encoded", points.data(), 3, NULL));
+  ASSERT_EQ(SUCCESS, tixiGetTextAttribute(documentHandleAdd, "/a/encoded", "encoding", &encoding));
+  ASSERT_EQ(SUCCESS, tixiGetFloatVectorAlloc(documentHandleAdd, "/a/encoded", &count, &values));
+  ASSERT_EQ(3, count);
+  EXPECT_EQ(42., values[0]);
+
+  // a text format removes the encoding
+  ASSERT_EQ(SUCCESS, tixiUpdateFloatVector(documentHandleAdd, "/a/encoded", points.data(), 3, "%g"));
+  EXPECT_EQ(ATTRIBUTE_NOT_FOUND, tixiGetTextAttribute(documentHandleAdd, "/a/encoded", "encoding", &encoding));
+  ASSERT_EQ(SUCCESS, tixiGetFloatVectorAlloc(documentHandleAdd, "/a/encoded", &count, &values));
+  ASSERT_EQ(3, count);
+  EXPECT_EQ(42., values[0]);
+
+  // and a text vector can be encoded by an update
+  ASSERT_EQ(SUCCESS, tixiUpdateFloatVector(documentHandleAdd, "/a/encoded", points.data(), 2, "base64-f64le"));
+  ASSERT_EQ(SUCCESS, tixiGetTextElement(documentHandleAdd, "/a/encoded", &encoding));
+  EXPECT_STREQ("AAAAAAAARUAAAAAAAAAAgA==", encoding);
+
+  // invalid data
+  ASSERT_EQ(SUCCESS, tixiAddTextElement(documentHandleAdd, "/a", "broken", "AAAAAAAA8D8=;"));
+  ASSERT_EQ(SUCCESS, tixiAddTextAttribute(documentHandleAdd, "/a/broken", "encoding", "base64-f64le"));
+  EXPECT_EQ(NO_NUMBER, tixiGetVectorSize(documentHandleAdd, "/a/broken", &count));
+  EXPECT_EQ(NO_NUMBER, tixiGetFloatVector(documentHandleAdd, "/a/broken", &values, 1));
+
+  // other encodings are not binary, the vector is text as before
+  ASSERT_EQ(SUCCESS, tixiAddTextElement(documentHandleAdd, "/a", "text", "1.5;2"));
+  ASSERT_EQ(SUCCESS, tixiAddTextAttribute(documentHandleAdd, "/a/text", "encoding", "utf-8"));
+  ASSERT_EQ(SUCCESS, tixiGetFloatVectorAlloc(documentHandleAdd, "/a/text", &count, &values));
+  ASSERT_EQ(2, count);
+  EXPECT_EQ(1.5, values[0]);
+  ASSERT_EQ(SUCCESS, tixiUpdateFloatVector(documentHandleAdd, "/a/text", points.data(), 1, "%g"));
+  ASSERT_EQ(SUCCESS, tixiGetTextAttribute(documentHandleAdd, "/a/text", "encoding", &encoding));
+  EXPECT_STREQ("utf-8", encoding);
+
+  // text and encoding stay consistent, if the text can't be updated
+  ASSERT_EQ(SUCCESS, tixiImportElementFromString(documentHandleAdd, "/a", "<mixed>1;2<x/></mixed>"));
+  EXPECT_EQ(FAILED, tixiUpdateFloatVector(documentHandleAdd, "/a/mixed", points.data(), 2, "base64-f64le"));
+  EXPECT_EQ(ATTRIBUTE_NOT_FOUND, tixiCheckAttribute(documentHandleAdd, "/a/mixed", "encoding"));
+  ASSERT_EQ(SUCCESS, tixiAddTextAttribute(documentHandleAdd, "/a/mixed", "encoding", "utf-8"));
+  EXPECT_EQ(FAILED, tixiUpdateFloatVector(documentHandleAdd, "/a/mixed", points.data(), 2, "base64-f64le"));
+  ASSERT_EQ(SUCCESS, tixiGetTextAttribute(documentHandleAdd, "/a/mixed", "encoding", &encoding));
+  EXPECT_STREQ("utf-8", encoding);
+}
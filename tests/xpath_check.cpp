@@ -22,6 +22,9 @@
 #include "tixiInternal.h"
 #include "xpathFunctions.h"
 
+#include <cstring>
+#include <string>
+
 
 static const char* xPathXmlFilename = "TestData/xpathsEvaluate.xml";
 
@@ -80,6 +83,179 @@ TEST_F(XPathChecks, XPathEvaluateExpression)
   ASSERT_TRUE(res != NULL);
 }
 
+TEST_F(XPathChecks, XPathEvaluateExpression_cache)
+{
+  TixiDocument* document = getDocument(documentHandle);
+
+  // alternating queries are served from the cache
+  xmlXPathObjectPtr first = XPathEvaluateExpression(document, "//a");
+  xmlXPathObjectPtr second = XPathEvaluateExpression(document, "//b");
+  ASSERT_TRUE(first != NULL);
+  ASSERT_TRUE(second != NULL);
+  EXPECT_EQ(first, XPathEvaluateExpression(document, "//a"));
+  EXPECT_EQ(second, XPathEvaluateExpression(document, "//b"));
+  EXPECT_EQ(2, document->xpathCache->size);
+
+  // the least recently used result is evicted
+  for (int i = 0; i < 100; ++i) {
+    std::string xpath = "/root/a[" + std::to_string(i + 1) + "]";
+    ASSERT_TRUE(XPathEvaluateExpression(document, xpath.c_str()) != NULL);
+    ASSERT_TRUE(XPathEvaluateExpression(document, "//a") == first);
+  }
+  EXPECT_EQ(64, document->xpathCache->size);
+  EXPECT_EQ(first, XPathCacheGet(document->xpathCache, (const xmlChar*) "//a"));
+  EXPECT_TRUE(XPathCacheGet(document->xpathCache, (const xmlChar*) "//b") == NULL);
+
+  // a disabled cache only owns the last result
+  ASSERT_EQ(SUCCESS, tixiSetCacheEnabled(documentHandle, 0));
+  ASSERT_TRUE(XPathEvaluateExpression(document, "//b") != NULL);
+  EXPECT_EQ(1, document->xpathCache->size);
+  EXPECT_TRUE(XPathCacheGet(document->xpathCache, (const xmlChar*) "//b") == NULL);
+}
+
+TEST_F(XPathChecks, XPathEvaluateExpression_cacheInvalidation)
+{
+  int num = 0;
+  char* text = NULL;
+
+  ASSERT_EQ(SUCCESS, tixiXPathEvaluateNodeNumber(documentHandle, "/root/a", &num));
+  ASSERT_EQ(2, num);
+  ASSERT_EQ(SUCCESS, tixiXPathExpressionGetTextByIndex(documentHandle, "/root/a/@uID", 1, &text));
+  ASSERT_STREQ("test", text);
+
+  ASSERT_EQ(SUCCESS, tixiCreateElement(documentHandle, "/root", "a"));
+  ASSERT_EQ(SUCCESS, tixiXPathEvaluateNodeNumber(documentHandle, "/root/a", &num));
+  ASSERT_EQ(3, num);
+
+  ASSERT_EQ(SUCCESS, tixiAddTextAttribute(documentHandle, "/root/a[1]", "uID", "changed"));
+  ASSERT_EQ(SUCCESS, tixiXPathExpressionGetTextByIndex(documentHandle, "/root/a/@uID", 1, &text));
+  ASSERT_STREQ("changed", text);
+
+  ASSERT_EQ(SUCCESS, tixiRenameElement(documentHandle, "/root", "a[3]", "c"));
+  ASSERT_EQ(SUCCESS, tixiXPathEvaluateNodeNumber(documentHandle, "/root/a", &num));
+  ASSERT_EQ(2, num);
+
+  ASSERT_EQ(SUCCESS, tixiRemoveElement(documentHandle, "/root/a[1]"));
+  ASSERT_EQ(SUCCESS, tixiXPathEvaluateNodeNumber(documentHandle, "/root/a", &num));
+  ASSERT_EQ(1, num);
+}
+
+TEST_F(XPathChecks, XPathEvaluateCompiled)
+{
+  TixiDocument* document = getDocument(documentHandle);
+  xmlNodePtr element = NULL;
+
+  ASSERT_EQ(SUCCESS, checkElement(document, elementPathExists, &element));
+  xmlXPathCompExprPtr compiled = XPathCacheGetCompiled(document->xpathCache, (const xmlChar*) elementPathExists, strlen(elementPathExists), document->xpathContext);
+  ASSERT_TRUE(compiled != NULL);
+
+  // compiled expressions are reused and survive modifications of the document
+  ASSERT_EQ(SUCCESS, tixiCreateElement(documentHandle, "/root", "c"));
+  ASSERT_EQ(SUCCESS, checkElement(document, elementPathExists, &element));
+  EXPECT_EQ(compiled, XPathCacheGetCompiled(document->xpathCache, (const xmlChar*) elementPathExists, strlen(elementPathExists), document->xpathContext));
+
+  // the expression does not need to be null terminated
+  std::string withSuffix = std::string(elementPathExists) + "/c";
+  EXPECT_EQ(compiled, XPathCacheGetCompiled(document->xpathCache, (const xmlChar*) withSuffix.c_str(), strlen(elementPathExists), document->xpathContext));
+
+  // prefixes are resolved on evaluation
+  ASSERT_EQ(INVALID_XPATH, checkElement(document, "/root/ns:c", &element));
+  ASSERT_EQ(SUCCESS, tixiRegisterNamespace(documentHandle, "http://www.example.com", "ns"));
+  ASSERT_EQ(ELEMENT_NOT_FOUND, checkElement(document, "/root/ns:c", &element));
+
+  EXPECT_TRUE(XPathEvaluateCompiled(document, "\\", 1) == NULL);
+}
+
+TEST(XPathSimplePathChecks, sameResultAsXPath)
+{
+  const char* xml =
+      "<root xmlns:x=\"http://www.example.com/x\">"
+      "<a><b>1</b><b>2</b><!-- c --><b-c.d>3</b-c.d></a>"
+      "<a><b>4</b><x:b>5</x:b><b xmlns=\"http://www.example.com/default\">6</b></a>"
+      "</root>";
+  const char* paths[] = {
+    "/root", "/root/a", "/root/a[1]", "/root/a[2]", "/root/a[3]", "/root/a/b", "/root/a[1]/b[2]",
+    "/root/a[2]/b", "/root/a[1]/b-c.d", "/root/a/x:b", "/root/a[2]/x:b[1]", "/root/b", "/other"
+  };
+  TixiDocumentHandle handle = -1;
+
+  ASSERT_EQ(SUCCESS, tixiImportFromString(xml, &handle));
+  ASSERT_EQ(SUCCESS, tixiRegisterNamespace(handle, "http://www.example.com/x", "x"));
+  TixiDocument* document = getDocument(handle);
+
+  for (size_t i = 0; i < sizeof(paths) / sizeof(paths[0]); ++i) {
+    xmlNodePtr element = NULL;
+    int count = XPathResolveSimplePath(document, paths[i], strlen(paths[i]), &element);
+    xmlXPathObjectPtr result = xmlXPathEvalExpression((const xmlChar*) paths[i], document->xpathContext);
+    ASSERT_TRUE(result != NULL);
+
+    int nodeNr = xmlXPathNodeSetGetLength(result->nodesetval);
+    EXPECT_EQ(nodeNr > 1 ? 2 : nodeNr, count) << paths[i];
+    if (nodeNr > 0) {
+      EXPECT_EQ(result->nodesetval->nodeTab[0], element) << paths[i];
+    }
+    xmlXPathFreeObject(result);
+  }
+
+  ASSERT_EQ(SUCCESS, tixiCloseDocument(handle));
+}
+
+TEST(XPathSimplePathChecks, fallbackToXPath)
+{
+  const char* paths[] = {
+    "root", "/", "//a", "/root/", "/root//a", "/root/*", "/root/a[0]", "/root/a[last()]", "/root/a[@uID='a']",
+    "/root/a[1][1]", "/root/a/text()", "/root/a/@uID", "/root/./a", "/root/../root", "/root/y:a", "/root/a [1]",
+    "/root/a[1234567890]", "/root/1a", "/root/\xc3\xa4"
+  };
+  TixiDocumentHandle handle = -1;
+
+  ASSERT_EQ(SUCCESS, tixiCreateDocument("root", &handle));
+  TixiDocument* document = getDocument(handle);
+
+  for (size_t i = 0; i < sizeof(paths) / sizeof(paths[0]); ++i) {
+    xmlNodePtr element = NULL;
+    EXPECT_EQ(-1, XPathResolveSimplePath(document, paths[i], strlen(paths[i]), &element)) << paths[i];
+  }
+
+  ASSERT_EQ(SUCCESS, tixiCloseDocument(handle));
+}
+
+TEST_F(XPathChecks, elementPathNormalization)
+{
+  TixiDocument* document = getDocument(documentHandle);
+  xmlNodePtr element = NULL;
+  xmlNodePtr expected = NULL;
+  xmlXPathObjectPtr result = NULL;
+
+  EXPECT_EQ(strlen("/root/a"), XPathElementPathLength("/root/a/"));
+  EXPECT_EQ(strlen("/root/a"), XPathElementPathLength("/root/a"));
+  EXPECT_EQ(1u, XPathElementPathLength("/"));
+
+  // trailing slashes are accepted by all lookups
+  ASSERT_EQ(SUCCESS, checkElement(document, "/root/a[1]/b[2]", &expected));
+  ASSERT_EQ(SUCCESS, checkElement(document, "/root/a[1]/b[2]/", &element));
+  EXPECT_EQ(expected, element);
+  ASSERT_EQ(SUCCESS, checkElement(document, "/root/a[@uID=\"test\"]/b[@uID=\"b\"]/", &element));
+  EXPECT_EQ(expected, element);
+  ASSERT_EQ(SUCCESS, getNodePtrFromElementPath(documentHandle, "/root/a[1]/b[2]/", &element));
+  EXPECT_EQ(expected, element);
+  ASSERT_EQ(SUCCESS, checkExistence(document, "/root/a[1]/b[@uID]/", &result));
+  EXPECT_EQ(2, result->nodesetval->nodeNr);
+  xmlXPathFreeObject(result);
+
+  // paths are not limited in length
+  std::string path = "/root/a[1]";
+  for (int i = 0; i < 250; ++i) {
+    ASSERT_EQ(SUCCESS, tixiCreateElement(documentHandle, path.c_str(), "deep"));
+    path += "/deep";
+  }
+  ASSERT_GT(path.size(), 1024u);
+  ASSERT_EQ(SUCCESS, checkElement(document, path.c_str(), &expected));
+  ASSERT_EQ(SUCCESS, checkElement(document, (path + "[not(@uID)]/").c_str(), &element));
+  EXPECT_EQ(expected, element);
+  ASSERT_EQ(ELEMENT_NOT_FOUND, checkElement(document, (path + "/deep").c_str(), &element));
+}
+
 TEST_F(XPathChecks, XPathEvaluateExpression_invalidContext)
 {
   xmlXPathObjectPtr res = XPathEvaluateExpression(NULL, elementPathExists);
@@ -96,17 +272,19 @@ TEST_F(XPathChecks, XPathEvaluateExpression_invalidXPath)
 TEST_F(XPathChecks, getText)
 {
   TixiDocument* document = getDocument(documentHandle);
-  char* text = XPathExpressionGetText(document, elementPathExists, 1);
+  char* allocated = NULL;
+  const char* text = XPathExpressionGetText(document, elementPathExists, 1, &allocated);
   ASSERT_STREQ("Blupp", text);
-  xmlFree(text);
+  xmlFree(allocated);
 }
 TEST_F(XPathChecks, getText_invalidIndex)
 {
   TixiDocument* document = getDocument(documentHandle);
-  char* text = XPathExpressionGetText(document, elementPathExists , 3);
+  char* allocated = NULL;
+  const char* text = XPathExpressionGetText(document, elementPathExists , 3, &allocated);
   ASSERT_EQ(NULL, text);
 
-  text = XPathExpressionGetText(document, elementPathExists, 0);
+  text = XPathExpressionGetText(document, elementPathExists, 0, &allocated);
   ASSERT_EQ(NULL, text);
 }
 
@@ -177,6 +355,38 @@ TEST_F(XPathChecks, generateXPathFromNodePtr)
   ASSERT_STREQ("/root/a[@uID=\"test\"]", xpath);
 }
 
+TEST_F(XPathChecks, generateXPathFromNodePtr_sharedAncestors)
+{
+  xmlNodePtr b2 = getParentNodeToXPath(documentHandle, "/root/a[1]/b[2]/@uID");
+  xmlNodePtr b1 = getParentNodeToXPath(documentHandle, "/root/a[1]/b[1]/@uID");
+  xmlNodePtr other = getParentNodeToXPath(documentHandle, "/root/a[2]/b[1]/text()");
+  xmlNodePtr a1 = getParentNodeToXPath(documentHandle, "/root/a[1]/@uID");
+  ASSERT_TRUE(b2 != NULL && b1 != NULL && other != NULL && a1 != NULL);
+
+  ASSERT_STREQ("/root/a[@uID=\"test\"]/b[@uID=\"b\"]", generateXPathFromNodePtr(documentHandle, b2));
+  ASSERT_STREQ("/root/a[@uID=\"test\"]/b[@uID=\"a\"]", generateXPathFromNodePtr(documentHandle, b1));
+  ASSERT_STREQ("/root/a[@uID=\"schlumpf\"]/b", generateXPathFromNodePtr(documentHandle, other));
+  ASSERT_STREQ("/root/a[@uID=\"test\"]", generateXPathFromNodePtr(documentHandle, a1));
+  ASSERT_STREQ("/root/a[@uID=\"test\"]/b[@uID=\"b\"]", generateXPathFromNodePtr(documentHandle, b2));
+
+  // modifications invalidate the memoized ancestors
+  ASSERT_EQ(SUCCESS, tixiAddTextAttribute(documentHandle, "/root/a[1]", "uID", "renamed"));
+  ASSERT_STREQ("/root/a[@uID=\"renamed\"]/b[@uID=\"b\"]", generateXPathFromNodePtr(documentHandle, b2));
+  ASSERT_EQ(SUCCESS, tixiRemoveAttribute(documentHandle, "/root/a[1]/b[2]", "uID"));
+  ASSERT_STREQ("/root/a[@uID=\"renamed\"]/b", generateXPathFromNodePtr(documentHandle, b2));
+}
+
+TEST_F(XPathChecks, generateXPathFromNodePtr_namespacedUID)
+{
+  // like in the uID index, only uID attributes without a namespace are used
+  ASSERT_EQ(SUCCESS, tixiImportElementFromString(documentHandle, "/root", "<c xmlns:x=\"urn:x\" x:uID=\"ns\"><d uID=\"d\"/></c>"));
+  xmlNodePtr d = getParentNodeToXPath(documentHandle, "/root/c/d/@uID");
+  ASSERT_TRUE(d != NULL);
+
+  ASSERT_STREQ("/root/c/d[@uID=\"d\"]", generateXPathFromNodePtr(documentHandle, d));
+  ASSERT_EQ(UID_DONT_EXISTS, tixiUIDCheckExists(documentHandle, "ns"));
+}
+
 TEST_F(XPathChecks, generateXPathFromNodePtr_invalidHandle)
 {
   char* xpath = generateXPathFromNodePtr(-1, NULL);
@@ -250,6 +460,27 @@ TEST_F(XPathChecks, tixiXPathExpressionGetTextByIndex_attributes)
   ASSERT_STREQ("y", text);
 }
 
+TEST_F(XPathChecks, tixiXPathExpressionGetTextByIndexInto)
+{
+  char buffer[16];
+  int needed = 0;
+
+  ASSERT_EQ(SUCCESS, tixiXPathExpressionGetTextByIndexInto(documentHandle, "/root/ugly_elem/@*", 2, buffer, sizeof(buffer), &needed));
+  ASSERT_STREQ("y", buffer);
+  ASSERT_EQ(2, needed);
+
+  ASSERT_EQ(SUCCESS, tixiXPathExpressionGetTextByIndexInto(documentHandle, elementPathExists, 1, buffer, sizeof(buffer), &needed));
+  ASSERT_STREQ("Blupp", buffer);
+  ASSERT_EQ(6, needed);
+
+  ASSERT_EQ(STRING_TRUNCATED, tixiXPathExpressionGetTextByIndexInto(documentHandle, elementPathExists, 1, buffer, 3, &needed));
+  ASSERT_STREQ("Bl", buffer);
+  ASSERT_EQ(6, needed);
+
+  ASSERT_EQ(FAILED, tixiXPathExpressionGetTextByIndexInto(documentHandle, elementPathExists, 3, buffer, sizeof(buffer), &needed));
+  ASSERT_EQ(INVALID_HANDLE, tixiXPathExpressionGetTextByIndexInto(-1, elementPathExists, 1, buffer, sizeof(buffer), &needed));
+}
+
 // get child nodes
 TEST_F(XPathChecks, tixiXPathGetXPath_ugly_elem)
 {